@@ -0,0 +1,112 @@
+#! /usr/bin/env python
+
+import os
+
+import custom_parser
+import project
+
+from downward import suites
+from downward.cached_revision import CachedFastDownwardRevision
+from downward.experiment import FastDownwardAlgorithm, FastDownwardRun
+from lab.experiment import Experiment
+
+REPO = project.get_repo_base()
+BENCHMARKS_DIR = os.environ["DOWNWARD_BENCHMARKS"]
+SCP_LOGIN = "nsc"
+REMOTE_REPOS_DIR = "/proj/dfsplan/users/x_jense/"
+SUITE = ["depot:p01.pddl", "grid:prob01.pddl", "gripper:prob01.pddl"]
+REVISION_CACHE = (
+    os.environ.get("DOWNWARD_REVISION_CACHE") or project.DIR / "data" / "revision-cache"
+)
+if project.REMOTE:
+    # ENV = project.BaselSlurmEnvironment(email="my.name@myhost.ch")
+    ENV = project.TetralithEnvironment(
+        memory_per_cpu="9G",  # leave some space for the scripts
+        email="jendrik.seipp@liu.se",
+        extra_options="#SBATCH --account=naiss2025-5-382",
+    )
+    SUITE = project.SUITE_SATISFICING
+else:
+    ENV = project.LocalEnvironment(processes=2)
+
+CONFIGS = [
+    ("lama-first", ["--search", "let(hlm, landmark_sum(lm_factory=lm_reasonable_orders_hps(lm_rhw()),transform=adapt_costs(one),pref=false), let(hff, ff(transform=adapt_costs(one)), lazy_greedy([hff,hlm],preferred=[hff,hlm],cost_type=one,reopen_closed=false)))"]),
+    ("lama-first-pref", ["--search", "let(hlm, landmark_sum(lm_factory=lm_reasonable_orders_hps(lm_rhw()),transform=adapt_costs(one),pref=true), let(hff, ff(transform=adapt_costs(one)), lazy_greedy([hff,hlm],preferred=[hff,hlm],cost_type=one,reopen_closed=false)))"]),
+    ("lm-sum-eager", ["--search", "let(hlm, landmark_sum(lm_reasonable_orders_hps(lm_rhw())), eager_greedy([hlm]))"]),
+    ("bjolp", ["--search", "let(hlm, landmark_cost_partitioning(lm_reasonable_orders_hps(lm_merged([lm_rhw(),lm_hm(m=1)]))), astar(hlm,lazy_evaluator=hlm))"]),
+]
+BUILD_OPTIONS = []
+DRIVER_OPTIONS = [
+    "--validate",
+    "--overall-time-limit",
+    "30m",
+    "--overall-memory-limit",
+    "8G",
+]
+# Pairs of revision identifier and optional revision nick.
+REV_NICKS = [
+    ("ab94129", "01-base"),
+    ("HEAD", "02-incremental-progression"),
+]
+ATTRIBUTES = [
+    "error",
+    "run_dir",
+    "search_start_time",
+    "search_start_memory",
+    "total_time",
+    "h_values",
+    "coverage",
+    "expansions",
+    "memory",
+    project.EVALUATIONS_PER_TIME,
+    "search_time",
+]
+
+exp = Experiment(environment=ENV)
+for rev, rev_nick in REV_NICKS:
+    cached_rev = CachedFastDownwardRevision(REVISION_CACHE, REPO, rev, BUILD_OPTIONS)
+    cached_rev.cache()
+    exp.add_resource("", cached_rev.path, cached_rev.get_relative_exp_path())
+    for config_nick, config in CONFIGS:
+        algo_name = f"{rev_nick}-{config_nick}" if rev_nick else config_nick
+
+        for task in suites.build_suite(BENCHMARKS_DIR, SUITE):
+            algo = FastDownwardAlgorithm(
+                algo_name,
+                cached_rev,
+                DRIVER_OPTIONS,
+                config,
+            )
+            run = FastDownwardRun(exp, algo, task)
+            exp.add_run(run)
+
+exp.add_parser(project.FastDownwardExperiment.EXITCODE_PARSER)
+exp.add_parser(project.FastDownwardExperiment.TRANSLATOR_PARSER)
+exp.add_parser(project.FastDownwardExperiment.SINGLE_SEARCH_PARSER)
+exp.add_parser(custom_parser.get_parser())
+exp.add_parser(project.FastDownwardExperiment.PLANNER_PARSER)
+
+exp.add_step("build", exp.build)
+exp.add_step("start", exp.start_runs)
+exp.add_step("parse", exp.parse)
+exp.add_fetcher(name="fetch")
+
+project.add_absolute_report(
+    exp,
+    attributes=ATTRIBUTES,
+    filter=[project.add_evaluations_per_time, project.group_domains],
+)
+project.add_comparative_report(
+    exp,
+    [
+        (f"01-base-{config_nick}", f"02-incremental-progression-{config_nick}")
+        for config_nick, _ in CONFIGS
+    ],
+    attributes=ATTRIBUTES,
+    filter=[project.add_evaluations_per_time, project.group_domains],
+)
+if not project.REMOTE:
+    project.add_scp_step(exp, SCP_LOGIN, REMOTE_REPOS_DIR)
+project.add_compress_exp_dir_step(exp)
+
+exp.run_steps()
@@ -0,0 +1,221 @@
+#! /usr/bin/env python3
+
+"""
+Read binary state space dumps written by
+
+    --search "dump_reachable_search_space(format=binary)"
+
+The reader streams the dump chunk by chunk, so it only needs memory for
+a single chunk. Without further options, it prints the dump in the text
+format of dump_reachable_search_space(format=text). See
+src/search/search_algorithms/exhaustive_search.cc for a description of
+the binary format.
+"""
+
+import argparse
+import struct
+import sys
+
+
+HEADER_MAGIC = b"FDSSDUMP"
+CHUNK_MAGIC = b"CHNK"
+INDEX_MAGIC = b"FDSSINDX"
+VERSION = 1
+COMPRESSED_FLAG = 1
+BIN_SIZE = 4
+
+
+class DumpFormatError(Exception):
+    pass
+
+
+class Variable:
+    def __init__(self, domain_size, bin_index, shift, read_mask):
+        self.domain_size = domain_size
+        self.bin_index = bin_index
+        self.shift = shift
+        self.read_mask = read_mask
+        self.fact_ids = []
+        self.fact_names = []
+
+    def get_value(self, bins):
+        return (bins[self.bin_index] & self.read_mask) >> self.shift
+
+
+class Buffer:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def read(self, num_bytes):
+        if self.pos + num_bytes > len(self.data):
+            raise DumpFormatError("unexpected end of data")
+        result = self.data[self.pos:self.pos + num_bytes]
+        self.pos += num_bytes
+        return result
+
+    def read_varint(self):
+        result = 0
+        shift = 0
+        while True:
+            byte = self.read(1)[0]
+            result |= (byte & 0x7f) << shift
+            if byte < 0x80:
+                return result
+            shift += 7
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def read_exactly(stream, num_bytes):
+    data = stream.read(num_bytes)
+    if len(data) != num_bytes:
+        raise DumpFormatError("unexpected end of file")
+    return data
+
+
+class StateSpaceDump:
+    """Streaming reader for a binary state space dump."""
+
+    def __init__(self, stream):
+        self.stream = stream
+        self._read_header()
+
+    def _read_header(self):
+        if read_exactly(self.stream, len(HEADER_MAGIC)) != HEADER_MAGIC:
+            raise DumpFormatError("not a binary state space dump")
+        version, flags, num_variables, self.bins_per_state = struct.unpack(
+            "<4I", read_exactly(self.stream, 16))
+        if version != VERSION:
+            raise DumpFormatError(f"unsupported version {version}")
+        self.compressed = bool(flags & COMPRESSED_FLAG)
+        self.bytes_per_state = self.bins_per_state * BIN_SIZE
+        self.variables = []
+        for _ in range(num_variables):
+            var = Variable(*struct.unpack(
+                "<4I", read_exactly(self.stream, 16)))
+            for _ in range(var.domain_size):
+                fact_id, = struct.unpack("<i", read_exactly(self.stream, 4))
+                name_length = self._read_stream_varint()
+                name = read_exactly(self.stream, name_length).decode("utf-8")
+                var.fact_ids.append(fact_id)
+                var.fact_names.append(name)
+            self.variables.append(var)
+
+    def _read_stream_varint(self):
+        result = 0
+        shift = 0
+        while True:
+            byte = read_exactly(self.stream, 1)[0]
+            result |= (byte & 0x7f) << shift
+            if byte < 0x80:
+                return result
+            shift += 7
+
+    def facts(self):
+        """Return sorted (fact ID, name) pairs for all STRIPS facts."""
+        facts = []
+        for var in self.variables:
+            for fact_id, name in zip(var.fact_ids, var.fact_names):
+                if fact_id != -1:
+                    facts.append((fact_id, name))
+        return sorted(facts)
+
+    def _decode_state(self, buffer, previous_state):
+        if not self.compressed:
+            return buffer.read(self.bytes_per_state)
+        state = bytearray(previous_state)
+        pos = 0
+        while pos < self.bytes_per_state:
+            pos += buffer.read_varint()
+            num_literals = buffer.read_varint()
+            for byte in buffer.read(num_literals):
+                state[pos] ^= byte
+                pos += 1
+        return bytes(state)
+
+    def states(self):
+        """
+        Yield (state ID, is goal, values, successor IDs) for all states in
+        the order of their IDs.
+        """
+        while True:
+            # The chunk index after the last chunk has no magic.
+            if self.stream.read(len(CHUNK_MAGIC)) != CHUNK_MAGIC:
+                return
+            first_state_id, num_states, payload_size = struct.unpack(
+                "<2IQ", read_exactly(self.stream, 16))
+            buffer = Buffer(read_exactly(self.stream, payload_size))
+            previous_state = bytes(self.bytes_per_state)
+            for state_id in range(first_state_id,
+                                  first_state_id + num_states):
+                is_goal = bool(buffer.read(1)[0])
+                packed = self._decode_state(buffer, previous_state)
+                previous_state = packed
+                bins = struct.unpack(f"<{self.bins_per_state}I", packed)
+                values = [var.get_value(bins) for var in self.variables]
+                successors = []
+                target = state_id
+                for _ in range(buffer.read_varint()):
+                    target += unzigzag(buffer.read_varint())
+                    successors.append(target)
+                yield state_id, is_goal, values, successors
+
+
+def read_chunk_index(stream):
+    """Return a list of (first state ID, file offset) pairs for all chunks."""
+    stream.seek(-16, 2)
+    index_offset, magic = struct.unpack("<Q8s", read_exactly(stream, 16))
+    if magic != INDEX_MAGIC:
+        raise DumpFormatError("missing chunk index")
+    stream.seek(index_offset)
+    num_chunks, = struct.unpack("<I", read_exactly(stream, 4))
+    return [struct.unpack("<IQ", read_exactly(stream, 12))
+            for _ in range(num_chunks)]
+
+
+def dump_text(dump, out):
+    out.write("# F (fact): [fact ID] [name]\n")
+    out.write("# G (goal state): [goal state ID] [fact ID 1] [fact ID 2] ...\n")
+    out.write("# N (non-goal state): [non-goal state ID] [fact ID 1] "
+              "[fact ID 2] ...\n")
+    out.write("# T (transition): [source state ID] [target state ID]\n")
+    out.write("# The initial state has ID 0.\n")
+    for fact_id, name in dump.facts():
+        out.write(f"F {fact_id} {name}\n")
+    for state_id, is_goal, values, successors in dump.states():
+        fact_ids = [var.fact_ids[value]
+                    for var, value in zip(dump.variables, values)]
+        fact_ids = " ".join(str(f) for f in fact_ids if f != -1)
+        out.write(f"{'G' if is_goal else 'N'} {state_id} {fact_ids}\n")
+        for succ_id in successors:
+            out.write(f"T {state_id} {succ_id}\n")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("dump_file", help="binary state space dump")
+    parser.add_argument(
+        "--index", action="store_true",
+        help="only print the chunk index")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    with open(args.dump_file, "rb") as stream:
+        try:
+            if args.index:
+                for first_state_id, offset in read_chunk_index(stream):
+                    print(f"chunk starting at state {first_state_id}: "
+                          f"offset {offset}")
+            else:
+                dump_text(StateSpaceDump(stream), sys.stdout)
+        except DumpFormatError as err:
+            sys.exit(f"Error reading {args.dump_file}: {err}")
+
+
+if __name__ == "__main__":
+    main()
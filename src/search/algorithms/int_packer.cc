@@ -55,6 +55,18 @@ public:
     ~VariableInfo() {
     }
 
+    int get_bin_index() const {
+        return bin_index;
+    }
+
+    int get_shift() const {
+        return shift;
+    }
+
+    Bin get_read_mask() const {
+        return read_mask;
+    }
+
     int get(const Bin *buffer) const {
         return (buffer[bin_index] & read_mask) >> shift;
     }
@@ -77,6 +89,18 @@ int IntPacker::get(const Bin *buffer, int var) const {
     return var_infos[var].get(buffer);
 }
 
+int IntPacker::get_bin_index(int var) const {
+    return var_infos[var].get_bin_index();
+}
+
+int IntPacker::get_shift(int var) const {
+    return var_infos[var].get_shift();
+}
+
+IntPacker::Bin IntPacker::get_read_mask(int var) const {
+    return var_infos[var].get_read_mask();
+}
+
 void IntPacker::set(Bin *buffer, int var, int value) const {
     var_infos[var].set(buffer, value);
 }
@@ -43,6 +43,16 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      Expose the position of a variable in the packed buffer for code that
+      wants to read or write values without going through get() and set().
+      The value of var is (buffer[get_bin_index(var)] & get_read_mask(var))
+      >> get_shift(var).
+    */
+    int get_bin_index(int var) const;
+    int get_shift(int var) const;
+    Bin get_read_mask(int var) const;
+
     int get_num_bins() const {
         return num_bins;
     }
@@ -2,6 +2,7 @@
 #define ALGORITHMS_SUBSCRIBER_H
 
 #include <cassert>
+#include <mutex>
 #include <unordered_set>
 
 /*
@@ -38,6 +39,23 @@ namespace subscriber {
 template<typename T>
 class SubscriberService;
 
+/*
+  Services of type T and their subscribers may be created and destroyed in
+  different threads (e.g., tasks that a background thread creates while
+  the search runs). Therefore, all subscriptions involving services of type
+  T are protected by a single recursive mutex. Subscribers that store data
+  per service (e.g., PerTaskInformation) should protect it with the same
+  mutex, since they are notified while the mutex is held.
+
+  We never destroy the mutex, because subscribers with static storage
+  duration may unsubscribe during program termination.
+*/
+template<typename T>
+std::recursive_mutex &get_subscription_mutex() {
+    static std::recursive_mutex *mutex = new std::recursive_mutex();
+    return *mutex;
+}
+
 /*
   A Subscriber can subscribe to a SubscriberService and is notified if that
   service is destroyed. The template parameter T should be the class of the
@@ -50,6 +68,7 @@ class Subscriber {
     virtual void notify_service_destroyed(const T *) = 0;
 public:
     virtual ~Subscriber() {
+        std::lock_guard<std::recursive_mutex> lock(get_subscription_mutex<T>());
         /*
           We have to copy the services because unsubscribing erases the
           current service during the iteration.
@@ -76,6 +95,7 @@ class SubscriberService {
     mutable std::unordered_set<Subscriber<T> *> subscribers;
 public:
     virtual ~SubscriberService() {
+        std::lock_guard<std::recursive_mutex> lock(get_subscription_mutex<T>());
         /*
           We have to copy the subscribers because unsubscribing erases the
           current subscriber during the iteration.
@@ -88,6 +108,7 @@ public:
     }
 
     void subscribe(Subscriber<T> *subscriber) const {
+        std::lock_guard<std::recursive_mutex> lock(get_subscription_mutex<T>());
         assert(subscribers.find(subscriber) == subscribers.end());
         subscribers.insert(subscriber);
         assert(subscriber->services.find(this) == subscriber->services.end());
@@ -95,6 +116,7 @@ public:
     }
 
     void unsubscribe(Subscriber<T> *subscriber) const {
+        std::lock_guard<std::recursive_mutex> lock(get_subscription_mutex<T>());
         assert(subscribers.find(subscriber) != subscribers.end());
         subscribers.erase(subscriber);
         assert(subscriber->services.find(this) != subscriber->services.end());
@@ -1,6 +1,7 @@
 #include "axioms.h"
 
 #include "task_utils/task_properties.h"
+#include "utils/collections.h"
 
 #include <algorithm>
 #include <cassert>
@@ -49,6 +50,28 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
             }
         }
 
+        // Initialize data for incremental evaluation
+        int num_variables = variables.size();
+        dependent_derived_vars.resize(num_variables);
+        rules_by_effect_var.resize(num_variables);
+        conditions_by_rule.resize(axioms.size());
+        for (OperatorProxy axiom : axioms) {
+            int id = axiom.get_id();
+            EffectProxy effect = axiom.get_effects()[0];
+            int effect_var = effect.get_fact().get_variable().get_id();
+            rules_by_effect_var[effect_var].push_back(id);
+            for (FactProxy condition : effect.get_conditions()) {
+                FactPair fact = condition.get_pair();
+                conditions_by_rule[id].push_back(fact);
+                dependent_derived_vars[fact.var].push_back(effect_var);
+            }
+        }
+        for (vector<int> &dependent_vars : dependent_derived_vars) {
+            utils::sort_unique(dependent_vars);
+            dependent_vars.shrink_to_fit();
+        }
+        is_affected.resize(num_variables, false);
+
         // Initialize negation-by-failure information
         int last_layer = -1;
         for (VariableProxy var : variables) {
@@ -120,6 +143,17 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
         }
     }
 
+    apply_rules_by_layer<false>(state);
+}
+
+/*
+  Apply the Horn rules and negation by failure rules layer by layer,
+  starting from the literals in the queue. If only_affected is true, we
+  ignore all rules and negation by failure information for derived
+  variables that are not affected.
+*/
+template<bool only_affected>
+void AxiomEvaluator::apply_rules_by_layer(vector<int> &state) {
     for (size_t layer_no = 0; layer_no < nbf_info_by_layer.size(); ++layer_no) {
         // Apply Horn rules.
         while (!queue.empty()) {
@@ -127,6 +161,9 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
             queue.pop_back();
             for (size_t i = 0; i < curr_literal->condition_of.size(); ++i) {
                 AxiomRule *rule = curr_literal->condition_of[i];
+                if (only_affected && !is_affected[rule->effect_var]) {
+                    continue;
+                }
                 if (--rule->unsatisfied_conditions == 0) {
                     int var_no = rule->effect_var;
                     int val = rule->effect_val;
@@ -149,6 +186,9 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
                 int var_no = nbf_info[i].var_no;
                 // Verify that variable is derived.
                 assert(default_values[var_no] != -1);
+                if (only_affected && !is_affected[var_no]) {
+                    continue;
+                }
                 if (state[var_no] == default_values[var_no])
                     queue.push_back(nbf_info[i].literal);
             }
@@ -156,4 +196,74 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
     }
 }
 
+void AxiomEvaluator::collect_affected_vars(const vector<int> &changed_vars) {
+    assert(affected_vars.empty());
+    auto mark_dependent_vars = [this](int var) {
+        for (int derived_var : dependent_derived_vars[var]) {
+            if (!is_affected[derived_var]) {
+                is_affected[derived_var] = true;
+                affected_vars.push_back(derived_var);
+            }
+        }
+    };
+    for (int var : changed_vars) {
+        assert(default_values[var] == -1);
+        mark_dependent_vars(var);
+    }
+    // affected_vars grows while we iterate over it.
+    for (size_t i = 0; i < affected_vars.size(); ++i) {
+        mark_dependent_vars(affected_vars[i]);
+    }
+}
+
+void AxiomEvaluator::evaluate(
+    vector<int> &state, const vector<int> &changed_vars) {
+    if (!task_has_axioms)
+        return;
+
+#ifndef NDEBUG
+    vector<int> expected_state = state;
+    evaluate(expected_state);
+#endif
+
+    collect_affected_vars(changed_vars);
+    if (!affected_vars.empty()) {
+        assert(queue.empty());
+        for (int var : affected_vars) {
+            state[var] = default_values[var];
+        }
+        /*
+          Conditions on unaffected variables have their final values, so
+          we only have to wait for conditions on affected variables.
+        */
+        for (int var : affected_vars) {
+            for (int rule_id : rules_by_effect_var[var]) {
+                AxiomRule &rule = rules[rule_id];
+                int unsatisfied_conditions = 0;
+                for (const FactPair &condition : conditions_by_rule[rule_id]) {
+                    if (is_affected[condition.var] ||
+                        state[condition.var] != condition.value) {
+                        ++unsatisfied_conditions;
+                    }
+                }
+                rule.unsatisfied_conditions = unsatisfied_conditions;
+                if (unsatisfied_conditions == 0 &&
+                    state[var] != rule.effect_val) {
+                    state[var] = rule.effect_val;
+                    queue.push_back(rule.effect_literal);
+                }
+            }
+        }
+
+        apply_rules_by_layer<true>(state);
+
+        for (int var : affected_vars) {
+            is_affected[var] = false;
+        }
+        affected_vars.clear();
+    }
+
+    assert(state == expected_state);
+}
+
 PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
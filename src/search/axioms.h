@@ -59,12 +59,37 @@ class AxiomEvaluator {
     */
     std::vector<const AxiomLiteral *> queue;
 
+    /*
+      Data for incremental evaluation. dependent_derived_vars[var] holds
+      the derived variables with a rule that has a condition on var.
+      Derived variables that transitively depend on a changed variable
+      are "affected". Only their values have to be recomputed.
+    */
+    std::vector<std::vector<int>> dependent_derived_vars;
+    std::vector<std::vector<int>> rules_by_effect_var;
+    std::vector<std::vector<FactPair>> conditions_by_rule;
+    std::vector<bool> is_affected;
+    std::vector<int> affected_vars;
+
     template<typename Values, typename Accessor>
     void evaluate_aux(Values &values, const Accessor &accessor);
+    template<bool only_affected>
+    void apply_rules_by_layer(std::vector<int> &state);
+    void collect_affected_vars(const std::vector<int> &changed_vars);
 public:
     explicit AxiomEvaluator(const TaskProxy &task_proxy);
 
     void evaluate(std::vector<int> &state);
+
+    /*
+      Like evaluate(), but expects that the derived variables in state hold
+      the correct values for the state before changing the values of the
+      (non-derived) variables in changed_vars. Only rules deriving values
+      for variables that depend on the changed variables are re-evaluated.
+      In debug builds, we compare the result to that of evaluate().
+    */
+    void evaluate(
+        std::vector<int> &state, const std::vector<int> &changed_vars);
 };
 
 extern PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
@@ -6,15 +6,76 @@
 #include "utils.h"
 
 #include "../plugins/plugin.h"
+#include "../task_utils/task_properties.h"
+#include "../tasks/modified_initial_state_task.h"
+#include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 
 using namespace std;
 
 namespace cartesian_abstractions {
+/*
+  The planner terminates with exit() while the heuristics are still alive.
+  We stop the background threads before static objects are destroyed. If a
+  background thread calls exit() itself (e.g., after running out of memory),
+  it can't join itself, so it only signals the stop and detaches.
+*/
+static mutex background_heuristics_mutex;
+static vector<AdditiveCartesianHeuristic *> background_heuristics;
+
+static void stop_all_background_refinements() {
+    vector<AdditiveCartesianHeuristic *> heuristics;
+    {
+        lock_guard<mutex> lock(background_heuristics_mutex);
+        heuristics = background_heuristics;
+    }
+    for (AdditiveCartesianHeuristic *heuristic : heuristics) {
+        heuristic->stop_background_refinement();
+    }
+}
+
+static void register_background_heuristic(
+    AdditiveCartesianHeuristic *heuristic) {
+    lock_guard<mutex> lock(background_heuristics_mutex);
+    static bool registered_exit_handler = false;
+    if (!registered_exit_handler) {
+        atexit(stop_all_background_refinements);
+        registered_exit_handler = true;
+    }
+    background_heuristics.push_back(heuristic);
+}
+
+static void unregister_background_heuristic(
+    AdditiveCartesianHeuristic *heuristic) {
+    lock_guard<mutex> lock(background_heuristics_mutex);
+    erase(background_heuristics, heuristic);
+}
+
+static int compute_sum(
+    const vector<CartesianHeuristicFunction> &functions, const State &state) {
+    int sum_h = 0;
+    for (const CartesianHeuristicFunction &function : functions) {
+        int value = function.get_value(state);
+        assert(value >= 0);
+        if (value == INF)
+            return INF;
+        sum_h += value;
+    }
+    assert(sum_h >= 0);
+    return sum_h;
+}
+
 AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     const vector<shared_ptr<SubtaskGenerator>> &subtasks, int max_states,
     int max_transitions, double max_time,
@@ -23,31 +84,224 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     int max_state_expansions,
     TransitionRepresentation transition_representation, int memory_padding,
     int random_seed, DotGraphVerbosity dot_graph_verbosity,
-    bool use_general_costs, const shared_ptr<AbstractTask> &transform,
-    bool cache_estimates, const string &description, utils::Verbosity verbosity)
-    : Heuristic(transform, cache_estimates, description, verbosity) {
+    bool use_general_costs, double background_time, int background_memory,
+    const shared_ptr<AbstractTask> &transform, bool cache_estimates,
+    const string &description, utils::Verbosity verbosity)
+    : Heuristic(transform, cache_estimates, description, verbosity),
+      background_time(background_time),
+      background_memory_mb(background_memory),
+      max_time(max_time),
+      background_refinement_started(false),
+      initial_h(0),
+      stop_refinement(false),
+      has_new_heuristic_functions(false),
+      guiding_state_h(INF),
+      num_adopted_collections(0) {
+    shared_ptr<utils::RandomNumberGenerator> rng =
+        utils::get_rng(random_seed);
+    MemoryLimit memory_limit;
     CostSaturation cost_saturation(
         subtasks, max_states, max_transitions, max_time, use_general_costs,
         pick_flawed_abstract_state, pick_split, tiebreak_split,
         max_concrete_states_per_abstract_state, max_state_expansions,
-        transition_representation, memory_padding, *utils::get_rng(random_seed),
-        log, dot_graph_verbosity);
+        transition_representation, memory_padding, *rng, log,
+        dot_graph_verbosity, memory_limit);
     heuristic_functions =
         cost_saturation.generate_heuristic_functions(transform);
+
+    if (background_time > 0) {
+        // The background thread must not share the RNG with other components.
+        background_rng = make_unique<utils::RandomNumberGenerator>(
+            rng->random(numeric_limits<int>::max()));
+        build_refined_heuristic_functions =
+            [=, this](
+                const shared_ptr<AbstractTask> &task, double time_limit,
+                bool &hit_time_limit) {
+                // Only this class reports on background refinement, since
+                // the search is already running and logging concurrently.
+                utils::LogProxy background_log = utils::get_silent_log();
+                CostSaturation refined_cost_saturation(
+                    subtasks, max_states, max_transitions, time_limit,
+                    use_general_costs, pick_flawed_abstract_state, pick_split,
+                    tiebreak_split, max_concrete_states_per_abstract_state,
+                    max_state_expansions, transition_representation,
+                    memory_padding, *background_rng, background_log,
+                    DotGraphVerbosity::SILENT, *background_memory_limit,
+                    background_rng.get(), utils::Clock::THREAD_CPU);
+                vector<CartesianHeuristicFunction> functions =
+                    refined_cost_saturation.generate_heuristic_functions(task);
+                hit_time_limit = refined_cost_saturation.hit_time_limit();
+                return functions;
+            };
+        initial_h = compute_sum(
+            heuristic_functions, task_proxy.get_initial_state());
+    }
+}
+
+AdditiveCartesianHeuristic::~AdditiveCartesianHeuristic() {
+    stop_background_refinement();
+    if (num_adopted_collections > 0) {
+        log << "Adopted refined Cartesian abstraction collections: "
+            << num_adopted_collections << endl;
+    }
+}
+
+void AdditiveCartesianHeuristic::start_background_refinement() {
+    assert(!background_refinement_started);
+    background_refinement_started = true;
+    if (initial_h == INF) {
+        log << "Initial state is a dead end --> no background refinement."
+            << endl;
+        return;
+    }
+    int64_t max_peak_memory_kb =
+        max(0, utils::get_peak_memory_in_kb()) +
+        static_cast<int64_t>(background_memory_mb) * 1024;
+    background_memory_limit = make_unique<MemoryLimit>(static_cast<int>(
+        min<int64_t>(max_peak_memory_kb, numeric_limits<int>::max())));
+    log << "Refine Cartesian abstractions in the background for "
+        << background_time << "s." << endl;
+    background_timer =
+        make_unique<utils::CountdownTimer>(background_time, utils::Clock::WALL);
+    register_background_heuristic(this);
+    background_thread =
+        thread(&AdditiveCartesianHeuristic::run_background_refinement, this);
+}
+
+void AdditiveCartesianHeuristic::stop_background_refinement() {
+    if (!background_thread.joinable()) {
+        return;
+    }
+    stop_refinement = true;
+    // CEGAR stops refining as soon as the memory limit is reached.
+    background_memory_limit->set_reached();
+    if (this_thread::get_id() == background_thread.get_id()) {
+        background_thread.detach();
+    } else {
+        background_thread.join();
+    }
+    unregister_background_heuristic(this);
+}
+
+void AdditiveCartesianHeuristic::run_background_refinement() {
+    auto release_replaced_heuristic_functions = [this]() {
+        vector<CartesianHeuristicFunction> replaced;
+        {
+            lock_guard<mutex> lock(heuristic_functions_mutex);
+            swap(replaced, replaced_heuristic_functions);
+        }
+    };
+
+    for (int round_id = 1; !stop_refinement; ++round_id) {
+        release_replaced_heuristic_functions();
+        double remaining_time = background_timer->get_remaining_time();
+        if (background_timer->is_expired()) {
+            log << "Background refinement reached its time limit." << endl;
+            break;
+        }
+        if (background_memory_limit->is_reached()) {
+            log << "Background refinement reached its memory limit." << endl;
+            break;
+        }
+
+        vector<int> state_values;
+        int old_h;
+        {
+            lock_guard<mutex> lock(guiding_state_mutex);
+            swap(state_values, guiding_state_values);
+            old_h = guiding_state_h;
+            guiding_state_h = INF;
+        }
+        if (state_values.empty()) {
+            state_values = task_proxy.get_initial_state().get_unpacked_values();
+            old_h = initial_h;
+        }
+        shared_ptr<AbstractTask> guided_task =
+            make_shared<extra_tasks::ModifiedInitialStateTask>(
+                task, move(state_values));
+
+        double round_time = min(remaining_time, max_time * pow(2.0, round_id));
+        bool hit_time_limit;
+        vector<CartesianHeuristicFunction> functions =
+            build_refined_heuristic_functions(
+                guided_task, round_time, hit_time_limit);
+        if (stop_refinement) {
+            break;
+        }
+
+        int new_h =
+            compute_sum(functions, TaskProxy(*guided_task).get_initial_state());
+        log << "Background refinement round " << round_id << ": "
+            << functions.size() << " abstractions, h=" << new_h
+            << " (before: " << old_h << ")" << endl;
+        if (new_h > old_h) {
+            {
+                lock_guard<mutex> lock(heuristic_functions_mutex);
+                swap(functions, new_heuristic_functions);
+                has_new_heuristic_functions = true;
+            }
+            // Destroy the unadopted collection outside of the lock.
+            functions.clear();
+        }
+
+        if (!hit_time_limit) {
+            log << "Background refinement finished without reaching its "
+                   "time limit --> stop refining."
+                << endl;
+            break;
+        }
+    }
+    release_replaced_heuristic_functions();
+}
+
+void AdditiveCartesianHeuristic::select_guiding_state(
+    const State &state, int h) {
+    if (h < guiding_state_h) {
+        lock_guard<mutex> lock(guiding_state_mutex);
+        if (h < guiding_state_h) {
+            state.unpack();
+            guiding_state_values = state.get_unpacked_values();
+            guiding_state_h = h;
+        }
+    }
+}
+
+bool AdditiveCartesianHeuristic::adopt_new_heuristic_functions() {
+    if (!has_new_heuristic_functions) {
+        return false;
+    }
+    // Don't wait for the background thread.
+    unique_lock<mutex> lock(heuristic_functions_mutex, try_to_lock);
+    // Let the background thread destroy the previously replaced functions.
+    if (!lock.owns_lock() || !replaced_heuristic_functions.empty()) {
+        return false;
+    }
+    replaced_heuristic_functions = move(heuristic_functions);
+    heuristic_functions = move(new_heuristic_functions);
+    new_heuristic_functions.clear();
+    has_new_heuristic_functions = false;
+    ++num_adopted_collections;
+    return true;
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int sum_h = 0;
-    for (const CartesianHeuristicFunction &function : heuristic_functions) {
-        int value = function.get_value(state);
-        assert(value >= 0);
-        if (value == INF)
-            return DEAD_END;
-        sum_h += value;
+    if (background_time > 0 && !background_refinement_started) {
+        start_background_refinement();
     }
-    assert(sum_h >= 0);
-    return sum_h;
+    if (background_thread.joinable()) {
+        adopt_new_heuristic_functions();
+    }
+    int h = compute_sum(heuristic_functions, state);
+    if (h == INF) {
+        return DEAD_END;
+    }
+    // Refining the abstractions for goal states is pointless.
+    if (background_thread.joinable() &&
+        (h > 0 || !task_properties::is_goal_state(task_proxy, state))) {
+        select_guiding_state(state, h);
+    }
+    return h;
 }
 
 class AdditiveCartesianHeuristicFeature
@@ -103,14 +357,45 @@ public:
         add_option<bool>(
             "use_general_costs", "allow negative costs in cost partitioning",
             "true");
+        add_option<double>(
+            "background_time",
+            "time in seconds for refining the abstractions in a background "
+            "thread during the search (0 disables background refinement)",
+            "0", plugins::Bounds("0.0", "infinity"));
+        add_option<int>(
+            "background_memory",
+            "maximum increase of the planner's peak memory in MiB while "
+            "refining the abstractions in the background",
+            "1000", plugins::Bounds("0", "infinity"));
         add_heuristic_options_to_feature(*this, "cegar");
+        document_note(
+            "Anytime mode",
+            "With background_time > 0, the search starts with the abstractions "
+            "built within max_time, so max_time should be small. When the "
+            "search evaluates the first state, a background thread starts to "
+            "repeatedly build new abstraction collections, each round with "
+            "twice the time of the previous round, for the state with the "
+            "lowest heuristic value evaluated since the previous round. A new "
+            "collection replaces the current one if it increases the "
+            "heuristic value of this state. max_states and max_transitions "
+            "limit each collection. The background refinement stops when the "
+            "peak memory of the planner has grown by more than "
+            "background_memory since the start of the background refinement, "
+            "when its time is up, or when a round finishes before its time "
+            "limit. It doesn't use the memory padding. background_time is "
+            "measured in wall-clock time and the time of each round in CPU "
+            "time of the background thread. The CPU time of the background "
+            "thread counts towards the CPU time limit of the planner. The "
+            "heuristic stays admissible, but it may become inconsistent "
+            "because it changes during the search.");
 
         document_language_support("action costs", "supported");
         document_language_support("conditional effects", "not supported");
         document_language_support("axioms", "not supported");
 
         document_property("admissible", "yes");
-        document_property("consistent", "yes");
+        document_property(
+            "consistent", "yes without background refinement (see note)");
         document_property("safe", "yes");
         document_property("preferred operators", "no");
     }
@@ -132,6 +417,8 @@ public:
             utils::get_rng_arguments_from_options(opts),
             opts.get<DotGraphVerbosity>("dot_graph_verbosity"),
             opts.get<bool>("use_general_costs"),
+            opts.get<double>("background_time"),
+            opts.get<int>("background_memory"),
             get_heuristic_arguments_from_options(opts));
     }
 };
@@ -3,10 +3,20 @@
 
 #include "../heuristic.h"
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+namespace utils {
+class CountdownTimer;
+class RandomNumberGenerator;
+}
+
 namespace cartesian_abstractions {
 class CartesianHeuristicFunction;
+class MemoryLimit;
 class SubtaskGenerator;
 enum class DotGraphVerbosity;
 enum class PickFlawedAbstractState;
@@ -16,10 +26,59 @@ enum class TransitionRepresentation;
 /*
   Store CartesianHeuristicFunctions and compute overall heuristic by
   summing all of their values.
+
+  In anytime mode (background_time > 0), a background thread keeps
+  building finer abstraction collections during the search. We start the
+  thread when the first state is evaluated, i.e., after all other
+  components have been created. Each round doubles the time limit of the
+  previous round and refines the abstractions for the state with the
+  lowest heuristic value that the search evaluated since the last round. If the new collection yields a
+  higher value for this state, the background thread publishes it and the
+  search thread adopts it when it evaluates the next state and doesn't have
+  to wait for the lock. The background thread also destroys the replaced
+  collections, so that all tasks created for the refinement are created
+  and destroyed in the same thread.
+
+  The background refinement has its own memory limit on the peak memory
+  of the planner and leaves the extra memory padding to other components.
+  It also uses its own RNG for all random decisions. The overall
+  background_time is wall-clock time, while each round is limited by the
+  CPU time of the background thread, so that the search thread doesn't eat
+  into the time of a round. Both threads consume the CPU time limit of the
+  planner, though.
 */
 class AdditiveCartesianHeuristic : public Heuristic {
     std::vector<CartesianHeuristicFunction> heuristic_functions;
 
+    const double background_time;
+    const int background_memory_mb;
+    const double max_time;
+    std::function<std::vector<CartesianHeuristicFunction>(
+        const std::shared_ptr<AbstractTask> &task, double max_time,
+        bool &hit_time_limit)>
+        build_refined_heuristic_functions;
+    std::unique_ptr<utils::RandomNumberGenerator> background_rng;
+    std::unique_ptr<MemoryLimit> background_memory_limit;
+    bool background_refinement_started;
+    int initial_h;
+    std::unique_ptr<utils::CountdownTimer> background_timer;
+
+    std::thread background_thread;
+    std::atomic<bool> stop_refinement;
+    std::mutex heuristic_functions_mutex;
+    std::vector<CartesianHeuristicFunction> new_heuristic_functions;
+    std::vector<CartesianHeuristicFunction> replaced_heuristic_functions;
+    std::atomic<bool> has_new_heuristic_functions;
+    std::mutex guiding_state_mutex;
+    std::vector<int> guiding_state_values;
+    std::atomic<int> guiding_state_h;
+    int num_adopted_collections;
+
+    void start_background_refinement();
+    void run_background_refinement();
+    void select_guiding_state(const State &state, int h);
+    bool adopt_new_heuristic_functions();
+
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 
@@ -32,9 +91,14 @@ public:
         int max_concrete_states_per_abstract_state, int max_state_expansions,
         TransitionRepresentation transition_representation, int memory_padding,
         int random_seed, DotGraphVerbosity dot_graph_verbosity,
-        bool use_general_costs, const std::shared_ptr<AbstractTask> &transform,
+        bool use_general_costs, double background_time,
+        int background_memory, const std::shared_ptr<AbstractTask> &transform,
         bool cache_estimates, const std::string &description,
         utils::Verbosity verbosity);
+    virtual ~AdditiveCartesianHeuristic() override;
+
+    // Stop and join the background thread (if any).
+    void stop_background_refinement();
 };
 }
 
@@ -10,6 +10,7 @@ namespace cartesian_abstractions {
 CartesianHeuristicFunction::CartesianHeuristicFunction(
     unique_ptr<RefinementHierarchy> &&hierarchy, vector<int> &&h_values)
     : refinement_hierarchy(move(hierarchy)), h_values(move(h_values)) {
+    refinement_hierarchy->compile_to_decision_diagram();
 }
 
 int CartesianHeuristicFunction::get_value(const State &state) const {
@@ -7,27 +7,30 @@
 using namespace std;
 
 namespace cartesian_abstractions {
-vector<VariableInfo> CartesianSet::var_infos;
-int CartesianSet::total_num_blocks;
+static shared_ptr<const vector<VariableInfo>> compute_var_infos(
+    const vector<int> &domain_sizes) {
+    auto var_infos = make_shared<vector<VariableInfo>>();
+    var_infos->reserve(domain_sizes.size());
+    int total_num_blocks = 0;
+    for (int domain_size : domain_sizes) {
+        var_infos->emplace_back(domain_size, total_num_blocks);
+        total_num_blocks += var_infos->back().num_blocks;
+    }
+    return var_infos;
+}
 
-CartesianSet::CartesianSet(const vector<int> &domain_sizes) {
+CartesianSet::CartesianSet(const vector<int> &domain_sizes)
+    : var_infos(compute_var_infos(domain_sizes)) {
+    int total_num_blocks =
+        var_infos->empty()
+            ? 0
+            : var_infos->back().block_index + var_infos->back().num_blocks;
     domains.resize(total_num_blocks, 0);
     for (size_t var = 0; var < domain_sizes.size(); ++var) {
         add_all(var);
     }
 }
 
-void CartesianSet::set_static_members(const vector<int> &domain_sizes) {
-    var_infos.clear();
-    var_infos.reserve(domain_sizes.size());
-    total_num_blocks = 0;
-    for (int domain_size : domain_sizes) {
-        int num_blocks = BitsetMath::compute_num_blocks(domain_size);
-        var_infos.emplace_back(domain_size, total_num_blocks);
-        total_num_blocks += num_blocks;
-    }
-}
-
 void CartesianSet::add(int var, int value) {
     get_view(var).set(value);
 }
@@ -56,7 +59,7 @@ int CartesianSet::count(int var) const {
 
 vector<int> CartesianSet::get_values(int var) const {
     vector<int> values;
-    int domain_size = var_infos[var].domain_size;
+    int domain_size = (*var_infos)[var].domain_size;
     for (int value = 0; value < domain_size; ++value) {
         if (test(var, value)) {
             values.push_back(value);
@@ -68,10 +71,10 @@ vector<int> CartesianSet::get_values(int var) const {
 bool CartesianSet::has_full_domain(int var) const {
     bool fast_result = get_view(var).test();
 #ifndef NDEBUG
-    bool result = (count(var) == var_infos[var].domain_size);
+    bool result = (count(var) == (*var_infos)[var].domain_size);
     assert(fast_result == result);
     bool slow_result = true;
-    for (int value = 0; value < var_infos[var].domain_size; ++value) {
+    for (int value = 0; value < (*var_infos)[var].domain_size; ++value) {
         if (!test(var, value)) {
             slow_result = false;
             break;
@@ -4,6 +4,7 @@
 #include "../per_state_bitset.h"
 
 #include <cstdlib>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -23,34 +24,32 @@ struct VariableInfo {
 /*
   For each variable store a subset of its domain.
 
-  The underlying data structure is a vector of bitsets.
+  The underlying data structure is a vector of bitsets. All sets derived
+  from the same trivial set share the variable layout, so that abstractions
+  can be built concurrently for tasks with different variables.
 */
 class CartesianSet {
+    std::shared_ptr<const std::vector<VariableInfo>> var_infos;
     std::vector<BitsetMath::Block> domains;
 
-    static std::vector<VariableInfo> var_infos;
-    static int total_num_blocks;
-
     BitsetView get_view(int var) {
         return {
             ArrayView<BitsetMath::Block>(
-                domains.data() + var_infos[var].block_index,
-                var_infos[var].num_blocks),
-            var_infos[var].domain_size};
+                domains.data() + (*var_infos)[var].block_index,
+                (*var_infos)[var].num_blocks),
+            (*var_infos)[var].domain_size};
     }
     ConstBitsetView get_view(int var) const {
         return {
             ConstArrayView<BitsetMath::Block>(
-                domains.data() + var_infos[var].block_index,
-                var_infos[var].num_blocks),
-            var_infos[var].domain_size};
+                domains.data() + (*var_infos)[var].block_index,
+                (*var_infos)[var].num_blocks),
+            (*var_infos)[var].domain_size};
     }
 
 public:
     explicit CartesianSet(const std::vector<int> &domain_sizes);
 
-    static void set_static_members(const std::vector<int> &domain_sizes);
-
     void add(int var, int value);
     void set_single_value(int var, int value);
     void remove(int var, int value);
@@ -67,7 +66,7 @@ public:
         int bit_index = value % BitsetMath::bits_per_block;
         assert(block_index == static_cast<int>(BitsetMath::block_index(value)));
         assert(bit_index == static_cast<int>(BitsetMath::bit_index(value)));
-        block_index += var_infos[var].block_index;
+        block_index += (*var_infos)[var].block_index;
         BitsetMath::Block bit_mask = BitsetMath::Block(1) << bit_index;
         assert(bit_mask == BitsetMath::bit_mask(value));
         bool result = (domains[block_index] & bit_mask) != 0;
@@ -80,9 +79,9 @@ public:
     bool has_full_domain(int var) const;
 
     bool intersects(const CartesianSet &other, int var) const {
-        for (int block = var_infos[var].block_index;
-             block < var_infos[var].block_index + var_infos[var].num_blocks;
-             ++block) {
+        const VariableInfo &info = (*var_infos)[var];
+        for (int block = info.block_index;
+             block < info.block_index + info.num_blocks; ++block) {
             if (domains[block] & other.domains[block]) {
                 return true;
             }
@@ -94,7 +93,7 @@ public:
     bool is_superset_of(const CartesianSet &other) const;
 
     int get_num_variables() const {
-        return var_infos.size();
+        return var_infos->size();
     }
 
     double compute_size() const;
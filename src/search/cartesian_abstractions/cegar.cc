@@ -6,10 +6,10 @@
 #include "transition_system.h"
 #include "utils.h"
 
+#include "../task_utils/compiled_task.h"
 #include "../task_utils/task_properties.h"
 #include "../tasks/domain_abstracted_task.h"
 #include "../utils/logging.h"
-#include "../utils/memory.h"
 
 #include <cassert>
 #include <iostream>
@@ -23,8 +23,9 @@ CEGAR::CEGAR(
     PickSplit pick_split, PickSplit tiebreak_split,
     int max_concrete_states_per_abstract_state, int max_state_expansions,
     TransitionRepresentation transition_representation,
-    utils::RandomNumberGenerator &rng, utils::LogProxy &log,
-    DotGraphVerbosity dot_graph_verbosity)
+    MemoryLimit &memory_limit, utils::RandomNumberGenerator &rng,
+    utils::LogProxy &log, DotGraphVerbosity dot_graph_verbosity,
+    utils::Clock clock)
     : task_proxy(*task),
       domain_sizes(get_domain_sizes(task_proxy)),
       max_states(max_states),
@@ -33,11 +34,12 @@ CEGAR::CEGAR(
               ? max_transitions
               : INF),
       pick_flawed_abstract_state(pick_flawed_abstract_state),
-      transition_rewirer(
-          make_shared<TransitionRewirer>(task_proxy.get_operators())),
+      transition_rewirer(make_shared<TransitionRewirer>(
+          compiled_task::g_compiled_tasks[task_proxy])),
       abstraction(make_unique<Abstraction>(
           task, transition_rewirer, transition_representation, log)),
-      timer(max_time),
+      timer(max_time, clock),
+      memory_limit(memory_limit),
       log(log),
       dot_graph_verbosity(dot_graph_verbosity) {
     assert(max_states >= 1);
@@ -51,7 +53,7 @@ CEGAR::CEGAR(
     flaw_search = make_unique<FlawSearch>(
         task, *abstraction, *shortest_paths, rng, pick_flawed_abstract_state,
         pick_split, tiebreak_split, max_concrete_states_per_abstract_state,
-        max_state_expansions, log);
+        max_state_expansions, memory_limit, log);
 
     if (log.is_at_least_normal()) {
         log << "Start building abstraction." << endl;
@@ -143,7 +145,7 @@ bool CEGAR::may_keep_refining() const {
             log << "Reached time limit." << endl;
         }
         return false;
-    } else if (!utils::extra_memory_padding_is_reserved()) {
+    } else if (memory_limit.is_reached()) {
         if (log.is_at_least_normal()) {
             log << "Reached memory limit." << endl;
         }
@@ -216,7 +218,9 @@ void CEGAR::refinement_loop() {
                 }
             }
         } else {
-            log << "Abstract task is unsolvable." << endl;
+            if (log.is_at_least_normal()) {
+                log << "Abstract task is unsolvable." << endl;
+            }
             break;
         }
 
@@ -232,18 +236,24 @@ void CEGAR::refinement_loop() {
         }
         find_flaw_timer.stop();
 
-        if (!utils::extra_memory_padding_is_reserved()) {
-            log << "Reached memory limit in flaw search." << endl;
+        if (memory_limit.is_reached()) {
+            if (log.is_at_least_normal()) {
+                log << "Reached memory limit in flaw search." << endl;
+            }
             break;
         }
 
         if (timer.is_expired()) {
-            log << "Reached time limit in flaw search." << endl;
+            if (log.is_at_least_normal()) {
+                log << "Reached time limit in flaw search." << endl;
+            }
             break;
         }
 
         if (!split) {
-            log << "Found concrete solution." << endl;
+            if (log.is_at_least_normal()) {
+                log << "Found concrete solution." << endl;
+            }
             break;
         }
 
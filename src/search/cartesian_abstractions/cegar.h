@@ -20,6 +20,7 @@ class LogProxy;
 namespace cartesian_abstractions {
 class Abstraction;
 enum class DotGraphVerbosity;
+class MemoryLimit;
 class ShortestPaths;
 
 /*
@@ -45,6 +46,7 @@ class CEGAR {
     // Limit the time for building the abstraction.
     utils::CountdownTimer timer;
 
+    MemoryLimit &memory_limit;
     utils::LogProxy &log;
     const DotGraphVerbosity dot_graph_verbosity;
 
@@ -77,8 +79,9 @@ public:
         PickSplit pick_split, PickSplit tiebreak_split,
         int max_concrete_states_per_abstract_state, int max_state_expansions,
         TransitionRepresentation transition_representation,
-        utils::RandomNumberGenerator &rng, utils::LogProxy &log,
-        DotGraphVerbosity dot_graph_verbosity);
+        MemoryLimit &memory_limit, utils::RandomNumberGenerator &rng,
+        utils::LogProxy &log, DotGraphVerbosity dot_graph_verbosity,
+        utils::Clock clock = utils::Clock::PROCESS_CPU);
     ~CEGAR();
 
     CEGAR(const CEGAR &) = delete;
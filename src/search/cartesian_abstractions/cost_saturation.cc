@@ -80,7 +80,8 @@ CostSaturation::CostSaturation(
     int max_concrete_states_per_abstract_state, int max_state_expansions,
     TransitionRepresentation transition_representation, int memory_padding_mb,
     utils::RandomNumberGenerator &rng, utils::LogProxy &log,
-    DotGraphVerbosity dot_graph_verbosity)
+    DotGraphVerbosity dot_graph_verbosity, MemoryLimit &memory_limit,
+    utils::RandomNumberGenerator *subtask_rng, utils::Clock clock)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_transitions(max_transitions),
@@ -97,9 +98,13 @@ CostSaturation::CostSaturation(
       rng(rng),
       log(log),
       dot_graph_verbosity(dot_graph_verbosity),
+      memory_limit(memory_limit),
+      subtask_rng(subtask_rng),
+      clock(clock),
       fast_downward_new_handler(get_new_handler()),
       num_states(0),
-      num_transitions(0) {
+      num_transitions(0),
+      reached_time_limit(false) {
 }
 
 vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
@@ -107,7 +112,7 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     // For simplicity this is a member object. Make sure it is in a valid state.
     assert(heuristic_functions.empty());
 
-    utils::CountdownTimer timer(max_time);
+    utils::CountdownTimer timer(max_time, clock);
 
     TaskProxy task_proxy(*task);
 
@@ -125,21 +130,27 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
 
     for (const shared_ptr<SubtaskGenerator> &subtask_generator :
          subtask_generators) {
-        SharedTasks subtasks = subtask_generator->get_subtasks(task, log);
-        log << "Build abstractions for " << subtasks.size() << " subtasks in "
-            << timer.get_remaining_time() << endl;
-        cout << endl;
+        SharedTasks subtasks =
+            subtask_generator->get_subtasks(task, subtask_rng, log);
+        if (log.is_at_least_normal()) {
+            log << "Build abstractions for " << subtasks.size()
+                << " subtasks in " << timer.get_remaining_time() << endl;
+            cout << endl;
+        }
         build_abstractions(subtasks, timer, should_abort);
         if (should_abort())
             break;
     }
-    if (utils::extra_memory_padding_is_reserved()) {
-        utils::g_log
-            << "Done building abstractions --> release extra memory padding."
-            << endl;
-        utils::release_extra_memory_padding();
+    reached_time_limit = timer.is_expired();
+    if (memory_limit.uses_memory_padding()) {
+        if (utils::extra_memory_padding_is_reserved()) {
+            log << "Done building abstractions --> release extra memory "
+                   "padding."
+                << endl;
+            utils::release_extra_memory_padding();
+        }
+        set_new_handler(fast_downward_new_handler);
     }
-    set_new_handler(fast_downward_new_handler);
     print_statistics(timer.get_elapsed_time());
 
     vector<CartesianHeuristicFunction> functions;
@@ -206,7 +217,16 @@ void CostSaturation::build_abstractions(
         subtask = get_remaining_costs_task(subtask);
         assert(num_states < max_states);
 
-        if (!utils::extra_memory_padding_is_reserved()) {
+        if (!memory_limit.uses_memory_padding()) {
+            if (memory_limit.is_reached()) {
+                if (log.is_at_least_normal()) {
+                    log << "Reached memory limit --> stop building new "
+                           "abstractions."
+                        << endl;
+                }
+                break;
+            }
+        } else if (!utils::extra_memory_padding_is_reserved()) {
             utils::g_log
                 << "Reserve extra memory padding for the next abstraction"
                 << endl;
@@ -231,9 +251,11 @@ void CostSaturation::build_abstractions(
             get_subtask_limit(max_transitions, num_transitions, rem_subtasks),
             time_limit, pick_flawed_abstract_state, pick_split, tiebreak_split,
             max_concrete_states_per_abstract_state, max_state_expansions,
-            transition_representation, rng, log, dot_graph_verbosity);
+            transition_representation, memory_limit, rng, log,
+            dot_graph_verbosity, clock);
         // Reset new-handler if we ran out of memory.
-        if (!utils::extra_memory_padding_is_reserved()) {
+        if (memory_limit.uses_memory_padding() &&
+            !utils::extra_memory_padding_is_reserved()) {
             set_new_handler(fast_downward_new_handler);
         }
 
@@ -244,8 +266,11 @@ void CostSaturation::build_abstractions(
 
         vector<int> goal_distances = cegar.get_goal_distances();
         if (subtask_generators.size() == 1 && subtasks.size() == 1) {
-            log << "There is only one abstraction --> skip computing saturated costs."
-                << endl;
+            if (log.is_at_least_normal()) {
+                log << "There is only one abstraction --> skip computing "
+                       "saturated costs."
+                    << endl;
+            }
         } else {
             scf_timer.resume();
             vector<int> saturated_costs = compute_saturated_costs(
@@ -257,10 +282,14 @@ void CostSaturation::build_abstractions(
         int num_unsolvable_states = count(
             execution::unseq, goal_distances.begin(), goal_distances.end(),
             INF);
-        log << "Unsolvable Cartesian states: " << num_unsolvable_states << endl;
-        log << "Initial h value: "
-            << goal_distances[abstraction->get_initial_state().get_id()] << endl
-            << endl;
+        if (log.is_at_least_normal()) {
+            log << "Unsolvable Cartesian states: " << num_unsolvable_states
+                << endl;
+            log << "Initial h value: "
+                << goal_distances[abstraction->get_initial_state().get_id()]
+                << endl
+                << endl;
+        }
 
         heuristic_functions.emplace_back(
             abstraction->extract_refinement_hierarchy(), move(goal_distances));
@@ -270,8 +299,10 @@ void CostSaturation::build_abstractions(
             break;
         }
     }
-    utils::g_log << "Time for computing saturated cost functions: " << scf_timer
-                 << endl;
+    if (log.is_at_least_normal()) {
+        log << "Time for computing saturated cost functions: " << scf_timer
+            << endl;
+    }
 }
 
 void CostSaturation::print_statistics(utils::Duration init_time) const {
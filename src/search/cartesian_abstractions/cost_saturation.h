@@ -5,12 +5,13 @@
 #include "refinement_hierarchy.h"
 #include "split_selector.h"
 
+#include "../utils/timer.h"
+
 #include <memory>
 #include <vector>
 
 namespace utils {
 class CountdownTimer;
-class Duration;
 class RandomNumberGenerator;
 class LogProxy;
 }
@@ -18,6 +19,7 @@ class LogProxy;
 namespace cartesian_abstractions {
 class CartesianHeuristicFunction;
 enum class DotGraphVerbosity;
+class MemoryLimit;
 class SubtaskGenerator;
 
 /*
@@ -26,6 +28,15 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  If the memory limit uses the extra memory padding, we reserve the padding
+  for building the abstractions and release it afterwards. Otherwise, we
+  don't touch the padding and stop building abstractions once the memory
+  limit is reached.
+
+  If subtask_rng is given, the subtask generators draw random numbers from
+  it instead of from their own RNGs. The given clock measures max_time and
+  the time limits of the individual CEGAR runs.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
@@ -43,12 +54,16 @@ class CostSaturation {
     utils::RandomNumberGenerator &rng;
     utils::LogProxy &log;
     const cartesian_abstractions::DotGraphVerbosity dot_graph_verbosity;
+    MemoryLimit &memory_limit;
+    utils::RandomNumberGenerator *subtask_rng;
+    const utils::Clock clock;
 
     void (*fast_downward_new_handler)();
     std::vector<CartesianHeuristicFunction> heuristic_functions;
     std::vector<int> remaining_costs;
     int num_states;
     int num_transitions;
+    bool reached_time_limit;
 
     void reset(const TaskProxy &task_proxy);
     void reduce_remaining_costs(const std::vector<int> &saturated_costs);
@@ -72,10 +87,19 @@ public:
         int max_concrete_states_per_abstract_state, int max_state_expansions,
         TransitionRepresentation transition_representation,
         int memory_padding_mb, utils::RandomNumberGenerator &rng,
-        utils::LogProxy &log, DotGraphVerbosity dot_graph_verbosity);
+        utils::LogProxy &log, DotGraphVerbosity dot_graph_verbosity,
+        MemoryLimit &memory_limit,
+        utils::RandomNumberGenerator *subtask_rng = nullptr,
+        utils::Clock clock = utils::Clock::PROCESS_CPU);
 
     std::vector<CartesianHeuristicFunction> generate_heuristic_functions(
         const std::shared_ptr<AbstractTask> &task);
+
+    // Return true iff the last call to generate_heuristic_functions() ran
+    // out of time.
+    bool hit_time_limit() const {
+        return reached_time_limit;
+    }
 };
 
 extern int get_subtask_limit(int limit, int used, int remaining_subtasks);
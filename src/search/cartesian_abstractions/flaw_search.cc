@@ -12,7 +12,6 @@
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/countdown_timer.h"
-#include "../utils/memory.h"
 #include "../utils/rng.h"
 
 using namespace std;
@@ -118,7 +117,7 @@ SearchStatus FlawSearch::step() {
     // Check for each transition if the operator is applicable or if there is a
     // deviation.
     for (auto &pair : get_f_optimal_transitions(abs_id)) {
-        if (!utils::extra_memory_padding_is_reserved()) {
+        if (memory_limit.is_reached()) {
             return TIMEOUT;
         }
 
@@ -326,7 +325,7 @@ unique_ptr<Split> FlawSearch::create_split(
             State succ_state = state_registry->get_successor_state(state, op);
             bool target_hit = false;
             for (int target : targets) {
-                if (!utils::extra_memory_padding_is_reserved()) {
+                if (memory_limit.is_reached()) {
                     return nullptr;
                 }
 
@@ -447,7 +446,7 @@ unique_ptr<Split> FlawSearch::get_single_split(
             vector<OperatorID> trace = search_space->trace_path(
                 task_proxy,
                 successor_generator::g_successor_generators[task_proxy],
-                state_registry->lookup_state(state_id));
+                state_registry->lookup_state(state_id), OperatorCost::NORMAL);
             vector<string> operator_names;
             operator_names.reserve(trace.size());
             for (OperatorID op_id : trace) {
@@ -526,7 +525,7 @@ unique_ptr<Split> FlawSearch::get_min_h_batch_split(
         unique_ptr<Split> split;
         split = create_split(flawed_state.concrete_states, flawed_state.abs_id);
 
-        if (!utils::extra_memory_padding_is_reserved()) {
+        if (memory_limit.is_reached()) {
             return nullptr;
         }
 
@@ -550,7 +549,8 @@ FlawSearch::FlawSearch(
     const ShortestPaths &shortest_paths, utils::RandomNumberGenerator &rng,
     PickFlawedAbstractState pick_flawed_abstract_state, PickSplit pick_split,
     PickSplit tiebreak_split, int max_concrete_states_per_abstract_state,
-    int max_state_expansions, const utils::LogProxy &log)
+    int max_state_expansions, MemoryLimit &memory_limit,
+    const utils::LogProxy &log)
     : task_proxy(*task),
       domain_sizes(get_domain_sizes(task_proxy)),
       abstraction(abstraction),
@@ -561,6 +561,7 @@ FlawSearch::FlawSearch(
       max_concrete_states_per_abstract_state(
           max_concrete_states_per_abstract_state),
       max_state_expansions(max_state_expansions),
+      memory_limit(memory_limit),
       log(log),
       silent_log(utils::get_silent_log()),
       last_refined_flawed_state(FlawedState::no_state),
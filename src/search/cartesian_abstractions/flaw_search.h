@@ -21,6 +21,7 @@ class RandomNumberGenerator;
 
 namespace cartesian_abstractions {
 class Abstraction;
+class MemoryLimit;
 class ShortestPaths;
 
 // Variants from ICAPS 2022 paper (in order): FIRST, MIN_H, MAX_H, MIN_H,
@@ -44,6 +45,7 @@ class FlawSearch {
     const PickFlawedAbstractState pick_flawed_abstract_state;
     const int max_concrete_states_per_abstract_state;
     const int max_state_expansions;
+    MemoryLimit &memory_limit;
     mutable utils::LogProxy log;
     mutable utils::LogProxy silent_log; // For concrete search space.
 
@@ -94,7 +96,7 @@ public:
         PickFlawedAbstractState pick_flawed_abstract_state,
         PickSplit pick_split, PickSplit tiebreak_split,
         int max_concrete_states_per_abstract_state, int max_state_expansions,
-        const utils::LogProxy &log);
+        MemoryLimit &memory_limit, const utils::LogProxy &log);
 
     std::unique_ptr<Split> get_split(const utils::CountdownTimer &cegar_timer);
     std::unique_ptr<Split> get_split_legacy(const Solution &solution);
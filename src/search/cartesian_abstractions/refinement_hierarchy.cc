@@ -4,8 +4,12 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/collections.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
+#include <stack>
+
 using namespace std;
 
 namespace cartesian_abstractions {
@@ -62,6 +66,7 @@ NodeID RefinementHierarchy::add_node(int state_id) {
 }
 
 NodeID RefinementHierarchy::get_node_id(const State &state) const {
+    assert(!is_compiled());
     NodeID id = 0;
     while (nodes[id].is_split()) {
         id = nodes[id].get_child(state[nodes[id].get_var()].get_value());
@@ -69,9 +74,20 @@ NodeID RefinementHierarchy::get_node_id(const State &state) const {
     return id;
 }
 
+int RefinementHierarchy::lookup_in_decision_diagram(const State &state) const {
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    int ref = 0;
+    while (ref >= 0) {
+        ref = decision_diagram[ref + 1 + values[decision_diagram[ref]]];
+    }
+    return -1 - ref;
+}
+
 pair<NodeID, NodeID> RefinementHierarchy::split(
     NodeID node_id, int var, const vector<int> &values, int left_state_id,
     int right_state_id) {
+    assert(!is_compiled());
     NodeID helper_id = node_id;
     NodeID right_child_id = add_node(right_state_id);
     for (int value : values) {
@@ -82,9 +98,81 @@ pair<NodeID, NodeID> RefinementHierarchy::split(
     return make_pair(helper_id, right_child_id);
 }
 
+void RefinementHierarchy::compile_to_decision_diagram() {
+    assert(!is_compiled());
+    if (!nodes[0].is_split()) {
+        // There is only a single abstract state.
+        return;
+    }
+    vector<int> domain_sizes = get_domain_sizes(TaskProxy(*task));
+
+    // Assign offsets to the inner nodes in depth-first order, skipping helpers.
+    int64_t max_size = static_cast<int64_t>(nodes.size()) * sizeof(Node) /
+                       sizeof(int);
+    int64_t size = 0;
+    vector<int> offsets(nodes.size(), UNDEFINED);
+    vector<NodeID> inner_nodes;
+    stack<NodeID> stack;
+    stack.push(0);
+    while (!stack.empty()) {
+        NodeID node_id = stack.top();
+        stack.pop();
+        const Node &node = nodes[node_id];
+        if (!node.is_split()) {
+            continue;
+        }
+        offsets[node_id] = size;
+        inner_nodes.push_back(node_id);
+        size += 1 + domain_sizes[node.var];
+        if (size > max_size) {
+            // The decision diagram would need more memory than the hierarchy.
+            return;
+        }
+        NodeID helper = node.left_child;
+        while (nodes[helper].right_child == node.right_child) {
+            helper = nodes[helper].left_child;
+        }
+        stack.push(helper);
+        stack.push(node.right_child);
+    }
+
+    auto get_reference = [&](NodeID node_id) {
+        const Node &node = nodes[node_id];
+        return node.is_split() ? offsets[node_id] : -1 - node.get_state_id();
+    };
+
+    decision_diagram.resize(size);
+    for (NodeID node_id : inner_nodes) {
+        const Node &node = nodes[node_id];
+        int offset = offsets[node_id];
+        decision_diagram[offset] = node.var;
+        int *children = &decision_diagram[offset + 1];
+        // All values that are not split off lead to the end of the helper chain.
+        NodeID helper = node.left_child;
+        while (nodes[helper].right_child == node.right_child) {
+            helper = nodes[helper].left_child;
+        }
+        fill(children, children + domain_sizes[node.var], get_reference(helper));
+        int right_reference = get_reference(node.right_child);
+        for (NodeID id = node_id; nodes[id].right_child == node.right_child;
+             id = nodes[id].left_child) {
+            assert(nodes[id].var == node.var);
+            children[nodes[id].value] = right_reference;
+        }
+    }
+    utils::release_vector_memory(nodes);
+}
+
 int RefinementHierarchy::get_abstract_state_id(const State &state) const {
     TaskProxy subtask_proxy(*task);
-    if (subtask_proxy.needs_to_convert_ancestor_state(state)) {
+    if (is_compiled()) {
+        if (subtask_proxy.needs_to_convert_ancestor_state(state)) {
+            return lookup_in_decision_diagram(
+                subtask_proxy.convert_ancestor_state(state));
+        } else {
+            return lookup_in_decision_diagram(state);
+        }
+    } else if (subtask_proxy.needs_to_convert_ancestor_state(state)) {
         State subtask_state = subtask_proxy.convert_ancestor_state(state);
         return nodes[get_node_id(subtask_state)].get_state_id();
     } else {
@@ -93,6 +181,7 @@ int RefinementHierarchy::get_abstract_state_id(const State &state) const {
 }
 
 int RefinementHierarchy::get_abstract_state_id(NodeID node_id) const {
+    assert(!is_compiled());
     return nodes[node_id].get_state_id();
 }
 
@@ -105,11 +194,16 @@ shared_ptr<AbstractTask> RefinementHierarchy::get_task() const {
 }
 
 void RefinementHierarchy::print_statistics(utils::LogProxy &log) const {
+    if (is_compiled()) {
+        log << "Decision diagram entries: " << decision_diagram.size() << endl;
+        return;
+    }
     log << "Refinement hierarchy nodes: " << nodes.size() << endl;
     log << "Refinement hierarchy capacity: " << nodes.capacity() << endl;
 }
 
 void RefinementHierarchy::dump(int level, NodeID id) const {
+    assert(!is_compiled());
     for (int i = 0; i < level; ++i) {
         cout << "  ";
     }
@@ -75,13 +75,28 @@ static_assert(sizeof(Node) == 16, "Node has unexpected size");
   helper nodes, see below). Leaf nodes correspond to the current
   (unsplit) states in an abstraction. The use of helper nodes makes
   this structure a directed acyclic graph (instead of a tree).
+
+  Once the abstraction is complete, the hierarchy can be compiled into a
+  decision diagram that only supports looking up abstract states (see
+  compile_to_decision_diagram()).
 */
 class RefinementHierarchy {
     std::shared_ptr<AbstractTask> task;
     std::vector<Node> nodes;
 
+    /*
+      Decision diagram stored in a single array. An inner node at offset i
+      occupies 1 + |dom(var)| entries: decision_diagram[i] holds the split
+      variable var and decision_diagram[i + 1 + value] holds the reference
+      to the child for var=value. Non-negative references are offsets of
+      inner nodes and a negative reference r stands for the abstract state
+      -1 - r. The root node lies at offset 0.
+    */
+    std::vector<int> decision_diagram;
+
     NodeID add_node(int state_id);
     NodeID get_node_id(const State &state) const;
+    int lookup_in_decision_diagram(const State &state) const;
 
     // Helper data structure that holds the result for get_real_children().
     struct Children {
@@ -132,6 +147,18 @@ public:
         NodeID node_id, int var, const std::vector<int> &values,
         int left_state_id, int right_state_id);
 
+    /*
+      Replace the hierarchy by a decision diagram that branches on all
+      values of the split variable instead of following helper chains.
+      We only compile the hierarchy if the diagram needs at most as much
+      memory as the hierarchy. Afterwards, the hierarchy only supports
+      get_abstract_state_id(const State &) and print_statistics().
+    */
+    void compile_to_decision_diagram();
+    bool is_compiled() const {
+        return !decision_diagram.empty();
+    }
+
     int get_abstract_state_id(const State &state) const;
     int get_abstract_state_id(NodeID node_id) const;
 
@@ -157,6 +184,7 @@ template<typename Callback>
 void RefinementHierarchy::for_each_leaf(
     const CartesianSets &all_cartesian_sets, const CartesianSet &cartesian_set,
     const Matcher &matcher, const Callback &callback) const {
+    assert(!is_compiled());
     std::stack<NodeID> stack;
     stack.push(0);
     while (!stack.empty()) {
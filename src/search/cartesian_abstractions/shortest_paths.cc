@@ -433,7 +433,9 @@ void ShortestPaths::update_incrementally(
         if (timer.is_expired()) {
             // Up to here all goal distances are always lower bounds, so we can
             // abort at any time.
-            cout << "Timer expired --> abort incremental search" << endl;
+            if (log.is_at_least_normal()) {
+                log << "Timer expired --> abort incremental search" << endl;
+            }
             return;
         }
     }
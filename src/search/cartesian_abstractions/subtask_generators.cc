@@ -93,7 +93,8 @@ TaskDuplicator::TaskDuplicator(int copies) : num_copies(copies) {
 }
 
 SharedTasks TaskDuplicator::get_subtasks(
-    const shared_ptr<AbstractTask> &task, utils::LogProxy &) const {
+    const shared_ptr<AbstractTask> &task, utils::RandomNumberGenerator *,
+    utils::LogProxy &) const {
     SharedTasks subtasks;
     subtasks.reserve(num_copies);
     for (int i = 0; i < num_copies; ++i) {
@@ -107,11 +108,13 @@ GoalDecomposition::GoalDecomposition(FactOrder order, int random_seed)
 }
 
 SharedTasks GoalDecomposition::get_subtasks(
-    const shared_ptr<AbstractTask> &task, utils::LogProxy &log) const {
+    const shared_ptr<AbstractTask> &task, utils::RandomNumberGenerator *rng,
+    utils::LogProxy &log) const {
     SharedTasks subtasks;
     TaskProxy task_proxy(*task);
     Facts goal_facts = task_properties::get_fact_pairs(task_proxy.get_goals());
-    filter_and_order_facts(task, fact_order, goal_facts, *rng, log);
+    filter_and_order_facts(
+        task, fact_order, goal_facts, rng ? *rng : *this->rng, log);
     for (const FactPair &goal : goal_facts) {
         shared_ptr<AbstractTask> subtask =
             make_shared<extra_tasks::ModifiedGoalsTask>(task, Facts{goal});
@@ -142,14 +145,16 @@ shared_ptr<AbstractTask> LandmarkDecomposition::build_domain_abstracted_task(
 }
 
 SharedTasks LandmarkDecomposition::get_subtasks(
-    const shared_ptr<AbstractTask> &task, utils::LogProxy &log) const {
+    const shared_ptr<AbstractTask> &task, utils::RandomNumberGenerator *rng,
+    utils::LogProxy &log) const {
     SharedTasks subtasks;
     const shared_ptr<landmarks::LandmarkGraph> landmark_graph =
         get_landmark_graph(task);
     utils::HashMap<FactPair, landmarks::LandmarkNode *> atom_to_landmark_map =
         get_atom_to_landmark_map(landmark_graph);
     Facts landmark_facts = get_atom_landmarks(*landmark_graph);
-    filter_and_order_facts(task, fact_order, landmark_facts, *rng, log);
+    filter_and_order_facts(
+        task, fact_order, landmark_facts, rng ? *rng : *this->rng, log);
     for (const FactPair &landmark : landmark_facts) {
         shared_ptr<AbstractTask> subtask =
             make_shared<extra_tasks::ModifiedGoalsTask>(task, Facts{landmark});
@@ -30,12 +30,15 @@ enum class FactOrder {
 
 /*
   Create focused subtasks.
+
+  Generators that order facts randomly use their own RNG unless rng is
+  given. Callers in other threads must pass a dedicated RNG.
 */
 class SubtaskGenerator {
 public:
     virtual SharedTasks get_subtasks(
         const std::shared_ptr<AbstractTask> &task,
-        utils::LogProxy &log) const = 0;
+        utils::RandomNumberGenerator *rng, utils::LogProxy &log) const = 0;
     virtual ~SubtaskGenerator() = default;
 };
 
@@ -50,6 +53,7 @@ public:
 
     virtual SharedTasks get_subtasks(
         const std::shared_ptr<AbstractTask> &task,
+        utils::RandomNumberGenerator *rng,
         utils::LogProxy &log) const override;
 };
 
@@ -65,6 +69,7 @@ public:
 
     virtual SharedTasks get_subtasks(
         const std::shared_ptr<AbstractTask> &task,
+        utils::RandomNumberGenerator *rng,
         utils::LogProxy &log) const override;
 };
 
@@ -89,6 +94,7 @@ public:
 
     virtual SharedTasks get_subtasks(
         const std::shared_ptr<AbstractTask> &task,
+        utils::RandomNumberGenerator *rng,
         utils::LogProxy &log) const override;
 };
 }
@@ -5,51 +5,51 @@
 
 #include "../task_proxy.h"
 
-#include "../task_utils/task_properties.h"
+#include "../task_utils/compiled_task.h"
 
 #include <algorithm>
-#include <map>
 
 using namespace std;
 
 namespace cartesian_abstractions {
 static vector<vector<FactPair>> get_preconditions_by_operator(
-    const OperatorsProxy &ops) {
+    const compiled_task::CompiledTask &task) {
     vector<vector<FactPair>> preconditions_by_operator;
-    preconditions_by_operator.reserve(ops.size());
-    for (OperatorProxy op : ops) {
-        vector<FactPair> preconditions =
-            task_properties::get_fact_pairs(op.get_preconditions());
-        sort(preconditions.begin(), preconditions.end());
-        preconditions_by_operator.push_back(move(preconditions));
+    preconditions_by_operator.reserve(task.get_num_operators());
+    for (int op_id = 0; op_id < task.get_num_operators(); ++op_id) {
+        // Preconditions are already sorted.
+        span<const FactPair> preconditions = task.get_preconditions(op_id);
+        preconditions_by_operator.emplace_back(
+            preconditions.begin(), preconditions.end());
     }
     return preconditions_by_operator;
 }
 
-static vector<FactPair> get_postconditions(const OperatorProxy &op) {
-    // Use map to obtain sorted postconditions.
-    map<int, int> var_to_post;
-    for (FactProxy fact : op.get_preconditions()) {
-        var_to_post[fact.get_variable().get_id()] = fact.get_value();
-    }
-    for (EffectProxy effect : op.get_effects()) {
-        FactPair fact = effect.get_fact().get_pair();
-        var_to_post[fact.var] = fact.value;
-    }
-    vector<FactPair> postconditions;
-    postconditions.reserve(var_to_post.size());
-    for (const pair<const int, int> &fact : var_to_post) {
-        postconditions.emplace_back(fact.first, fact.second);
+static vector<FactPair> get_postconditions(
+    const compiled_task::CompiledTask &task, int op_id) {
+    span<const FactPair> preconditions = task.get_preconditions(op_id);
+    vector<FactPair> postconditions(
+        preconditions.begin(), preconditions.end());
+    for (const FactPair &effect : task.get_effects(op_id)) {
+        auto it = lower_bound(
+            preconditions.begin(), preconditions.end(),
+            FactPair(effect.var, 0));
+        if (it != preconditions.end() && it->var == effect.var) {
+            postconditions[it - preconditions.begin()].value = effect.value;
+        } else {
+            postconditions.push_back(effect);
+        }
     }
+    sort(postconditions.begin(), postconditions.end());
     return postconditions;
 }
 
 static vector<vector<FactPair>> get_postconditions_by_operator(
-    const OperatorsProxy &ops) {
+    const compiled_task::CompiledTask &task) {
     vector<vector<FactPair>> postconditions_by_operator;
-    postconditions_by_operator.reserve(ops.size());
-    for (OperatorProxy op : ops) {
-        postconditions_by_operator.push_back(get_postconditions(op));
+    postconditions_by_operator.reserve(task.get_num_operators());
+    for (int op_id = 0; op_id < task.get_num_operators(); ++op_id) {
+        postconditions_by_operator.push_back(get_postconditions(task, op_id));
     }
     return postconditions_by_operator;
 }
@@ -94,9 +94,9 @@ static void add_loop(deque<Loops> &loops, int state_id, int op_id) {
     loops[state_id].push_back(op_id);
 }
 
-TransitionRewirer::TransitionRewirer(const OperatorsProxy &ops)
-    : preconditions_by_operator(get_preconditions_by_operator(ops)),
-      postconditions_by_operator(get_postconditions_by_operator(ops)) {
+TransitionRewirer::TransitionRewirer(const compiled_task::CompiledTask &task)
+    : preconditions_by_operator(get_preconditions_by_operator(task)),
+      postconditions_by_operator(get_postconditions_by_operator(task)) {
 }
 
 void TransitionRewirer::rewire_transitions(
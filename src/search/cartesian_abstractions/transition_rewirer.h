@@ -10,7 +10,10 @@
 #include <vector>
 
 struct FactPair;
-class OperatorsProxy;
+
+namespace compiled_task {
+class CompiledTask;
+}
 
 namespace cartesian_abstractions {
 class TransitionRewirer {
@@ -30,7 +33,7 @@ class TransitionRewirer {
         const AbstractState &v2, int var) const;
 
 public:
-    explicit TransitionRewirer(const OperatorsProxy &ops);
+    explicit TransitionRewirer(const compiled_task::CompiledTask &task);
 
     void rewire_transitions(
         std::deque<Transitions> &incoming, std::deque<Transitions> &outgoing,
@@ -9,7 +9,9 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/rng_options.h"
+#include "../utils/system.h"
 
 #include <algorithm>
 #include <cassert>
@@ -221,6 +223,39 @@ void add_common_cegar_options(plugins::Feature &feature) {
     add_dot_graph_verbosity(feature);
 }
 
+MemoryLimit::MemoryLimit() : max_peak_memory_kb(-1), reached(false) {
+}
+
+MemoryLimit::MemoryLimit(int max_peak_memory_kb)
+    : max_peak_memory_kb(max_peak_memory_kb),
+      reached(false),
+      next_check(chrono::steady_clock::now()) {
+    assert(max_peak_memory_kb >= 0);
+}
+
+bool MemoryLimit::is_reached() {
+    if (reached) {
+        return true;
+    }
+    if (uses_memory_padding()) {
+        return !utils::extra_memory_padding_is_reserved();
+    }
+    // Reading the peak memory from the operating system is comparatively
+    // expensive, so we do it at most every 10 milliseconds.
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    if (now >= next_check) {
+        next_check = now + chrono::milliseconds(10);
+        if (utils::get_peak_memory_in_kb() > max_peak_memory_kb) {
+            reached = true;
+        }
+    }
+    return reached;
+}
+
+void MemoryLimit::set_reached() {
+    reached = true;
+}
+
 static plugins::TypedEnumPlugin<DotGraphVerbosity>
     _enum_plugin_dot_graph_verbosity(
         {{"silent", ""}, {"write_to_console", ""}, {"write_to_file", ""}});
@@ -7,6 +7,8 @@
 
 #include "../utils/hash.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -40,6 +42,34 @@ extern std::vector<int> get_domain_sizes(const TaskProxy &task);
 
 extern void add_common_cegar_options(plugins::Feature &feature);
 
+/*
+  Decide when to stop refining because of memory.
+
+  By default, we stop once the extra memory padding has been released,
+  which happens when an allocation fails. Alternatively, we can stop once
+  the peak memory of the planner exceeds a given limit. This doesn't
+  involve the memory padding and is meant for refining abstractions while
+  other parts of the planner keep running.
+
+  In both cases, other threads can end the refinement with set_reached().
+*/
+class MemoryLimit {
+    const int max_peak_memory_kb;
+    std::atomic<bool> reached;
+    std::chrono::steady_clock::time_point next_check;
+
+public:
+    MemoryLimit();
+    explicit MemoryLimit(int max_peak_memory_kb);
+
+    bool uses_memory_padding() const {
+        return max_peak_memory_kb == -1;
+    }
+
+    bool is_reached();
+    void set_reached();
+};
+
 extern std::string create_dot_graph(
     const TaskProxy &task_proxy, const Abstraction &abstraction);
 extern void write_to_file(
@@ -25,7 +25,7 @@ static FactPair get_atom(const Landmark &landmark) {
 shared_ptr<LandmarkGraph> get_landmark_graph(
     const shared_ptr<AbstractTask> &task) {
     LandmarkFactoryHM landmark_graph_factory(
-        1, false, true, utils::Verbosity::SILENT);
+        1, false, true, 1, utils::Verbosity::SILENT);
 
     return landmark_graph_factory.compute_landmark_graph(task);
 }
@@ -159,6 +159,12 @@ static shared_ptr<SearchAlgorithm> parse_cmd_line_aux(
             if (num_previously_generated_plans < 0)
                 input_error(
                     "argument for --internal-previous-portfolio-plans must be positive");
+        } else if (arg == "--read-binary-task" ||
+                   arg == "--write-binary-task") {
+            // These options are handled before reading the task.
+            if (is_last)
+                input_error("missing argument after " + arg);
+            ++i;
         } else {
             input_error("unknown option " + arg);
         }
@@ -196,6 +202,16 @@ shared_ptr<SearchAlgorithm> parse_cmd_line(
     return parse_cmd_line_aux(args);
 }
 
+string get_task_file_option(
+    int argc, const char **argv, const string &option) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (argv[i] == option) {
+            return argv[i + 1];
+        }
+    }
+    return "";
+}
+
 string get_revision_info() {
     return string("Search code revision: ") + g_git_revision;
 }
@@ -217,5 +233,11 @@ string get_usage(const string &progname) {
            "    This planner call is part of a portfolio which already created\n"
            "    plan files FILENAME.1 up to FILENAME.COUNTER.\n"
            "    Start enumerating plan files with COUNTER+1, i.e. FILENAME.COUNTER+1\n\n"
+           "--write-binary-task FILENAME\n"
+           "    Write the input task to a binary task file called FILENAME.\n"
+           "    Without --search, the planner stops after writing the file.\n\n"
+           "--read-binary-task FILENAME\n"
+           "    Read the task from the binary task file FILENAME instead of\n"
+           "    reading translator output from standard input.\n\n"
            "See https://www.fast-downward.org for details.";
 }
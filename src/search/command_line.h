@@ -9,6 +9,14 @@ class SearchAlgorithm;
 extern std::shared_ptr<SearchAlgorithm> parse_cmd_line(
     int argc, const char **argv, bool is_unit_cost);
 
+/*
+  Return the argument of the given option or the empty string if the option
+  is not used. This is needed for options that affect how the task is read,
+  which happens before parsing the rest of the command line.
+*/
+extern std::string get_task_file_option(
+    int argc, const char **argv, const std::string &option);
+
 extern std::string get_revision_info();
 extern std::string get_usage(const std::string &progname);
 
@@ -40,6 +40,15 @@ class AbstractionFunction {
 public:
     virtual ~AbstractionFunction() = default;
     virtual int get_abstract_state_id(const State &concrete_state) const = 0;
+
+    /*
+      Return a key that identifies this function among the abstraction
+      functions for the same task (see AbstractionRegistry), or an empty
+      vector if the function can't be compared to other functions.
+    */
+    virtual std::vector<int> get_key() const {
+        return {};
+    }
 };
 
 class Abstraction {
@@ -0,0 +1,117 @@
+#include "abstraction_registry.h"
+
+#include "abstraction.h"
+
+#include "../task_proxy.h"
+
+#include "../utils/collections.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace cost_saturation {
+AbstractionRegistry::AbstractionRegistry(const TaskProxy &)
+    : num_shared_functions(0),
+      current_timestamp(0),
+      current_state_registry(nullptr),
+      current_state_id(StateID::no_state),
+      current_state(nullptr) {
+}
+
+AbstractionRegistry::~AbstractionRegistry() = default;
+
+vector<int> AbstractionRegistry::add_abstraction_functions(
+    AbstractionFunctions &&functions) {
+    vector<int> slots;
+    slots.reserve(functions.size());
+    for (unique_ptr<AbstractionFunction> &function : functions) {
+        if (!function) {
+            slots.push_back(-1);
+            continue;
+        }
+        vector<int> key = function->get_key();
+        if (!key.empty()) {
+            auto it = slots_by_key.find(key);
+            if (it != slots_by_key.end()) {
+                int slot = it->second;
+                ++num_users[slot];
+                slots.push_back(slot);
+                ++num_shared_functions;
+                continue;
+            }
+        }
+        int slot;
+        if (free_slots.empty()) {
+            slot = abstraction_functions.size();
+            abstraction_functions.emplace_back();
+            keys.emplace_back();
+            num_users.push_back(0);
+            abstract_state_ids.push_back(-1);
+            timestamps.push_back(0);
+        } else {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        if (!key.empty()) {
+            slots_by_key[key] = slot;
+        }
+        abstraction_functions[slot] = move(function);
+        keys[slot] = move(key);
+        num_users[slot] = 1;
+        // The timestamp of a new slot never matches the current timestamp.
+        timestamps[slot] = current_timestamp - 1;
+        slots.push_back(slot);
+    }
+    functions.clear();
+    return slots;
+}
+
+void AbstractionRegistry::remove_abstraction_functions(
+    const vector<int> &slots) {
+    for (int slot : slots) {
+        if (slot == -1) {
+            continue;
+        }
+        assert(utils::in_bounds(slot, num_users) && num_users[slot] > 0);
+        if (--num_users[slot] == 0) {
+            if (!keys[slot].empty()) {
+                slots_by_key.erase(keys[slot]);
+                utils::release_vector_memory(keys[slot]);
+            }
+            abstraction_functions[slot] = nullptr;
+            free_slots.push_back(slot);
+        }
+    }
+}
+
+void AbstractionRegistry::set_state(
+    const State &ancestor_state, const State &state) {
+    const StateRegistry *state_registry = ancestor_state.get_registry();
+    StateID state_id = ancestor_state.get_id();
+    if (!state_registry || state_registry != current_state_registry ||
+        state_id != current_state_id) {
+        ++current_timestamp;
+        current_state_registry = state_registry;
+        current_state_id = state_id;
+    }
+    current_state = &state;
+}
+
+vector<int> AbstractionRegistry::get_abstract_state_ids(
+    const vector<int> &slots) {
+    vector<int> ids;
+    ids.reserve(slots.size());
+    for (int slot : slots) {
+        ids.push_back(slot == -1 ? -1 : get_abstract_state_id(slot));
+    }
+    return ids;
+}
+
+int AbstractionRegistry::compute_abstract_state_id(int slot) const {
+    assert(current_state);
+    return abstraction_functions[slot]->get_abstract_state_id(*current_state);
+}
+
+PerTaskInformation<AbstractionRegistry> g_abstraction_registries;
+}
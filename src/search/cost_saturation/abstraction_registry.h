@@ -0,0 +1,101 @@
+#ifndef COST_SATURATION_ABSTRACTION_REGISTRY_H
+#define COST_SATURATION_ABSTRACTION_REGISTRY_H
+
+#include "types.h"
+
+#include "../per_task_information.h"
+#include "../state_id.h"
+
+#include "../utils/hash.h"
+
+#include <cstdint>
+#include <vector>
+
+class State;
+class StateRegistry;
+
+namespace cost_saturation {
+/*
+  Share abstraction functions between all heuristics for the same task.
+
+  Heuristics hand their abstraction functions to the registry and receive
+  a slot for each of them. Abstraction functions that report the same key
+  (e.g., projections to the same pattern) share a slot. Before looking up
+  abstract state IDs, a heuristic announces the evaluated state with
+  set_state(). Each slot then computes its abstract state ID at most once
+  per state, even if several heuristics (e.g., in a max evaluator) ask for
+  it.
+
+  Besides the cost partitioning heuristics, the PDB heuristics (cpdbs and
+  zopdbs) register projection functions for their PDBs, so that all of them
+  rank a state only once per pattern.
+
+  Heuristics give back their slots when they are destroyed. We free an
+  abstraction function once no heuristic uses its slot anymore and reuse
+  the slot later. Otherwise, the registry would accumulate the abstraction
+  functions of all heuristics ever created for the task, e.g., across the
+  iterations of an iterated search.
+*/
+class AbstractionRegistry {
+    AbstractionFunctions abstraction_functions;
+    std::vector<std::vector<int>> keys;
+    std::vector<int> num_users;
+    std::vector<int> free_slots;
+    utils::HashMap<std::vector<int>, int> slots_by_key;
+    int num_shared_functions;
+
+    // Cached abstract state IDs for the current state.
+    std::vector<int> abstract_state_ids;
+    std::vector<uint32_t> timestamps;
+    uint32_t current_timestamp;
+    const StateRegistry *current_state_registry;
+    StateID current_state_id;
+    const State *current_state;
+
+    int compute_abstract_state_id(int slot) const;
+
+public:
+    explicit AbstractionRegistry(const TaskProxy &task_proxy);
+    ~AbstractionRegistry();
+
+    /*
+      Take ownership of the given abstraction functions and return their
+      slots. Null pointers (unneeded abstractions) get slot -1.
+    */
+    std::vector<int> add_abstraction_functions(
+        AbstractionFunctions &&functions);
+
+    // Give back slots obtained from add_abstraction_functions().
+    void remove_abstraction_functions(const std::vector<int> &slots);
+
+    /*
+      Announce the state for which the next lookups are made. We use the
+      ancestor state for recognizing that another heuristic already
+      evaluated the same state and the (converted) state for computing
+      abstract state IDs. The state must outlive all following lookups.
+    */
+    void set_state(const State &ancestor_state, const State &state);
+
+    int get_abstract_state_id(int slot) {
+        if (timestamps[slot] != current_timestamp) {
+            abstract_state_ids[slot] = compute_abstract_state_id(slot);
+            timestamps[slot] = current_timestamp;
+        }
+        return abstract_state_ids[slot];
+    }
+
+    // Return the abstract state ID for each slot (-1 for slot -1).
+    std::vector<int> get_abstract_state_ids(const std::vector<int> &slots);
+
+    int get_num_functions() const {
+        return abstraction_functions.size() - free_slots.size();
+    }
+    int get_num_shared_functions() const {
+        return num_shared_functions;
+    }
+};
+
+extern PerTaskInformation<AbstractionRegistry> g_abstraction_registries;
+}
+
+#endif
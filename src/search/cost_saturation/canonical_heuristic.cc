@@ -9,6 +9,7 @@
 #include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 
 using namespace std;
 
@@ -54,8 +55,8 @@ static MaxAdditiveSubsets compute_max_additive_subsets(
 
 CanonicalHeuristic::CanonicalHeuristic(
     const vector<shared_ptr<AbstractionGenerator>> &abstraction_generators,
-    const shared_ptr<AbstractTask> &transform, bool cache_estimates,
-    const string &description, utils::Verbosity verbosity)
+    int num_threads, const shared_ptr<AbstractTask> &transform,
+    bool cache_estimates, const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity) {
     vector<int> costs = task_properties::get_operator_costs(task_proxy);
 
@@ -63,10 +64,8 @@ CanonicalHeuristic::CanonicalHeuristic(
         generate_abstractions(task, abstraction_generators);
 
     utils::g_log << "Compute abstract goal distances" << endl;
-    for (const auto &abstraction : abstractions) {
-        h_values_by_abstraction.push_back(
-            abstraction->compute_goal_distances(costs));
-    }
+    h_values_by_abstraction = compute_goal_distances_for_abstractions(
+        abstractions, costs, num_threads);
 
     utils::g_log << "Compute max additive subsets" << endl;
     max_additive_subsets = compute_max_additive_subsets(abstractions);
@@ -117,12 +116,14 @@ public:
         document_synopsis("Shuffle abstractions randomly.");
         add_options_for_cost_partitioning_heuristic(
             *this, "canonical_heuristic");
+        utils::add_parallel_options_to_feature(*this);
     }
 
     virtual shared_ptr<CanonicalHeuristic> create_component(
         const plugins::Options &options) const override {
         return plugins::make_shared_from_arg_tuples<CanonicalHeuristic>(
             options.get_list<shared_ptr<AbstractionGenerator>>("abstractions"),
+            utils::get_parallel_arguments_from_options(options),
             get_heuristic_arguments_from_options(options));
     }
 };
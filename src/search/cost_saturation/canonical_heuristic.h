@@ -25,8 +25,9 @@ public:
     CanonicalHeuristic(
         const std::vector<std::shared_ptr<AbstractionGenerator>>
             &abstraction_generators,
-        const std::shared_ptr<AbstractTask> &transform, bool cache_estimates,
-        const std::string &description, utils::Verbosity verbosity);
+        int num_threads, const std::shared_ptr<AbstractTask> &transform,
+        bool cache_estimates, const std::string &description,
+        utils::Verbosity verbosity);
 };
 }
 
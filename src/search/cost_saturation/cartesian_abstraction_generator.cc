@@ -20,30 +20,31 @@
 using namespace std;
 
 namespace cost_saturation {
-static vector<vector<Successor>> get_backward_graph(
+static BackwardGraph get_backward_graph(
     const cartesian_abstractions::Abstraction &cartesian_abstraction,
     const vector<int> &h_values) {
     // Retrieve non-looping transitions.
-    vector<vector<Successor>> backward_graph(
-        cartesian_abstraction.get_num_states());
-    for (int target = 0; target < cartesian_abstraction.get_num_states();
-         ++target) {
-        // Prune transitions *to* unsolvable states.
-        if (h_values[target] == INF) {
-            continue;
-        }
-        for (const cartesian_abstractions::Transition &transition :
-             cartesian_abstraction.get_incoming_transitions(target)) {
-            int src = transition.target_id;
-            // Prune transitions *from* unsolvable states.
-            if (h_values[src] == INF) {
+    auto for_each_transition = [&](const TransitionCallback &callback) {
+        for (int target = 0; target < cartesian_abstraction.get_num_states();
+             ++target) {
+            // Prune transitions *to* unsolvable states.
+            if (h_values[target] == INF) {
                 continue;
             }
-            backward_graph[target].emplace_back(transition.op_id, src);
+            for (const cartesian_abstractions::Transition &transition :
+                 cartesian_abstraction.get_incoming_transitions(target)) {
+                int src = transition.target_id;
+                // Prune transitions *from* unsolvable states.
+                if (h_values[src] == INF) {
+                    continue;
+                }
+                callback(Transition(src, transition.op_id, target));
+            }
         }
-        backward_graph[target].shrink_to_fit();
-    }
-    return backward_graph;
+    };
+    return BackwardGraph(
+        cartesian_abstraction.get_num_states(),
+        cartesian_abstraction.get_num_operators(), for_each_transition);
 }
 
 CartesianAbstractionGenerator::CartesianAbstractionGenerator(
@@ -89,6 +90,7 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
     log << "Build abstractions for " << subtasks.size() << " subtasks in "
         << timer.get_remaining_time() << endl;
     int remaining_subtasks = subtasks.size();
+    cartesian_abstractions::MemoryLimit memory_limit;
     for (const shared_ptr<AbstractTask> &subtask : subtasks) {
         cartesian_abstractions::CEGAR cegar(
             subtask,
@@ -99,7 +101,8 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
             timer.get_remaining_time() / remaining_subtasks,
             pick_flawed_abstract_state, pick_split, tiebreak_split,
             max_concrete_states_per_abstract_state, max_state_expansions,
-            transition_representation, *rng, log, dot_graph_verbosity);
+            transition_representation, memory_limit, *rng, log,
+            dot_graph_verbosity);
         cout << endl;
         auto cartesian_abstraction = cegar.extract_abstraction();
         // If the timer expired, the goal distances might only be lower bounds.
@@ -119,14 +122,19 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
         unique_ptr<Abstraction> abstraction;
         if (transition_representation ==
             cartesian_abstractions::TransitionRepresentation::STORE) {
-            auto backward_graph =
+            BackwardGraph backward_graph =
                 get_backward_graph(*cartesian_abstraction, goal_distances);
-            for (const auto &transitions : backward_graph) {
-                num_transitions += transitions.size();
-            }
+            num_transitions += backward_graph.get_num_transitions();
+            /* The explicit abstraction only needs the hierarchy for looking
+               up abstract states. (In contrast, CartesianAbstraction keeps
+               using it for computing transitions on the fly.) */
+            unique_ptr<cartesian_abstractions::RefinementHierarchy>
+                refinement_hierarchy =
+                    cartesian_abstraction->extract_refinement_hierarchy();
+            refinement_hierarchy->compile_to_decision_diagram();
             abstraction = make_unique<ExplicitAbstraction>(
                 make_unique<CartesianAbstractionFunction>(
-                    cartesian_abstraction->extract_refinement_hierarchy()),
+                    move(refinement_hierarchy)),
                 move(backward_graph),
                 cartesian_abstraction->get_looping_operators(),
                 vector<int>(
@@ -159,7 +167,7 @@ Abstractions CartesianAbstractionGenerator::generate_abstractions(
     Abstractions abstractions;
     for (const auto &subtask_generator : subtask_generators) {
         cartesian_abstractions::SharedTasks subtasks =
-            subtask_generator->get_subtasks(task, log);
+            subtask_generator->get_subtasks(task, nullptr, log);
         build_abstractions_for_subtasks(subtasks, timer, abstractions);
         if (has_reached_resource_limit(timer)) {
             break;
@@ -21,6 +21,8 @@ class CostPartitioningHeuristic {
     // Allow this class to extract and compress information about unsolvable
     // states.
     friend class UnsolvabilityHeuristic;
+    // Allow this class to evaluate lookup tables for many states at once.
+    friend class Diversifier;
 
     struct LookupTable {
         int abstraction_id;
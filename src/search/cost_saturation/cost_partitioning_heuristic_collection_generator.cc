@@ -18,39 +18,47 @@
 using namespace std;
 
 namespace cost_saturation {
-static vector<vector<int>> sample_states_and_return_abstract_state_ids(
+static void sample_states(
     const TaskProxy &task_proxy, const Abstractions &abstractions,
     const sampling::RandomWalkSampler &sampler, int num_samples, int init_h,
-    const DeadEndDetector &is_dead_end, double max_sampling_time) {
+    const DeadEndDetector &is_dead_end, double max_sampling_time,
+    utils::RandomNumberGenerator &rng, Diversifier &diversifier) {
     assert(num_samples >= 1);
     utils::CountdownTimer sampling_timer(max_sampling_time);
     utils::g_log << "Start sampling" << endl;
-    vector<vector<int>> abstract_state_ids_by_sample;
-    abstract_state_ids_by_sample.push_back(
-        get_abstract_state_ids(abstractions, task_proxy.get_initial_state()));
-    while (static_cast<int>(abstract_state_ids_by_sample.size()) <
-               num_samples &&
+    diversifier.add_sample(
+        get_abstract_state_ids(abstractions, task_proxy.get_initial_state()),
+        rng);
+    while (diversifier.get_num_added_samples() < num_samples &&
            !sampling_timer.is_expired()) {
-        abstract_state_ids_by_sample.push_back(get_abstract_state_ids(
-            abstractions, sampler.sample_state(init_h, is_dead_end)));
+        diversifier.add_sample(
+            get_abstract_state_ids(
+                abstractions, sampler.sample_state(init_h, is_dead_end)),
+            rng);
     }
-    utils::g_log << "Samples: " << abstract_state_ids_by_sample.size() << endl;
+    utils::g_log << "Samples: " << diversifier.get_num_added_samples() << endl;
+    if (diversifier.get_num_samples() < diversifier.get_num_added_samples()) {
+        utils::g_log << "Stored samples: " << diversifier.get_num_samples()
+                     << endl;
+    }
+    utils::g_log << "Sample storage: " << diversifier.estimate_size_in_kb()
+                 << " KiB" << endl;
     utils::g_log << "Sampling time: " << sampling_timer.get_elapsed_time()
                  << endl;
-    return abstract_state_ids_by_sample;
 }
 
 CostPartitioningHeuristicCollectionGenerator::
     CostPartitioningHeuristicCollectionGenerator(
         const shared_ptr<OrderGenerator> &order_generator, int max_orders,
         int max_size_kb, double max_time, bool diversify, int num_samples,
-        double max_optimization_time, int random_seed)
+        int max_stored_samples, double max_optimization_time, int random_seed)
     : order_generator(order_generator),
       max_orders(max_orders),
       max_size_kb(max_size_kb),
       max_time(max_time),
       diversify(diversify),
       num_samples(num_samples),
+      max_stored_samples(max_stored_samples),
       max_optimization_time(max_optimization_time),
       rng(utils::get_rng(random_seed)) {
     if (max_orders == INF && max_size_kb == INF &&
@@ -79,7 +87,7 @@ CostPartitioningHeuristicCollectionGenerator::generate_cost_partitionings(
     vector<int> remaining_costs = costs;
     CostPartitioningHeuristic cp_for_init = cp_function(
         abstractions, order_for_init, remaining_costs,
-        abstract_state_ids_for_init);
+        abstract_state_ids_for_init, nullptr);
     int init_h = cp_for_init.compute_heuristic(abstract_state_ids_for_init);
 
     if (init_h == INF) {
@@ -98,9 +106,10 @@ CostPartitioningHeuristicCollectionGenerator::generate_cost_partitionings(
     if (diversify) {
         double max_sampling_time = timer.get_remaining_time();
         diversifier = make_unique<Diversifier>(
-            sample_states_and_return_abstract_state_ids(
-                task_proxy, abstractions, sampler, num_samples, init_h,
-                is_dead_end, max_sampling_time));
+            abstractions, min(num_samples, max_stored_samples));
+        sample_states(
+            task_proxy, abstractions, sampler, num_samples, init_h,
+            is_dead_end, max_sampling_time, *rng, *diversifier);
     }
 
     log << "Start computing cost partitionings" << endl;
@@ -127,7 +136,8 @@ CostPartitioningHeuristicCollectionGenerator::generate_cost_partitionings(
                 abstract_state_ids, false);
             remaining_costs = costs;
             cp_heuristic = cp_function(
-                abstractions, order, remaining_costs, abstract_state_ids);
+                abstractions, order, remaining_costs, abstract_state_ids,
+                nullptr);
         }
 
         // Optimize order.
@@ -153,7 +163,8 @@ CostPartitioningHeuristicCollectionGenerator::generate_cost_partitionings(
             size_kb += cp_heuristic.estimate_size_in_kb();
             cp_heuristics.push_back(move(cp_heuristic));
             if (diversifier) {
-                log << "Average finite h-value for " << num_samples
+                log << "Average finite h-value for "
+                    << diversifier->get_num_samples()
                     << " samples after " << timer.get_elapsed_time()
                     << " of diversification: "
                     << diversifier->compute_avg_finite_sample_h_value() << endl;
@@ -23,6 +23,7 @@ class CostPartitioningHeuristicCollectionGenerator {
     const double max_time;
     const bool diversify;
     const int num_samples;
+    const int max_stored_samples;
     const double max_optimization_time;
     const std::shared_ptr<utils::RandomNumberGenerator> rng;
 
@@ -30,7 +31,8 @@ public:
     CostPartitioningHeuristicCollectionGenerator(
         const std::shared_ptr<OrderGenerator> &order_generator, int max_orders,
         int max_size_kb, double max_time, bool diversify, int num_samples,
-        double max_optimization_time, int random_seed);
+        int max_stored_samples, double max_optimization_time,
+        int random_seed);
 
     std::vector<CostPartitioningHeuristic> generate_cost_partitionings(
         const TaskProxy &task_proxy, const Abstractions &abstractions,
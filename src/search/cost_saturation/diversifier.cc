@@ -1,26 +1,138 @@
 #include "diversifier.h"
 
+#include "abstraction.h"
 #include "cost_partitioning_heuristic.h"
 
 #include "../utils/collections.h"
+#include "../utils/rng.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 using namespace std;
 
 namespace cost_saturation {
-Diversifier::Diversifier(vector<vector<int>> &&abstract_state_ids_by_sample)
-    : abstract_state_ids_by_sample(move(abstract_state_ids_by_sample)),
-      // Initialize with -1 to ensure that first cost partitioning is diverse.
-      portfolio_h_values(this->abstract_state_ids_by_sample.size(), -1) {
+static bool all_abstract_state_ids_fit_into_16_bits(
+    const Abstractions &abstractions) {
+    return all_of(
+        abstractions.begin(), abstractions.end(),
+        [](const unique_ptr<Abstraction> &abstraction) {
+            return abstraction->get_num_states() <=
+                   numeric_limits<uint16_t>::max() + 1;
+        });
+}
+
+/*
+  Change the number of entries reserved per abstraction from old_stride to
+  new_stride and move the IDs of the first num_samples samples accordingly.
+*/
+template<typename Id>
+static void change_stride(
+    vector<Id> &ids, int num_abstractions, int old_stride, int new_stride,
+    int num_samples) {
+    vector<Id> new_ids(static_cast<size_t>(num_abstractions) * new_stride);
+    for (int abstraction_id = 0; abstraction_id < num_abstractions;
+         ++abstraction_id) {
+        auto old_column =
+            ids.begin() + static_cast<size_t>(abstraction_id) * old_stride;
+        copy(
+            old_column, old_column + num_samples,
+            new_ids.begin() + static_cast<size_t>(abstraction_id) * new_stride);
+    }
+    ids.swap(new_ids);
+}
+
+Diversifier::Diversifier(const Abstractions &abstractions, int capacity)
+    : num_abstractions(abstractions.size()),
+      capacity(capacity),
+      use_narrow_ids(all_abstract_state_ids_fit_into_16_bits(abstractions)),
+      num_stored_samples(0),
+      num_added_samples(0) {
+    assert(capacity >= 1);
+}
+
+template<typename Id>
+void Diversifier::store_sample(
+    vector<Id> &ids, int slot, const vector<int> &abstract_state_ids) {
+    assert(static_cast<int>(abstract_state_ids.size()) == num_abstractions);
+    int stride = sample_h_values.size();
+    if (slot == stride) {
+        // Grow geometrically to avoid moving the samples too often. All
+        // slots before the new one are occupied.
+        int new_stride =
+            (stride > capacity / 2) ? capacity : max(1, 2 * stride);
+        change_stride(ids, num_abstractions, stride, new_stride, slot);
+        sample_h_values.resize(new_stride);
+        stride = new_stride;
+    }
+    assert(slot < stride);
+    for (int abstraction_id = 0; abstraction_id < num_abstractions;
+         ++abstraction_id) {
+        int state_id = abstract_state_ids[abstraction_id];
+        assert(state_id >= 0);
+        ids[static_cast<size_t>(abstraction_id) * stride + slot] =
+            static_cast<Id>(state_id);
+    }
+}
+
+void Diversifier::add_sample(
+    const vector<int> &abstract_state_ids, utils::RandomNumberGenerator &rng) {
+    ++num_added_samples;
+    int slot;
+    if (num_stored_samples < capacity) {
+        slot = num_stored_samples++;
+        // Initialize with -1 to ensure that first cost partitioning is diverse.
+        portfolio_h_values.push_back(-1);
+    } else {
+        // Reservoir sampling: keep each added sample with equal probability.
+        slot = rng.random(num_added_samples);
+        if (slot >= capacity) {
+            return;
+        }
+        portfolio_h_values[slot] = -1;
+    }
+    if (use_narrow_ids) {
+        store_sample(narrow_ids, slot, abstract_state_ids);
+    } else {
+        store_sample(wide_ids, slot, abstract_state_ids);
+    }
+}
+
+int Diversifier::get_num_samples() const {
+    return num_stored_samples;
+}
+
+int Diversifier::get_num_added_samples() const {
+    return num_added_samples;
+}
+
+template<typename Id>
+void Diversifier::compute_sample_h_values(
+    const vector<Id> &ids, const CostPartitioningHeuristic &cp_heuristic) {
+    size_t stride = sample_h_values.size();
+    fill(sample_h_values.begin(), sample_h_values.end(), 0);
+    for (const auto &lookup_table : cp_heuristic.lookup_tables) {
+        const vector<int> &h_values = lookup_table.h_values;
+        const Id *column = ids.data() + lookup_table.abstraction_id * stride;
+        for (int sample_id = 0; sample_id < num_stored_samples; ++sample_id) {
+            assert(utils::in_bounds(column[sample_id], h_values));
+            int h = h_values[column[sample_id]];
+            int &sum = sample_h_values[sample_id];
+            sum = (sum == INF || h == INF) ? INF : sum + h;
+        }
+    }
 }
 
 bool Diversifier::is_diverse(const CostPartitioningHeuristic &cp_heuristic) {
+    if (use_narrow_ids) {
+        compute_sample_h_values(narrow_ids, cp_heuristic);
+    } else {
+        compute_sample_h_values(wide_ids, cp_heuristic);
+    }
     bool cp_improves_portfolio = false;
-    int num_samples = abstract_state_ids_by_sample.size();
-    for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-        int cp_h_value = cp_heuristic.compute_heuristic(
-            abstract_state_ids_by_sample[sample_id]);
+    for (int sample_id = 0; sample_id < num_stored_samples; ++sample_id) {
+        int cp_h_value = sample_h_values[sample_id];
         assert(utils::in_bounds(sample_id, portfolio_h_values));
         int &portfolio_h_value = portfolio_h_values[sample_id];
         if (cp_h_value > portfolio_h_value) {
@@ -45,4 +157,12 @@ float Diversifier::compute_avg_finite_sample_h_value() const {
     }
     return sum_h / num_finite_values;
 }
+
+int Diversifier::estimate_size_in_kb() const {
+    size_t num_bytes = narrow_ids.capacity() * sizeof(uint16_t) +
+                       wide_ids.capacity() * sizeof(int) +
+                       portfolio_h_values.capacity() * sizeof(int) +
+                       sample_h_values.capacity() * sizeof(int);
+    return num_bytes / 1024;
+}
 }
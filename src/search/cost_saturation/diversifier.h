@@ -3,22 +3,67 @@
 
 #include "types.h"
 
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+class RandomNumberGenerator;
+}
+
 namespace cost_saturation {
 class CostPartitioningHeuristic;
 
+/*
+  Store the abstract state IDs of a set of sample states and keep only
+  cost partitionings that improve the heuristic value of at least one sample.
+
+  The abstract state IDs are stored column-major in a single allocation, i.e.,
+  the IDs of all samples for abstraction 0 come first, followed by those for
+  abstraction 1, etc. If all abstractions have at most 2^16 states, we store
+  the IDs as 16-bit integers. This layout allows us to evaluate a cost
+  partitioning one lookup table at a time over all samples.
+
+  Samples are added one by one. Once the capacity is reached, we use
+  reservoir sampling to decide whether a new sample replaces a stored one, so
+  that the stored samples are a uniform subset of all added samples.
+*/
 class Diversifier {
-    std::vector<std::vector<int>> abstract_state_ids_by_sample;
+    const int num_abstractions;
+    const int capacity;
+    const bool use_narrow_ids;
+    std::vector<uint16_t> narrow_ids;
+    std::vector<int> wide_ids;
+    int num_stored_samples;
+    int num_added_samples;
     std::vector<int> portfolio_h_values;
+    std::vector<int> sample_h_values;
+
+    template<typename Id>
+    void store_sample(
+        std::vector<Id> &ids, int slot,
+        const std::vector<int> &abstract_state_ids);
+    template<typename Id>
+    void compute_sample_h_values(
+        const std::vector<Id> &ids,
+        const CostPartitioningHeuristic &cp_heuristic);
 
 public:
-    explicit Diversifier(
-        std::vector<std::vector<int>> &&abstract_state_ids_by_sample);
+    Diversifier(const Abstractions &abstractions, int capacity);
+
+    void add_sample(
+        const std::vector<int> &abstract_state_ids,
+        utils::RandomNumberGenerator &rng);
+
+    int get_num_samples() const;
+    int get_num_added_samples() const;
 
     /* Return true iff the cost-partitioned heuristic has a higher heuristic
        value than all previously seen heuristics for at least one sample. */
     bool is_diverse(const CostPartitioningHeuristic &cp_heuristic);
 
     float compute_avg_finite_sample_h_value() const;
+
+    int estimate_size_in_kb() const;
 };
 }
 
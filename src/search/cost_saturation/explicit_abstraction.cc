@@ -2,14 +2,58 @@
 
 #include "types.h"
 
+#include "../algorithms/priority_queues.h"
 #include "../utils/collections.h"
 #include "../utils/strings.h"
+#include "../utils/system.h"
+
+#include <limits>
+#include <numeric>
 
 using namespace std;
 
 namespace cost_saturation {
+BackwardGraph::BackwardGraph(
+    int num_states, int num_operators,
+    const function<void(const TransitionCallback &)> &for_each_transition)
+    : offsets(num_states + 1, 0) {
+    // First pass: count the transitions per target and compute offsets.
+    int64_t num_transitions = 0;
+    for_each_transition([&](const Transition &transition) {
+        ++offsets[transition.target + 1];
+        ++num_transitions;
+    });
+    if (num_transitions >= numeric_limits<int>::max()) {
+        cerr << "Too many transitions for explicit abstraction." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Second pass: insert transitions at the next free position.
+    bool use_short_ops =
+        num_operators <= numeric_limits<uint16_t>::max() + 1;
+    sources.resize(num_transitions);
+    if (use_short_ops) {
+        short_ops.resize(num_transitions);
+    } else {
+        ops.resize(num_transitions);
+    }
+    vector<int> next_position(offsets.begin(), offsets.end() - 1);
+    for_each_transition([&](const Transition &transition) {
+        assert(transition.op >= 0 && transition.op < num_operators);
+        int pos = next_position[transition.target]++;
+        assert(pos < offsets[transition.target + 1]);
+        sources[pos] = transition.src;
+        if (use_short_ops) {
+            short_ops[pos] = static_cast<uint16_t>(transition.op);
+        } else {
+            ops[pos] = transition.op;
+        }
+    });
+}
+
 static void dijkstra_search(
-    const vector<vector<Successor>> &graph, const vector<int> &costs,
+    const BackwardGraph &graph, const vector<int> &costs,
     priority_queues::AdaptiveQueue<int> &queue, vector<int> &distances) {
     assert(all_of(costs.begin(), costs.end(), [](int c) { return c >= 0; }));
     while (!queue.empty()) {
@@ -21,45 +65,39 @@ static void dijkstra_search(
         if (state_distance < distance) {
             continue;
         }
-        for (const Successor &transition : graph[state]) {
-            int successor = transition.state;
-            int op = transition.op;
-            assert(utils::in_bounds(op, costs));
-            int cost = costs[op];
-            assert(cost >= 0);
-            int successor_distance =
-                (cost == INF) ? INF : state_distance + cost;
-            assert(successor_distance >= 0);
-            if (distances[successor] > successor_distance) {
-                distances[successor] = successor_distance;
-                queue.push(successor_distance, successor);
-            }
-        }
+        graph.for_each_incoming_transition(
+            state, [&](int op, int successor) {
+                assert(utils::in_bounds(op, costs));
+                int cost = costs[op];
+                assert(cost >= 0);
+                int successor_distance =
+                    (cost == INF) ? INF : state_distance + cost;
+                assert(successor_distance >= 0);
+                if (distances[successor] > successor_distance) {
+                    distances[successor] = successor_distance;
+                    queue.push(successor_distance, successor);
+                }
+            });
     }
 }
 
-ostream &operator<<(ostream &os, const Successor &successor) {
-    os << "(" << successor.op << ", " << successor.state << ")";
-    return os;
-}
-
 static vector<bool> get_active_operators_from_graph(
-    const vector<vector<Successor>> &backward_graph, int num_ops) {
+    const BackwardGraph &backward_graph, int num_ops) {
     vector<bool> active_operators(num_ops, false);
-    int num_states = backward_graph.size();
+    int num_states = backward_graph.get_num_states();
     for (int target = 0; target < num_states; ++target) {
-        for (const Successor &transition : backward_graph[target]) {
-            int op_id = transition.op;
-            active_operators[op_id] = true;
-        }
+        backward_graph.for_each_incoming_transition(
+            target, [&active_operators](int op_id, int) {
+                active_operators[op_id] = true;
+            });
     }
     return active_operators;
 }
 
 ExplicitAbstraction::ExplicitAbstraction(
     unique_ptr<AbstractionFunction> abstraction_function,
-    vector<vector<Successor>> &&backward_graph_,
-    vector<bool> &&looping_operators, vector<int> &&goal_states)
+    BackwardGraph &&backward_graph_, vector<bool> &&looping_operators,
+    vector<int> &&goal_states)
     : Abstraction(move(abstraction_function)),
       backward_graph(move(backward_graph_)),
       active_operators(get_active_operators_from_graph(
@@ -69,19 +107,27 @@ ExplicitAbstraction::ExplicitAbstraction(
 #ifndef NDEBUG
     for (int target = 0; target < get_num_states(); ++target) {
         // Check that no transition is stored multiple times.
-        vector<Successor> copied_transitions = this->backward_graph[target];
+        vector<pair<int, int>> copied_transitions;
+        this->backward_graph.for_each_incoming_transition(
+            target, [&copied_transitions](int op_id, int src) {
+                copied_transitions.emplace_back(op_id, src);
+            });
         sort(copied_transitions.begin(), copied_transitions.end());
         assert(utils::is_sorted_unique(copied_transitions));
         // Check that we don't store self-loops.
         assert(all_of(
             copied_transitions.begin(), copied_transitions.end(),
-            [target](const Successor &succ) { return succ.state != target; }));
+            [target](const pair<int, int> &transition) {
+                return transition.second != target;
+            }));
     }
 #endif
 }
 
 vector<int> ExplicitAbstraction::compute_goal_distances(
     const vector<int> &costs) const {
+    // Reuse the queue between calls, but keep it separate for each thread.
+    static thread_local priority_queues::AdaptiveQueue<int> queue;
     vector<int> goal_distances(get_num_states(), INF);
     queue.clear();
     for (int goal_state : goal_states) {
@@ -105,7 +151,7 @@ vector<int> ExplicitAbstraction::compute_saturated_costs(
         }
     }
 
-    int num_states = backward_graph.size();
+    int num_states = backward_graph.get_num_states();
     for (int target = 0; target < num_states; ++target) {
         assert(utils::in_bounds(target, h_values));
         int target_h = h_values[target];
@@ -113,18 +159,16 @@ vector<int> ExplicitAbstraction::compute_saturated_costs(
             continue;
         }
 
-        for (const Successor &transition : backward_graph[target]) {
-            int op_id = transition.op;
-            int src = transition.state;
-            assert(utils::in_bounds(src, h_values));
-            int src_h = h_values[src];
-            if (src_h == INF) {
-                continue;
-            }
-
-            const int needed = src_h - target_h;
-            saturated_costs[op_id] = max(saturated_costs[op_id], needed);
-        }
+        backward_graph.for_each_incoming_transition(
+            target, [&](int op_id, int src) {
+                assert(utils::in_bounds(src, h_values));
+                int src_h = h_values[src];
+                if (src_h == INF) {
+                    return;
+                }
+                const int needed = src_h - target_h;
+                saturated_costs[op_id] = max(saturated_costs[op_id], needed);
+            });
     }
     return saturated_costs;
 }
@@ -134,7 +178,7 @@ int ExplicitAbstraction::get_num_operators() const {
 }
 
 int ExplicitAbstraction::get_num_states() const {
-    return backward_graph.size();
+    return backward_graph.get_num_states();
 }
 
 bool ExplicitAbstraction::operator_is_active(int op_id) const {
@@ -149,11 +193,10 @@ void ExplicitAbstraction::for_each_transition(
     const TransitionCallback &callback) const {
     int num_states = get_num_states();
     for (int target = 0; target < num_states; ++target) {
-        for (const Successor &transition : backward_graph[target]) {
-            int op_id = transition.op;
-            int src = transition.state;
-            callback(Transition(src, op_id, target));
-        }
+        backward_graph.for_each_incoming_transition(
+            target, [&callback, target](int op_id, int src) {
+                callback(Transition(src, op_id, target));
+            });
     }
 }
 
@@ -186,10 +229,10 @@ void ExplicitAbstraction::dump() const {
     }
     for (int target = 0; target < num_states; ++target) {
         unordered_map<int, vector<int>> parallel_transitions;
-        for (const Successor &succ : backward_graph[target]) {
-            int src = succ.state;
-            parallel_transitions[src].push_back(succ.op);
-        }
+        backward_graph.for_each_incoming_transition(
+            target, [&parallel_transitions](int op_id, int src) {
+                parallel_transitions[src].push_back(op_id);
+            });
         for (const auto &pair : parallel_transitions) {
             int src = pair.first;
             const vector<int> &operators = pair.second;
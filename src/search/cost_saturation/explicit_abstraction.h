@@ -3,35 +3,76 @@
 
 #include "abstraction.h"
 
-#include "../algorithms/priority_queues.h"
-
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <utility>
 #include <vector>
 
 namespace cost_saturation {
-struct Successor {
-    int op;
-    int state;
+/*
+  Store the state-changing transitions of an explicit abstraction
+  backwards in compressed sparse row format: the transitions ending in
+  state s are stored at positions [offsets[s], offsets[s + 1]) of the
+  arrays for operators and source states. If the task has at most 2^16
+  operators, we store operator IDs with 16 bits.
+
+  The constructor never materializes a list of all transitions. Instead,
+  it enumerates the transitions twice: the first pass counts the
+  transitions per target state and computes the offsets, the second pass
+  fills the arrays.
+*/
+class BackwardGraph {
+    std::vector<int> offsets;
+    std::vector<int> sources;
+    std::vector<uint16_t> short_ops;
+    std::vector<int> ops;
+
+    template<typename Op, typename Callback>
+    static void for_each_transition_in_range(
+        const std::vector<Op> &ops, const std::vector<int> &sources, int begin,
+        int end, const Callback &callback) {
+        for (int i = begin; i < end; ++i) {
+            callback(static_cast<int>(ops[i]), sources[i]);
+        }
+    }
 
-    Successor(int op, int state) : op(op), state(state) {
+public:
+    /*
+      for_each_transition(callback) must call callback for each transition.
+      It is called twice and must report the transitions in the same order
+      both times.
+    */
+    BackwardGraph(
+        int num_states, int num_operators,
+        const std::function<void(const TransitionCallback &)>
+            &for_each_transition);
+
+    int get_num_states() const {
+        return offsets.size() - 1;
     }
 
-    bool operator<(const Successor &other) const {
-        return std::make_pair(op, state) <
-               std::make_pair(other.op, other.state);
+    int get_num_transitions() const {
+        return sources.size();
     }
 
-    bool operator>=(const Successor &other) const {
-        return !(*this < other);
+    // Call callback(op_id, src) for each transition ending in target.
+    template<typename Callback>
+    void for_each_incoming_transition(
+        int target, const Callback &callback) const {
+        int begin = offsets[target];
+        int end = offsets[target + 1];
+        if (ops.empty()) {
+            for_each_transition_in_range(
+                short_ops, sources, begin, end, callback);
+        } else {
+            for_each_transition_in_range(ops, sources, begin, end, callback);
+        }
     }
 };
 
-std::ostream &operator<<(std::ostream &os, const Successor &successor);
-
 class ExplicitAbstraction : public Abstraction {
     // State-changing transitions.
-    std::vector<std::vector<Successor>> backward_graph;
+    BackwardGraph backward_graph;
 
     // Operators inducing state-changing transitions.
     std::vector<bool> active_operators;
@@ -41,12 +82,10 @@ class ExplicitAbstraction : public Abstraction {
 
     std::vector<int> goal_states;
 
-    mutable priority_queues::AdaptiveQueue<int> queue;
-
 public:
     ExplicitAbstraction(
         std::unique_ptr<AbstractionFunction> abstraction_function,
-        std::vector<std::vector<Successor>> &&backward_graph,
+        BackwardGraph &&backward_graph,
         std::vector<bool> &&looping_operators, std::vector<int> &&goal_states);
 
     virtual std::vector<int> compute_goal_distances(
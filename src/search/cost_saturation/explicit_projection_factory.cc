@@ -93,7 +93,6 @@ ExplicitProjectionFactory::ExplicitProjectionFactory(
         }
     }
 
-    compute_transitions();
     goal_states = rank_goal_states();
 }
 
@@ -201,7 +200,8 @@ bool ExplicitProjectionFactory::conditions_are_satisfied(
 }
 
 void ExplicitProjectionFactory::add_transition(
-    int src_rank, int op_id, const UnrankedState &dest_values, bool debug) {
+    int src_rank, int op_id, const UnrankedState &dest_values,
+    const TransitionCallback &callback, bool debug) {
     int dest_rank = rank(dest_values);
     if (debug) {
         cout << "Add transition from " << src_rank << " to " << dest_rank
@@ -210,13 +210,14 @@ void ExplicitProjectionFactory::add_transition(
     if (dest_rank == src_rank) {
         looping_operators[op_id] = true;
     } else {
-        backward_graph[dest_rank].emplace_back(op_id, src_rank);
+        callback(Transition(src_rank, op_id, dest_rank));
     }
 }
 
 void ExplicitProjectionFactory::add_transitions(
     const UnrankedState &src_values, int op_id,
-    const vector<ProjectedEffect> &effects) {
+    const vector<ProjectedEffect> &effects,
+    const TransitionCallback &callback) {
     const bool debug = false;
     int src_rank = rank(src_values);
     UnrankedState base_dest_values = src_values;
@@ -301,7 +302,7 @@ void ExplicitProjectionFactory::add_transitions(
 
     // Handle the case where all effects always trigger in this state.
     if (possible_effects.empty()) {
-        add_transition(src_rank, op_id, base_dest_values);
+        add_transition(src_rank, op_id, base_dest_values, callback);
         return;
     }
 
@@ -331,7 +332,7 @@ void ExplicitProjectionFactory::add_transitions(
                 dest_values[fact.var] = fact.value;
             }
         }
-        add_transition(src_rank, op_id, dest_values, debug);
+        add_transition(src_rank, op_id, dest_values, callback, debug);
 
         // Increment the "counter" by 1.
         ++iterators[k - 1];
@@ -343,8 +344,8 @@ void ExplicitProjectionFactory::add_transitions(
     }
 }
 
-void ExplicitProjectionFactory::compute_transitions() {
-    backward_graph.resize(num_states);
+void ExplicitProjectionFactory::compute_transitions(
+    const TransitionCallback &callback) {
     for (OperatorProxy op : task_proxy.get_operators()) {
         int op_id = op.get_id();
         auto preconditions =
@@ -355,21 +356,18 @@ void ExplicitProjectionFactory::compute_transitions() {
             looping_operators[op_id] = true;
         } else {
             multiply_out(preconditions, [&](const UnrankedState &state) {
-                add_transitions(state, op_id, effects);
+                add_transitions(state, op_id, effects, callback);
             });
         }
     }
-
-#ifndef NDEBUG
-    for (const auto &transitions : backward_graph) {
-        vector<Successor> copied_transitions = transitions;
-        sort(copied_transitions.begin(), copied_transitions.end());
-        assert(utils::is_sorted_unique(copied_transitions));
-    }
-#endif
 }
 
 unique_ptr<Abstraction> ExplicitProjectionFactory::convert_to_abstraction() {
+    BackwardGraph backward_graph(
+        num_states, looping_operators.size(),
+        [this](const TransitionCallback &callback) {
+            compute_transitions(callback);
+        });
     return make_unique<ExplicitAbstraction>(
         make_unique<ProjectionFunction>(pattern, move(hash_multipliers)),
         move(backward_graph), move(looping_operators), move(goal_states));
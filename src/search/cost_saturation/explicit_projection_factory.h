@@ -20,7 +20,6 @@ class ExplicitProjectionFactory {
     std::vector<int> variable_to_pattern_index;
     std::vector<int> domain_sizes;
 
-    std::vector<std::vector<Successor>> backward_graph;
     std::vector<bool> looping_operators;
     std::vector<int> goal_states;
 
@@ -46,11 +45,13 @@ class ExplicitProjectionFactory {
         const UnrankedState &state_values) const;
     void add_transition(
         int src_rank, int op_id, const UnrankedState &dest_values,
-        bool debug = false);
+        const TransitionCallback &callback, bool debug = false);
     void add_transitions(
         const UnrankedState &src_values, int op_id,
-        const std::vector<ProjectedEffect> &effects);
-    void compute_transitions();
+        const std::vector<ProjectedEffect> &effects,
+        const TransitionCallback &callback);
+    // Report state-changing transitions and mark looping operators.
+    void compute_transitions(const TransitionCallback &callback);
 
     std::vector<int> rank_goal_states() const;
 
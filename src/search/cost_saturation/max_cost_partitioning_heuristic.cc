@@ -1,6 +1,7 @@
 #include "max_cost_partitioning_heuristic.h"
 
 #include "abstraction.h"
+#include "abstraction_registry.h"
 #include "cost_partitioning_heuristic.h"
 #include "utils.h"
 
@@ -50,6 +51,7 @@ MaxCostPartitioningHeuristic::MaxCostPartitioningHeuristic(
     const shared_ptr<AbstractTask> &transform, bool cache_estimates,
     const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity),
+      abstraction_registry(g_abstraction_registries[task_proxy]),
       cp_heuristics(move(cp_heuristics_)),
       dead_ends(move(dead_ends_)),
       unsolvability_heuristic(abstractions, cp_heuristics) {
@@ -57,13 +59,20 @@ MaxCostPartitioningHeuristic::MaxCostPartitioningHeuristic(
 
     // We only need abstraction functions during search and no transition
     // systems.
-    abstraction_functions =
+    abstraction_slots = abstraction_registry.add_abstraction_functions(
         extract_abstraction_functions_from_useful_abstractions(
-            cp_heuristics, &unsolvability_heuristic, abstractions);
+            cp_heuristics, &unsolvability_heuristic, abstractions));
+    if (log.is_at_least_normal()) {
+        log << "Abstraction registry: "
+            << abstraction_registry.get_num_functions() << " functions, "
+            << abstraction_registry.get_num_shared_functions()
+            << " shared registrations" << endl;
+    }
 }
 
 MaxCostPartitioningHeuristic::~MaxCostPartitioningHeuristic() {
     print_statistics();
+    abstraction_registry.remove_abstraction_functions(abstraction_slots);
 }
 
 int MaxCostPartitioningHeuristic::compute_heuristic(
@@ -75,8 +84,9 @@ int MaxCostPartitioningHeuristic::compute_heuristic(
     if (dead_ends && dead_ends->subsumes(state)) {
         return DEAD_END;
     }
+    abstraction_registry.set_state(ancestor_state, state);
     vector<int> abstract_state_ids =
-        get_abstract_state_ids(abstraction_functions, state);
+        abstraction_registry.get_abstract_state_ids(abstraction_slots);
     if (unsolvability_heuristic.is_unsolvable(abstract_state_ids)) {
         return DEAD_END;
     }
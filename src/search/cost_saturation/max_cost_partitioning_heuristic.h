@@ -10,14 +10,19 @@
 #include <vector>
 
 namespace cost_saturation {
-class AbstractionFunction;
+class AbstractionRegistry;
 class CostPartitioningHeuristic;
 
 /*
   Compute the maximum over multiple cost partitioning heuristics.
+
+  The abstraction functions live in the AbstractionRegistry of the task,
+  which shares them with other heuristics for the same task.
 */
 class MaxCostPartitioningHeuristic : public Heuristic {
-    std::vector<std::unique_ptr<AbstractionFunction>> abstraction_functions;
+    AbstractionRegistry &abstraction_registry;
+    // Slot in the registry for each abstraction (-1 for unneeded ones).
+    std::vector<int> abstraction_slots;
     std::vector<CostPartitioningHeuristic> cp_heuristics;
     std::unique_ptr<DeadEnds> dead_ends;
     UnsolvabilityHeuristic unsolvability_heuristic;
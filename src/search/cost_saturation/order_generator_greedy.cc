@@ -6,6 +6,7 @@
 #include "../plugins/plugin.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 
 #include <cassert>
@@ -15,8 +16,10 @@ using namespace std;
 
 namespace cost_saturation {
 OrderGeneratorGreedy::OrderGeneratorGreedy(
-    ScoringFunction scoring_function, int random_seed)
-    : OrderGenerator(random_seed), scoring_function(scoring_function) {
+    ScoringFunction scoring_function, int num_threads, int random_seed)
+    : OrderGenerator(random_seed),
+      scoring_function(scoring_function),
+      num_threads(num_threads) {
 }
 
 double OrderGeneratorGreedy::rate_abstraction(
@@ -41,13 +44,8 @@ void OrderGeneratorGreedy::initialize(
     utils::g_log << "Initialize greedy order generator" << endl;
 
     vector<vector<int>> saturated_costs_by_abstraction;
-    for (const unique_ptr<Abstraction> &abstraction : abstractions) {
-        vector<int> h_values = abstraction->compute_goal_distances(costs);
-        vector<int> saturated_costs =
-            abstraction->compute_saturated_costs(h_values);
-        h_values_by_abstraction.push_back(move(h_values));
-        saturated_costs_by_abstraction.push_back(move(saturated_costs));
-    }
+    h_values_by_abstraction = compute_goal_distances_for_abstractions(
+        abstractions, costs, num_threads, &saturated_costs_by_abstraction);
     utils::g_log << "Time for computing h values and saturated costs: " << timer
                  << endl;
 
@@ -102,13 +100,21 @@ public:
         document_synopsis(
             "Order abstractions greedily by a given scoring function.");
         add_scoring_function_to_feature(*this);
+        utils::add_parallel_options_to_feature(*this);
         add_order_generator_arguments_to_feature(*this);
+        document_note(
+            "Parallelism",
+            "With threads > 1, the goal distances and saturated costs under "
+            "the original costs are computed in parallel during "
+            "initialization. The orders are the same for all numbers of "
+            "threads.");
     }
 
     virtual shared_ptr<OrderGeneratorGreedy> create_component(
         const plugins::Options &options) const override {
         return plugins::make_shared_from_arg_tuples<OrderGeneratorGreedy>(
             options.get<ScoringFunction>("scoring_function"),
+            utils::get_parallel_arguments_from_options(options),
             get_order_generator_arguments_from_options(options));
     }
 };
@@ -7,6 +7,7 @@
 namespace cost_saturation {
 class OrderGeneratorGreedy : public OrderGenerator {
     const ScoringFunction scoring_function;
+    const int num_threads;
 
     // Goal distances under the original cost function by abstraction.
     std::vector<std::vector<int>> h_values_by_abstraction;
@@ -16,7 +17,8 @@ class OrderGeneratorGreedy : public OrderGenerator {
         const std::vector<int> &abstract_state_ids, int abs_id) const;
 
 public:
-    OrderGeneratorGreedy(ScoringFunction scoring_function, int random_seed);
+    OrderGeneratorGreedy(
+        ScoringFunction scoring_function, int num_threads, int random_seed);
 
     virtual void initialize(
         const Abstractions &abstractions,
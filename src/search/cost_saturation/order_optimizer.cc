@@ -1,6 +1,7 @@
 #include "order_optimizer.h"
 
 #include "cost_partitioning_heuristic.h"
+#include "saturated_costs_cache.h"
 
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
@@ -8,6 +9,10 @@
 using namespace std;
 
 namespace cost_saturation {
+/* Neighboring orders share most of their saturated costs, so we cache
+   them. Limit the cache to 64 MiB. */
+static const int64_t MAX_CACHED_VALUES = (int64_t(64) << 20) / sizeof(int);
+
 static void log_better_order(const vector<int> &order, int h, int i, int j) {
     utils::g_log << "Switch positions " << i << " and " << j
                  << " (abstractions " << order[j] << ", " << order[i]
@@ -21,7 +26,7 @@ static bool search_improving_successor(
     const Abstractions &abstractions, const vector<int> &costs,
     const vector<int> &abstract_state_ids, vector<int> &incumbent_order,
     CostPartitioningHeuristic &incumbent_cp, int &incumbent_h_value,
-    bool verbose) {
+    SaturatedCostsCache &cache, bool verbose) {
     int num_abstractions = abstractions.size();
     for (int i = 0; i < num_abstractions && !timer.is_expired(); ++i) {
         for (int j = i + 1; j < num_abstractions && !timer.is_expired(); ++j) {
@@ -30,7 +35,7 @@ static bool search_improving_successor(
             vector<int> remaining_costs = costs;
             CostPartitioningHeuristic neighbor_cp = cp_function(
                 abstractions, incumbent_order, remaining_costs,
-                abstract_state_ids);
+                abstract_state_ids, &cache);
 
             int h = neighbor_cp.compute_heuristic(abstract_state_ids);
             if (h > incumbent_h_value) {
@@ -58,13 +63,17 @@ void optimize_order_with_hill_climbing(
     if (verbose) {
         utils::g_log << "Incumbent h value: " << incumbent_h_value << endl;
     }
+    SaturatedCostsCache cache(abstractions, MAX_CACHED_VALUES);
     while (!timer.is_expired()) {
         bool success = search_improving_successor(
             cp_function, timer, abstractions, costs, abstract_state_ids,
-            incumbent_order, incumbent_cp, incumbent_h_value, verbose);
+            incumbent_order, incumbent_cp, incumbent_h_value, cache, verbose);
         if (!success) {
             break;
         }
     }
+    if (verbose) {
+        cache.print_statistics();
+    }
 }
 }
@@ -11,6 +11,7 @@
 #include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 
 using namespace std;
 
@@ -23,27 +24,24 @@ namespace cost_saturation {
 */
 PhO::PhO(
     const Abstractions &abstractions, const vector<int> &costs,
-    lp::LPSolverType solver_type, bool saturated, const utils::LogProxy &log)
+    lp::LPSolverType solver_type, bool saturated, int num_threads,
+    const utils::LogProxy &log)
     : lp_solver(solver_type),
       abstraction_has_unsolvable_states(abstractions.size(), false),
+      num_threads(num_threads),
       log(log) {
     double infinity = lp_solver.get_infinity();
     int num_abstractions = abstractions.size();
     int num_operators = costs.size();
 
     vector<vector<int>> saturated_costs_by_abstraction;
-    saturated_costs_by_abstraction.reserve(num_abstractions);
-    h_values_by_abstraction.reserve(num_abstractions);
+    h_values_by_abstraction = compute_goal_distances_for_abstractions(
+        abstractions, costs, num_threads, &saturated_costs_by_abstraction);
     for (int i = 0; i < num_abstractions; ++i) {
-        const Abstraction &abstraction = *abstractions[i];
-        vector<int> h_values = abstraction.compute_goal_distances(costs);
+        const vector<int> &h_values = h_values_by_abstraction[i];
         abstraction_has_unsolvable_states[i] = any_of(
             execution::unseq, h_values.begin(), h_values.end(),
             [](int x) { return x == cost_saturation::INF; });
-        vector<int> saturated_costs =
-            abstraction.compute_saturated_costs(h_values);
-        h_values_by_abstraction.push_back(move(h_values));
-        saturated_costs_by_abstraction.push_back(move(saturated_costs));
     }
 
     named_vector::NamedVector<lp::LPVariable> variables;
@@ -95,11 +93,13 @@ CostPartitioningHeuristic PhO::compute_cost_partitioning(
         if (h == INF) {
             // State is unsolvable.
             vector<int> zero_costs(num_operators, 0);
+            vector<vector<int>> zero_h_values_by_abstraction =
+                compute_goal_distances_for_abstractions(
+                    abstractions, zero_costs, num_threads);
             CostPartitioningHeuristic cp_heuristic;
-            for (int i = 0; i < num_abstractions; ++i) {
-                vector<int> h_values =
-                    abstractions[i]->compute_goal_distances(zero_costs);
-                cp_heuristic.add_h_values(i, move(h_values));
+            for (int j = 0; j < num_abstractions; ++j) {
+                cp_heuristic.add_h_values(
+                    j, move(zero_h_values_by_abstraction[j]));
             }
             return cp_heuristic;
         }
@@ -151,6 +151,12 @@ public:
         add_option<bool>("saturated", "saturate costs", "true");
         add_order_options(*this);
         lp::add_lp_solver_option_to_feature(*this);
+        utils::add_parallel_options_to_feature(*this);
+        document_note(
+            "Parallelism",
+            "With threads > 1, the goal distances and saturated costs of the "
+            "abstractions are computed in parallel. The linear programs are "
+            "still solved sequentially.");
     }
 
     virtual shared_ptr<ScaledCostPartitioningHeuristic> create_component(
@@ -165,14 +171,15 @@ public:
             options.get_list<shared_ptr<AbstractionGenerator>>("abstractions"));
         PhO pho(
             abstractions, costs, options.get<lp::LPSolverType>("lpsolver"),
-            options.get<bool>("saturated"),
+            options.get<bool>("saturated"), options.get<int>("threads"),
             utils::get_log_for_verbosity(
                 options.get<utils::Verbosity>("verbosity")));
         CPFunction cp_function = [&pho](
                                      const Abstractions &abstractions_,
                                      const vector<int> &order_,
                                      const vector<int> &costs_,
-                                     const vector<int> &abstract_state_ids) {
+                                     const vector<int> &abstract_state_ids,
+                                     SaturatedCostsCache *) {
             return pho.compute_cost_partitioning(
                 abstractions_, order_, costs_, abstract_state_ids);
         };
@@ -13,11 +13,12 @@ class PhO {
     lp::LPSolver lp_solver;
     std::vector<std::vector<int>> h_values_by_abstraction;
     std::vector<bool> abstraction_has_unsolvable_states;
+    const int num_threads;
     utils::LogProxy log;
 
 public:
     PhO(const Abstractions &abstractions, const std::vector<int> &costs,
-        lp::LPSolverType solver_type, bool saturated,
+        lp::LPSolverType solver_type, bool saturated, int num_threads,
         const utils::LogProxy &log);
 
     CostPartitioningHeuristic compute_cost_partitioning(
@@ -6,6 +6,7 @@
 
 #include "../algorithms/priority_queues.h"
 #include "../pdbs/slim_match_tree.h"
+#include "../task_utils/compiled_task.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
@@ -49,29 +50,29 @@ static int compute_hash_effect(
     return hash_effect;
 }
 
-static vector<int> get_variables(const OperatorProxy &op) {
+static vector<int> get_variables(
+    const compiled_task::CompiledTask &task, int op_id) {
     unordered_set<int> vars;
-    vars.reserve(op.get_preconditions().size());
-    for (FactProxy precondition : op.get_preconditions()) {
-        vars.insert(precondition.get_variable().get_id());
+    vars.reserve(task.get_preconditions(op_id).size());
+    for (const FactPair &precondition : task.get_preconditions(op_id)) {
+        vars.insert(precondition.var);
     }
-    for (EffectProxy effect : op.get_effects()) {
-        vars.insert(effect.get_fact().get_variable().get_id());
+    for (const FactPair &effect : task.get_effects(op_id)) {
+        vars.insert(effect.var);
     }
     vector<int> variables(vars.begin(), vars.end());
     sort(variables.begin(), variables.end());
     return variables;
 }
 
-static vector<int> get_changed_variables(const OperatorProxy &op) {
+static vector<int> get_changed_variables(
+    const compiled_task::CompiledTask &task, int op_id) {
     unordered_map<int, int> var_to_precondition;
-    for (FactProxy precondition : op.get_preconditions()) {
-        const FactPair fact = precondition.get_pair();
+    for (const FactPair &fact : task.get_preconditions(op_id)) {
         var_to_precondition[fact.var] = fact.value;
     }
     vector<int> changed_variables;
-    for (EffectProxy effect : op.get_effects()) {
-        const FactPair fact = effect.get_fact().get_pair();
+    for (const FactPair &fact : task.get_effects(op_id)) {
         auto it = var_to_precondition.find(fact.var);
         if (it != var_to_precondition.end() && it->second != fact.value) {
             changed_variables.push_back(fact.var);
@@ -105,17 +106,17 @@ using OperatorIDsByPreEffMap =
 using OperatorGroups = vector<OperatorGroup>;
 
 static OperatorGroups group_equivalent_operators(
-    const TaskProxy &task_proxy, const vector<int> &variable_to_pattern_index) {
+    const compiled_task::CompiledTask &task,
+    const vector<int> &variable_to_pattern_index) {
     OperatorIDsByPreEffMap grouped_operator_ids;
     // Reuse vectors to save allocations.
     vector<FactPair> preconditions;
     vector<FactPair> effects;
-    for (OperatorProxy op : task_proxy.get_operators()) {
+    for (int op_id = 0; op_id < task.get_num_operators(); ++op_id) {
         effects.clear();
-        for (EffectProxy eff : op.get_effects()) {
-            if (variable_to_pattern_index[eff.get_fact().get_pair().var] !=
-                -1) {
-                effects.push_back(eff.get_fact().get_pair());
+        for (const FactPair &eff : task.get_effects(op_id)) {
+            if (variable_to_pattern_index[eff.var] != -1) {
+                effects.push_back(eff);
             }
         }
         /* Skip operators that only induce self-loops. They can be queried
@@ -125,16 +126,16 @@ static OperatorGroups group_equivalent_operators(
         }
         sort(effects.begin(), effects.end());
 
+        // Preconditions are already sorted.
         preconditions.clear();
-        for (FactProxy fact : op.get_preconditions()) {
-            if (variable_to_pattern_index[fact.get_pair().var] != -1) {
-                preconditions.push_back(fact.get_pair());
+        for (const FactPair &fact : task.get_preconditions(op_id)) {
+            if (variable_to_pattern_index[fact.var] != -1) {
+                preconditions.push_back(fact);
             }
         }
-        sort(preconditions.begin(), preconditions.end());
 
         grouped_operator_ids[make_pair(move(preconditions), move(effects))]
-            .push_back(op.get_id());
+            .push_back(op_id);
     }
     OperatorGroups groups;
     for (auto &[pre_eff, operator_ids] : grouped_operator_ids) {
@@ -152,41 +153,39 @@ static OperatorGroups group_equivalent_operators(
 }
 
 static OperatorGroups get_singleton_operator_groups(
-    const TaskProxy &task_proxy) {
+    const compiled_task::CompiledTask &task) {
     OperatorGroups groups;
-    for (OperatorProxy op : task_proxy.get_operators()) {
+    for (int op_id = 0; op_id < task.get_num_operators(); ++op_id) {
         OperatorGroup group;
-        group.preconditions =
-            task_properties::get_fact_pairs(op.get_preconditions());
-        sort(group.preconditions.begin(), group.preconditions.end());
-        group.effects.reserve(op.get_effects().size());
-        for (EffectProxy eff : op.get_effects()) {
-            group.effects.push_back(eff.get_fact().get_pair());
-        }
+        span<const FactPair> preconditions = task.get_preconditions(op_id);
+        group.preconditions.assign(preconditions.begin(), preconditions.end());
+        span<const FactPair> effects = task.get_effects(op_id);
+        group.effects.assign(effects.begin(), effects.end());
         sort(group.effects.begin(), group.effects.end());
-        group.operator_ids = {op.get_id()};
+        group.operator_ids = {op_id};
         groups.push_back(move(group));
     }
     return groups;
 }
 
-TaskInfo::TaskInfo(const TaskProxy &task_proxy) {
-    num_variables = task_proxy.get_variables().size();
-    num_operators = task_proxy.get_operators().size();
-    goals = task_properties::get_fact_pairs(task_proxy.get_goals());
+TaskInfo::TaskInfo(const TaskProxy &task_proxy)
+    : compiled_task(&compiled_task::g_compiled_tasks[task_proxy]) {
+    const compiled_task::CompiledTask &task = *compiled_task;
+    num_variables = task.get_num_variables();
+    num_operators = task.get_num_operators();
+    goals = task.get_goals();
     mentioned_variables.resize(num_operators * num_variables, false);
     pre_eff_variables.resize(num_operators * num_variables, false);
     effect_variables.resize(num_operators * num_variables, false);
-    for (OperatorProxy op : task_proxy.get_operators()) {
-        for (int var : get_variables(op)) {
-            mentioned_variables[get_index(op.get_id(), var)] = true;
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        for (int var : get_variables(task, op_id)) {
+            mentioned_variables[get_index(op_id, var)] = true;
         }
-        for (int changed_var : get_changed_variables(op)) {
-            pre_eff_variables[get_index(op.get_id(), changed_var)] = true;
+        for (int changed_var : get_changed_variables(task, op_id)) {
+            pre_eff_variables[get_index(op_id, changed_var)] = true;
         }
-        for (EffectProxy effect : op.get_effects()) {
-            int var = effect.get_fact().get_variable().get_id();
-            effect_variables[get_index(op.get_id(), var)] = true;
+        for (const FactPair &effect : task.get_effects(op_id)) {
+            effect_variables[get_index(op_id, effect.var)] = true;
         }
     }
 }
@@ -195,6 +194,10 @@ const vector<FactPair> &TaskInfo::get_goals() const {
     return goals;
 }
 
+const compiled_task::CompiledTask &TaskInfo::get_compiled_task() const {
+    return *compiled_task;
+}
+
 int TaskInfo::get_num_operators() const {
     return num_operators;
 }
@@ -244,6 +247,18 @@ int ProjectionFunction::get_abstract_state_id(
     return index;
 }
 
+vector<int> ProjectionFunction::get_key() const {
+    // Prepend the pattern size to obtain a non-empty key.
+    vector<int> key;
+    key.reserve(1 + 2 * variables_and_multipliers.size());
+    key.push_back(variables_and_multipliers.size());
+    for (const VariableAndMultiplier &pair : variables_and_multipliers) {
+        key.push_back(pair.pattern_var);
+        key.push_back(pair.hash_multiplier);
+    }
+    return key;
+}
+
 Projection::Projection(
     const TaskProxy &task_proxy, const shared_ptr<TaskInfo> &task_info,
     const pdbs::Pattern &pattern, bool combine_labels)
@@ -288,12 +303,13 @@ Projection::Projection(
     match_tree_backward =
         make_unique<pdbs::SlimMatchTree>(task_proxy, pattern, hash_multipliers);
 
+    const compiled_task::CompiledTask &task = task_info->get_compiled_task();
     OperatorGroups operator_groups;
     if (combine_labels) {
         operator_groups =
-            group_equivalent_operators(task_proxy, variable_to_pattern_index);
+            group_equivalent_operators(task, variable_to_pattern_index);
     } else {
-        operator_groups = get_singleton_operator_groups(task_proxy);
+        operator_groups = get_singleton_operator_groups(task);
     }
     int num_ops_covered_by_labels = 0;
     for (const auto &group : operator_groups) {
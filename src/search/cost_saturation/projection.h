@@ -15,6 +15,10 @@ class OperatorProxy;
 class TaskProxy;
 class VariablesProxy;
 
+namespace compiled_task {
+class CompiledTask;
+}
+
 namespace pdbs {
 class SlimMatchTree;
 }
@@ -23,6 +27,10 @@ namespace cost_saturation {
 /* Precompute and store information about a task that is useful for projections.
  */
 class TaskInfo {
+    /* Look up the compiled task once, since accessing the per-task
+       registry takes a lock, which parallel projection builds would
+       contend for. */
+    const compiled_task::CompiledTask *compiled_task;
     int num_variables;
     int num_operators;
     std::vector<FactPair> goals;
@@ -45,6 +53,7 @@ class TaskInfo {
 public:
     explicit TaskInfo(const TaskProxy &task_proxy);
 
+    const compiled_task::CompiledTask &get_compiled_task() const;
     const std::vector<FactPair> &get_goals() const;
     int get_num_operators() const;
     bool operator_mentions_variable(int op_id, int var) const;
@@ -83,6 +92,7 @@ public:
 
     virtual int get_abstract_state_id(
         const State &concrete_state) const override;
+    virtual std::vector<int> get_key() const override;
 };
 
 class Projection : public Abstraction {
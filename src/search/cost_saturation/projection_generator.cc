@@ -9,7 +9,9 @@
 #include "../plugins/options.h"
 #include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
+#include "../utils/parallel.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace pdbs;
@@ -19,12 +21,14 @@ namespace cost_saturation {
 ProjectionGenerator::ProjectionGenerator(
     const shared_ptr<pdbs::PatternCollectionGenerator> &patterns,
     bool dominance_pruning, bool combine_labels,
-    TransitionSystemType transition_type, utils::Verbosity verbosity)
+    TransitionSystemType transition_type, int num_threads,
+    utils::Verbosity verbosity)
     : AbstractionGenerator(verbosity),
       pattern_generator(patterns),
       dominance_pruning(dominance_pruning),
       combine_labels(combine_labels),
-      transition_type(transition_type) {
+      transition_type(transition_type),
+      num_threads(num_threads) {
 }
 
 Abstractions ProjectionGenerator::generate_abstractions(
@@ -76,29 +80,35 @@ Abstractions ProjectionGenerator::generate_abstractions(
 
     log << "Build projections" << endl;
     utils::Timer pdbs_timer;
-    shared_ptr<TaskInfo> task_info = make_shared<TaskInfo>(task_proxy);
-    Abstractions abstractions;
     task_properties::verify_no_axioms(task_proxy);
-    for (const pdbs::Pattern &pattern : *patterns) {
-        unique_ptr<Abstraction> projection;
-        if (projections) {
-            // Projections have already been computed by the generator.
-            projection = move((*projections)[abstractions.size()]);
-        } else if (use_explicit) {
-            projection = ExplicitProjectionFactory(task_proxy, pattern)
-                             .convert_to_abstraction();
-        } else {
+    int num_patterns = patterns->size();
+    Abstractions abstractions(num_patterns);
+    if (projections) {
+        // Projections have already been computed by the generator.
+        move(projections->begin(), projections->end(), abstractions.begin());
+    } else {
+        if (!use_explicit) {
             task_properties::verify_no_conditional_effects(task_proxy);
-            projection = make_unique<Projection>(
-                task_proxy, task_info, pattern, combine_labels);
         }
+        shared_ptr<TaskInfo> task_info = make_shared<TaskInfo>(task_proxy);
+        // Projections are independent, so we can build them in any order.
+        utils::parallel_for(num_patterns, num_threads, [&](int, int i) {
+            const pdbs::Pattern &pattern = (*patterns)[i];
+            if (use_explicit) {
+                abstractions[i] = ExplicitProjectionFactory(task_proxy, pattern)
+                                      .convert_to_abstraction();
+            } else {
+                abstractions[i] = make_unique<Projection>(
+                    task_proxy, task_info, pattern, combine_labels);
+            }
+        });
+    }
 
-        if (log.is_at_least_debug()) {
-            log << "Pattern " << abstractions.size() + 1 << ": " << pattern
-                << endl;
-            projection->dump();
+    if (log.is_at_least_debug()) {
+        for (int i = 0; i < num_patterns; ++i) {
+            log << "Pattern " << i + 1 << ": " << (*patterns)[i] << endl;
+            abstractions[i]->dump();
         }
-        abstractions.push_back(move(projection));
     }
 
     int collection_size = 0;
@@ -137,7 +147,13 @@ public:
             "combine_labels",
             "group labels that only induce parallel transitions", "true");
         add_transition_type_option(*this);
+        utils::add_parallel_options_to_feature(*this);
         add_abstraction_generator_arguments_to_feature(*this);
+        document_note(
+            "Parallelism",
+            "With threads > 1, the projections are built in parallel after "
+            "the patterns have been computed. The projections are the same "
+            "for all numbers of threads.");
     }
 
     virtual shared_ptr<ProjectionGenerator> create_component(
@@ -148,6 +164,7 @@ public:
             options.get<bool>("dominance_pruning"),
             options.get<bool>("combine_labels"),
             options.get<TransitionSystemType>("transitions"),
+            utils::get_parallel_arguments_from_options(options),
             get_abstraction_generator_arguments_from_options(options));
     }
 };
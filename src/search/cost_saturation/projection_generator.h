@@ -14,12 +14,14 @@ class ProjectionGenerator : public AbstractionGenerator {
     const bool dominance_pruning;
     const bool combine_labels;
     const TransitionSystemType transition_type;
+    const int num_threads;
 
 public:
     ProjectionGenerator(
         const std::shared_ptr<pdbs::PatternCollectionGenerator> &patterns,
         bool dominance_pruning, bool combine_labels,
-        TransitionSystemType transition_type, utils::Verbosity verbosity);
+        TransitionSystemType transition_type, int num_threads,
+        utils::Verbosity verbosity);
 
     virtual Abstractions generate_abstractions(
         const std::shared_ptr<AbstractTask> &task,
@@ -5,6 +5,7 @@
 #include "cost_partitioning_heuristic.h"
 #include "cost_partitioning_heuristic_collection_generator.h"
 #include "max_cost_partitioning_heuristic.h"
+#include "saturated_costs_cache.h"
 #include "utils.h"
 
 #include "../algorithms/partial_state_tree.h"
@@ -15,23 +16,6 @@
 using namespace std;
 
 namespace cost_saturation {
-CostPartitioningHeuristic compute_saturated_cost_partitioning(
-    const Abstractions &abstractions, const vector<int> &order,
-    vector<int> &remaining_costs, const vector<int> &) {
-    assert(abstractions.size() == order.size());
-    CostPartitioningHeuristic cp_heuristic;
-    for (int pos : order) {
-        const Abstraction &abstraction = *abstractions[pos];
-        vector<int> h_values =
-            abstraction.compute_goal_distances(remaining_costs);
-        vector<int> saturated_costs =
-            abstraction.compute_saturated_costs(h_values);
-        cp_heuristic.add_h_values(pos, move(h_values));
-        reduce_costs(remaining_costs, saturated_costs);
-    }
-    return cp_heuristic;
-}
-
 static void cap_h_values(int h_cap, vector<int> &h_values) {
     assert(h_cap != -INF);
     for (int &h : h_values) {
@@ -41,32 +25,75 @@ static void cap_h_values(int h_cap, vector<int> &h_values) {
     }
 }
 
+/*
+  Compute the goal distances of the given abstraction under the remaining
+  costs, cap them at the goal distance of cap_state unless cap_state is -1,
+  and subtract the saturated costs from the remaining costs.
+*/
+static vector<int> saturate(
+    const Abstractions &abstractions, int pos, int cap_state,
+    vector<int> &remaining_costs, SaturatedCostsCache *cache) {
+    if (cache) {
+        const CachedSaturation *cached =
+            cache->lookup(pos, cap_state, remaining_costs);
+        if (cached) {
+            reduce_costs(remaining_costs, cached->saturated_costs);
+            return cached->h_values;
+        }
+    }
+    const Abstraction &abstraction = *abstractions[pos];
+    vector<int> h_values = abstraction.compute_goal_distances(remaining_costs);
+    if (cap_state != -1) {
+        cap_h_values(h_values[cap_state], h_values);
+    }
+    vector<int> saturated_costs = abstraction.compute_saturated_costs(h_values);
+    if (cache) {
+        // The remaining costs are the key, so insert before reducing them.
+        const CachedSaturation &cached = cache->insert(
+            pos, cap_state, remaining_costs, {h_values, move(saturated_costs)});
+        reduce_costs(remaining_costs, cached.saturated_costs);
+    } else {
+        reduce_costs(remaining_costs, saturated_costs);
+    }
+    return h_values;
+}
+
+CostPartitioningHeuristic compute_saturated_cost_partitioning(
+    const Abstractions &abstractions, const vector<int> &order,
+    vector<int> &remaining_costs, const vector<int> &,
+    SaturatedCostsCache *cache) {
+    assert(abstractions.size() == order.size());
+    CostPartitioningHeuristic cp_heuristic;
+    for (int pos : order) {
+        cp_heuristic.add_h_values(
+            pos, saturate(abstractions, pos, -1, remaining_costs, cache));
+    }
+    return cp_heuristic;
+}
+
 CostPartitioningHeuristic compute_perim_saturated_cost_partitioning(
     const Abstractions &abstractions, const vector<int> &order,
-    vector<int> &remaining_costs, const vector<int> &abstract_state_ids) {
+    vector<int> &remaining_costs, const vector<int> &abstract_state_ids,
+    SaturatedCostsCache *cache) {
     assert(abstractions.size() == order.size());
     CostPartitioningHeuristic cp_heuristic;
     for (int pos : order) {
-        const Abstraction &abstraction = *abstractions[pos];
-        vector<int> h_values =
-            abstraction.compute_goal_distances(remaining_costs);
-        int h_cap = h_values[abstract_state_ids[pos]];
-        cap_h_values(h_cap, h_values);
-        vector<int> saturated_costs =
-            abstraction.compute_saturated_costs(h_values);
-        cp_heuristic.add_h_values(pos, move(h_values));
-        reduce_costs(remaining_costs, saturated_costs);
+        cp_heuristic.add_h_values(
+            pos, saturate(
+                     abstractions, pos, abstract_state_ids[pos],
+                     remaining_costs, cache));
     }
     return cp_heuristic;
 }
 
 static CostPartitioningHeuristic compute_perimstar_saturated_cost_partitioning(
     const Abstractions &abstractions, const vector<int> &order,
-    vector<int> &remaining_costs, const vector<int> &abstract_state_ids) {
+    vector<int> &remaining_costs, const vector<int> &abstract_state_ids,
+    SaturatedCostsCache *cache) {
     CostPartitioningHeuristic cp = compute_perim_saturated_cost_partitioning(
-        abstractions, order, remaining_costs, abstract_state_ids);
+        abstractions, order, remaining_costs, abstract_state_ids, cache);
     cp.add(compute_saturated_cost_partitioning(
-        abstractions, order, remaining_costs, abstract_state_ids));
+        abstractions, order, remaining_costs, abstract_state_ids, cache));
     return cp;
 }
 
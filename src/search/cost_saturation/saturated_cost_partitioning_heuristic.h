@@ -22,12 +22,14 @@ enum class Saturator {
 extern CostPartitioningHeuristic compute_saturated_cost_partitioning(
     const Abstractions &abstractions, const std::vector<int> &order,
     std::vector<int> &remaining_costs,
-    const std::vector<int> &abstract_state_ids);
+    const std::vector<int> &abstract_state_ids,
+    SaturatedCostsCache *cache = nullptr);
 
 extern CostPartitioningHeuristic compute_perim_saturated_cost_partitioning(
     const Abstractions &abstractions, const std::vector<int> &order,
     std::vector<int> &remaining_costs,
-    const std::vector<int> &abstract_state_ids);
+    const std::vector<int> &abstract_state_ids,
+    SaturatedCostsCache *cache = nullptr);
 
 extern void add_saturator_option(plugins::Feature &feature);
 extern CPFunction get_cp_function_from_options(const plugins::Options &options);
@@ -1,6 +1,7 @@
 #include "saturated_cost_partitioning_online_heuristic.h"
 
 #include "abstraction.h"
+#include "abstraction_registry.h"
 #include "cost_partitioning_heuristic.h"
 #include "cost_partitioning_heuristic_collection_generator.h"
 #include "order_generator.h"
@@ -14,6 +15,8 @@
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace cost_saturation {
@@ -22,7 +25,8 @@ SaturatedCostPartitioningOnlineHeuristic::
         const shared_ptr<OrderGenerator> &order_generator, Saturator saturator,
         const CPFunction &cp_function, Abstractions &&abstractions_,
         unique_ptr<DeadEnds> &&dead_ends_, const int interval,
-        const double max_time, const int max_size_kb, const bool debug,
+        const double max_time, const int max_size_kb,
+        const int num_background_threads, const bool debug,
         const shared_ptr<AbstractTask> &transform, bool cache_estimates,
         const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity),
@@ -30,30 +34,212 @@ SaturatedCostPartitioningOnlineHeuristic::
       saturator(saturator),
       cp_function(cp_function),
       abstractions(move(abstractions_)),
+      abstraction_registry(g_abstraction_registries[task_proxy]),
       dead_ends(move(dead_ends_)),
       interval(interval),
       max_time(max_time),
       max_size_kb(max_size_kb),
+      num_background_threads(num_background_threads),
       debug(debug),
       costs(task_properties::get_operator_costs(task_proxy)),
       improve_heuristic(true),
       size_kb(0),
       num_evaluated_states(0),
-      num_scps_computed(0) {
+      num_scps_computed(0),
+      stop_workers(false),
+      num_waiting_workers(0),
+      num_running_workers(0),
+      has_new_cp_heuristics(false) {
     order_generator->initialize(abstractions, costs);
+    // The search thread only needs the abstraction functions for lookups.
+    AbstractionFunctions abstraction_functions;
+    abstraction_functions.reserve(abstractions.size());
+    for (const unique_ptr<Abstraction> &abstraction : abstractions) {
+        abstraction_functions.push_back(
+            abstraction->extract_abstraction_function());
+    }
+    abstraction_slots = abstraction_registry.add_abstraction_functions(
+        move(abstraction_functions));
     for (const auto &cp : cp_heuristics) {
         size_kb += cp.estimate_size_in_kb();
     }
-    improve_heuristic_timer = make_unique<utils::Timer>(false);
-    select_state_timer = make_unique<utils::Timer>(false);
+    utils::Clock clock = (num_background_threads > 0)
+                             ? utils::Clock::WALL
+                             : utils::Clock::PROCESS_CPU;
+    improve_heuristic_timer = make_unique<utils::Timer>(false, clock);
+    select_state_timer = make_unique<utils::Timer>(false, clock);
+    improvement_phase_timer = make_unique<utils::Timer>(true, clock);
+    num_running_workers = num_background_threads;
+    for (int i = 0; i < num_background_threads; ++i) {
+        workers.emplace_back(
+            &SaturatedCostPartitioningOnlineHeuristic::run_worker, this);
+    }
 }
 
 SaturatedCostPartitioningOnlineHeuristic::
     ~SaturatedCostPartitioningOnlineHeuristic() {
+    request_workers_to_stop();
+    for (thread &worker : workers) {
+        worker.join();
+    }
     if (improve_heuristic) {
+        adopt_new_cp_heuristics();
         print_intermediate_statistics();
         print_final_statistics();
     }
+    abstraction_registry.remove_abstraction_functions(abstraction_slots);
+}
+
+optional<CostPartitioningHeuristic>
+SaturatedCostPartitioningOnlineHeuristic::compute_improving_scp(
+    const vector<int> &abstract_state_ids, const Order &order, int max_h,
+    int &new_h) const {
+    CostPartitioningHeuristic cost_partitioning;
+    vector<int> remaining_costs = costs;
+    if (saturator == Saturator::PERIMSTAR) {
+        // Compute only the first SCP here, and the second below if necessary.
+        cost_partitioning = compute_perim_saturated_cost_partitioning(
+            abstractions, order, remaining_costs, abstract_state_ids);
+    } else {
+        cost_partitioning = cp_function(
+            abstractions, order, remaining_costs, abstract_state_ids, nullptr);
+    }
+
+    new_h = cost_partitioning.compute_heuristic(abstract_state_ids);
+    if (new_h <= max_h) {
+        return nullopt;
+    }
+
+    /* Adding the second SCP is only useful if the order is already diverse
+       for the current state. */
+    if (saturator == Saturator::PERIMSTAR) {
+        cost_partitioning.add(compute_saturated_cost_partitioning(
+            abstractions, order, remaining_costs, abstract_state_ids));
+    }
+    return cost_partitioning;
+}
+
+void SaturatedCostPartitioningOnlineHeuristic::run_worker() {
+    while (true) {
+        SelectedState selected_state;
+        {
+            unique_lock<mutex> lock(selected_states_mutex);
+            ++num_waiting_workers;
+            selected_states_cv.wait(lock, [this]() {
+                return stop_workers || !selected_states.empty();
+            });
+            --num_waiting_workers;
+            if (stop_workers) {
+                break;
+            }
+            selected_state = move(selected_states.front());
+            selected_states.pop_front();
+        }
+
+        Order order;
+        {
+            lock_guard<mutex> lock(order_generator_mutex);
+            order = order_generator->compute_order_for_state(
+                selected_state.abstract_state_ids, selected_state.verbose);
+        }
+        int new_h;
+        optional<CostPartitioningHeuristic> cost_partitioning =
+            compute_improving_scp(
+                selected_state.abstract_state_ids, order,
+                selected_state.max_h, new_h);
+        ++num_scps_computed;
+        if (cost_partitioning) {
+            size_kb += cost_partitioning->estimate_size_in_kb();
+            lock_guard<mutex> lock(new_cp_heuristics_mutex);
+            new_cp_heuristics.push_back(move(*cost_partitioning));
+            has_new_cp_heuristics = true;
+        }
+    }
+    --num_running_workers;
+}
+
+void SaturatedCostPartitioningOnlineHeuristic::select_state_for_workers(
+    vector<int> &&abstract_state_ids, int max_h) {
+    {
+        lock_guard<mutex> lock(selected_states_mutex);
+        /* Skip the state if all workers are busy, i.e., if there are at
+           least as many queued states as waiting workers. */
+        if (stop_workers || static_cast<int>(selected_states.size()) >=
+                                num_waiting_workers) {
+            return;
+        }
+        selected_states.push_back(
+            {move(abstract_state_ids), max_h, num_evaluated_states == 0});
+    }
+    selected_states_cv.notify_one();
+}
+
+bool SaturatedCostPartitioningOnlineHeuristic::adopt_new_cp_heuristics() {
+    if (!has_new_cp_heuristics) {
+        return false;
+    }
+    // Don't wait for a worker that is publishing an SCP.
+    unique_lock<mutex> lock(new_cp_heuristics_mutex, try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    for (CostPartitioningHeuristic &cp_heuristic : new_cp_heuristics) {
+        cp_heuristics.push_back(move(cp_heuristic));
+    }
+    new_cp_heuristics.clear();
+    has_new_cp_heuristics = false;
+    return true;
+}
+
+void SaturatedCostPartitioningOnlineHeuristic::request_workers_to_stop() {
+    {
+        lock_guard<mutex> lock(selected_states_mutex);
+        stop_workers = true;
+        selected_states.clear();
+    }
+    selected_states_cv.notify_all();
+}
+
+double SaturatedCostPartitioningOnlineHeuristic::get_improvement_time() const {
+    if (num_background_threads == 0) {
+        return (*improve_heuristic_timer)();
+    }
+    return (*improvement_phase_timer)();
+}
+
+void SaturatedCostPartitioningOnlineHeuristic::
+    release_useless_abstraction_functions() {
+    vector<bool> useful_abstractions(abstraction_slots.size(), false);
+    for (const auto &cp_heuristic : cp_heuristics) {
+        cp_heuristic.mark_useful_abstractions(useful_abstractions);
+    }
+    vector<int> useless_slots;
+    for (size_t i = 0; i < abstraction_slots.size(); ++i) {
+        if (!useful_abstractions[i] && abstraction_slots[i] != -1) {
+            useless_slots.push_back(abstraction_slots[i]);
+            abstraction_slots[i] = -1;
+        }
+    }
+    abstraction_registry.remove_abstraction_functions(useless_slots);
+    int num_useful_abstractions =
+        count(useful_abstractions.begin(), useful_abstractions.end(), true);
+    utils::g_log << "Useful abstractions: " << num_useful_abstractions << "/"
+                 << useful_abstractions.size() << endl;
+}
+
+void SaturatedCostPartitioningOnlineHeuristic::stop_improvement_phase() {
+    request_workers_to_stop();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    adopt_new_cp_heuristics();
+    utils::g_log << "Stop heuristic improvement phase." << endl;
+    improve_heuristic = false;
+    release_useless_abstraction_functions();
+    utils::release_vector_memory(abstractions);
+    print_intermediate_statistics();
+    print_final_statistics();
 }
 
 int SaturatedCostPartitioningOnlineHeuristic::compute_heuristic(
@@ -72,14 +258,13 @@ int SaturatedCostPartitioningOnlineHeuristic::compute_heuristic(
         return DEAD_END;
     }
 
-    vector<int> abstract_state_ids;
-    if (improve_heuristic) {
-        assert(abstraction_functions.empty());
-        abstract_state_ids = get_abstract_state_ids(abstractions, state);
-    } else {
-        assert(abstractions.empty());
-        abstract_state_ids =
-            get_abstract_state_ids(abstraction_functions, state);
+    abstraction_registry.set_state(ancestor_state, state);
+    vector<int> abstract_state_ids =
+        abstraction_registry.get_abstract_state_ids(abstraction_slots);
+
+    bool stored_scp = false;
+    if (improve_heuristic && !workers.empty()) {
+        stored_scp = adopt_new_cp_heuristics();
     }
 
     int max_h = compute_max_h(cp_heuristics, abstract_state_ids);
@@ -89,52 +274,35 @@ int SaturatedCostPartitioningOnlineHeuristic::compute_heuristic(
     }
 
     if (improve_heuristic &&
-        ((*improve_heuristic_timer)() >= max_time || size_kb >= max_size_kb)) {
-        utils::g_log << "Stop heuristic improvement phase." << endl;
-        improve_heuristic = false;
-        abstraction_functions =
-            extract_abstraction_functions_from_useful_abstractions(
-                cp_heuristics, nullptr, abstractions);
-        utils::release_vector_memory(abstractions);
-        print_intermediate_statistics();
-        print_final_statistics();
+        (get_improvement_time() >= max_time || size_kb >= max_size_kb)) {
+        /* Background workers finish their current SCP before they stop.
+           We keep the abstractions until all of them are done. */
+        request_workers_to_stop();
+        if (num_running_workers == 0) {
+            stop_improvement_phase();
+        }
     }
-    bool stored_scp = false;
     if (improve_heuristic && (num_evaluated_states % interval == 0)) {
         if (debug) {
             utils::g_log << "Compute SCP for " << ancestor_state.get_id()
                          << endl;
         }
-        Order order = order_generator->compute_order_for_state(
-            abstract_state_ids, num_evaluated_states == 0);
-
-        CostPartitioningHeuristic cost_partitioning;
-        vector<int> remaining_costs = costs;
-        if (saturator == Saturator::PERIMSTAR) {
-            // Compute only the first SCP here, and the second below if
-            // necessary.
-            cost_partitioning = compute_perim_saturated_cost_partitioning(
-                abstractions, order, remaining_costs, abstract_state_ids);
-        } else {
-            cost_partitioning = cp_function(
-                abstractions, order, remaining_costs, abstract_state_ids);
-        }
-        ++num_scps_computed;
-
-        int new_h = cost_partitioning.compute_heuristic(abstract_state_ids);
-
-        if (new_h > max_h) {
-            /* Adding the second SCP is only useful if the order is already
-               diverse for the current state. */
-            if (saturator == Saturator::PERIMSTAR) {
-                cost_partitioning.add(compute_saturated_cost_partitioning(
-                    abstractions, order, remaining_costs, abstract_state_ids));
+        if (workers.empty()) {
+            Order order = order_generator->compute_order_for_state(
+                abstract_state_ids, num_evaluated_states == 0);
+            int new_h;
+            optional<CostPartitioningHeuristic> cost_partitioning =
+                compute_improving_scp(abstract_state_ids, order, max_h, new_h);
+            ++num_scps_computed;
+            if (cost_partitioning) {
+                size_kb += cost_partitioning->estimate_size_in_kb();
+                cp_heuristics.push_back(move(*cost_partitioning));
+                stored_scp = true;
             }
-            size_kb += cost_partitioning.estimate_size_in_kb();
-            cp_heuristics.push_back(move(cost_partitioning));
-            stored_scp = true;
+            max_h = max(max_h, new_h);
+        } else {
+            select_state_for_workers(move(abstract_state_ids), max_h);
         }
-        max_h = max(max_h, new_h);
     }
 
     ++num_evaluated_states;
@@ -216,6 +384,19 @@ public:
             "interval",
             "select every i-th evaluated state for online diversification",
             "10K", plugins::Bounds("1", "infinity"));
+        add_option<int>(
+            "background_threads",
+            "number of threads that compute SCPs for the selected states in "
+            "the background. With the default value 0, the search computes "
+            "each SCP before it continues. Otherwise, the search never waits "
+            "for cost partitionings: it skips selected states while all "
+            "threads are busy, uses new SCPs as soon as they are ready and "
+            "max_time limits the wall-clock time of the improvement phase. "
+            "The reported diversification time is then the wall-clock time "
+            "the search spends in the heuristic. Note that the background "
+            "threads use additional CPU time, which counts against CPU time "
+            "limits of the planner, such as the one set by the driver.",
+            "0", plugins::Bounds("0", "infinity"));
         add_option<bool>("debug", "print debug output", "false");
         utils::add_rng_options_to_feature(*this);
     }
@@ -237,7 +418,7 @@ public:
             get_cp_function_from_options(options), move(abstractions),
             move(dead_ends), options.get<int>("interval"),
             options.get<double>("max_time"), options.get<int>("max_size"),
-            options.get<bool>("debug"),
+            options.get<int>("background_threads"), options.get<bool>("debug"),
             get_heuristic_arguments_from_options(options));
     }
 };
@@ -6,7 +6,13 @@
 
 #include "../heuristic.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace utils {
@@ -14,28 +20,81 @@ class Timer;
 }
 
 namespace cost_saturation {
+class AbstractionRegistry;
 class OrderGenerator;
 
+/*
+  A state selected for diversification, together with the heuristic value
+  of the stored cost partitionings at the time of the selection.
+*/
+struct SelectedState {
+    std::vector<int> abstract_state_ids;
+    int max_h;
+    bool verbose;
+};
+
 class SaturatedCostPartitioningOnlineHeuristic : public Heuristic {
     const std::shared_ptr<OrderGenerator> order_generator;
     const Saturator saturator;
     const CPFunction cp_function;
+    /* The abstractions hand their abstraction functions to the registry,
+       and we keep them until the improvement phase ends. */
     Abstractions abstractions;
-    AbstractionFunctions abstraction_functions;
+    AbstractionRegistry &abstraction_registry;
+    // Slot in the registry for each abstraction (-1 for unneeded ones).
+    std::vector<int> abstraction_slots;
     std::unique_ptr<DeadEnds> dead_ends;
     CPHeuristics cp_heuristics;
     const int interval;
     const double max_time;
     const int max_size_kb;
+    const int num_background_threads;
     const bool debug;
 
     const std::vector<int> costs;
     bool improve_heuristic;
+    /* With background workers, the process CPU time includes the time of
+       the workers, so we measure wall-clock time in this case. */
     std::unique_ptr<utils::Timer> improve_heuristic_timer;
     std::unique_ptr<utils::Timer> select_state_timer;
-    int size_kb;
+    std::unique_ptr<utils::Timer> improvement_phase_timer;
+    std::atomic<int> size_kb;
     int num_evaluated_states;
-    int num_scps_computed;
+    std::atomic<int> num_scps_computed;
+
+    /*
+      In asynchronous mode, the search thread pushes selected states to a
+      bounded queue and never waits for the background workers. The workers
+      compute orders (one worker at a time) and SCPs (in parallel) and
+      publish useful SCPs in new_cp_heuristics. We only hand a state to the
+      workers if one of them is waiting for it. The search thread moves
+      them to cp_heuristics when it evaluates the next state and doesn't
+      have to wait for the lock.
+    */
+    std::vector<std::thread> workers;
+    std::mutex selected_states_mutex;
+    std::condition_variable selected_states_cv;
+    std::deque<SelectedState> selected_states;
+    bool stop_workers;
+    int num_waiting_workers;
+    std::atomic<int> num_running_workers;
+    std::mutex order_generator_mutex;
+    std::mutex new_cp_heuristics_mutex;
+    CPHeuristics new_cp_heuristics;
+    std::atomic<bool> has_new_cp_heuristics;
+
+    std::optional<CostPartitioningHeuristic> compute_improving_scp(
+        const std::vector<int> &abstract_state_ids, const Order &order,
+        int max_h, int &new_h) const;
+
+    void run_worker();
+    void select_state_for_workers(
+        std::vector<int> &&abstract_state_ids, int max_h);
+    bool adopt_new_cp_heuristics();
+    void request_workers_to_stop();
+    double get_improvement_time() const;
+    void release_useless_abstraction_functions();
+    void stop_improvement_phase();
 
     void print_intermediate_statistics() const;
     void print_final_statistics() const;
@@ -48,7 +107,8 @@ public:
         const std::shared_ptr<OrderGenerator> &order_generator,
         Saturator saturator, const CPFunction &cp_function,
         Abstractions &&abstractions_, std::unique_ptr<DeadEnds> &&dead_ends_,
-        int interval, double max_time, int max_size_kb, bool debug,
+        int interval, double max_time, int max_size_kb,
+        int num_background_threads, bool debug,
         const std::shared_ptr<AbstractTask> &transform, bool cache_estimates,
         const std::string &description, utils::Verbosity verbosity);
     virtual ~SaturatedCostPartitioningOnlineHeuristic() override;
@@ -0,0 +1,86 @@
+#include "saturated_costs_cache.h"
+
+#include "abstraction.h"
+
+#include "../utils/logging.h"
+
+using namespace std;
+
+namespace cost_saturation {
+SaturatedCostsCache::SaturatedCostsCache(
+    const Abstractions &abstractions, int64_t max_cached_values)
+    : entries_by_abstraction(abstractions.size()),
+      max_cached_values(max_cached_values),
+      num_cached_values(0),
+      num_hits(0),
+      num_misses(0),
+      num_clears(0) {
+    active_operators_by_abstraction.reserve(abstractions.size());
+    for (const unique_ptr<Abstraction> &abstraction : abstractions) {
+        vector<int> active_operators;
+        int num_operators = abstraction->get_num_operators();
+        for (int op_id = 0; op_id < num_operators; ++op_id) {
+            if (abstraction->operator_is_active(op_id)) {
+                active_operators.push_back(op_id);
+            }
+        }
+        active_operators_by_abstraction.push_back(move(active_operators));
+    }
+}
+
+vector<int> SaturatedCostsCache::get_active_costs(
+    int abstraction_id, const vector<int> &costs) const {
+    const vector<int> &active_operators =
+        active_operators_by_abstraction[abstraction_id];
+    vector<int> active_costs;
+    active_costs.reserve(active_operators.size());
+    for (int op_id : active_operators) {
+        active_costs.push_back(costs[op_id]);
+    }
+    return active_costs;
+}
+
+const CachedSaturation *SaturatedCostsCache::lookup(
+    int abstraction_id, int cap_state, const vector<int> &costs) {
+    vector<int> active_costs = get_active_costs(abstraction_id, costs);
+    const auto &entries = entries_by_abstraction[abstraction_id];
+    auto it = entries.find(utils::get_hash64(active_costs));
+    if (it != entries.end()) {
+        for (const Entry &entry : it->second) {
+            if (entry.cap_state == cap_state &&
+                entry.active_costs == active_costs) {
+                ++num_hits;
+                return &entry.saturation;
+            }
+        }
+    }
+    ++num_misses;
+    return nullptr;
+}
+
+const CachedSaturation &SaturatedCostsCache::insert(
+    int abstraction_id, int cap_state, const vector<int> &costs,
+    CachedSaturation &&saturation) {
+    vector<int> active_costs = get_active_costs(abstraction_id, costs);
+    int64_t num_values = active_costs.size() + saturation.h_values.size() +
+                         saturation.saturated_costs.size();
+    if (num_cached_values + num_values > max_cached_values) {
+        for (auto &entries : entries_by_abstraction) {
+            entries.clear();
+        }
+        num_cached_values = 0;
+        ++num_clears;
+    }
+    num_cached_values += num_values;
+    uint64_t hash = utils::get_hash64(active_costs);
+    vector<Entry> &bucket = entries_by_abstraction[abstraction_id][hash];
+    bucket.push_back({cap_state, move(active_costs), move(saturation)});
+    return bucket.back().saturation;
+}
+
+void SaturatedCostsCache::print_statistics() const {
+    utils::g_log << "Saturated costs cache: " << num_hits << " hits, "
+                 << num_misses << " misses, " << num_clears << " clears"
+                 << endl;
+}
+}
@@ -0,0 +1,69 @@
+#ifndef COST_SATURATION_SATURATED_COSTS_CACHE_H
+#define COST_SATURATION_SATURATED_COSTS_CACHE_H
+
+#include "types.h"
+
+#include "../utils/hash.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cost_saturation {
+struct CachedSaturation {
+    std::vector<int> h_values;
+    std::vector<int> saturated_costs;
+};
+
+/*
+  Memoize the goal distances and saturated costs that saturated cost
+  partitioning computes for a fixed collection of abstractions.
+
+  The goal distances of an abstraction only depend on the costs of the
+  operators that are active in it, and its saturated costs only depend on
+  the goal distances. Therefore, we store the results under the cost slice
+  restricted to the active operators. Orders that only differ in a few
+  positions (e.g., during hill climbing) often induce the same cost slices
+  for many abstractions, and for these we avoid running Dijkstra's
+  algorithm and computing saturated costs again.
+
+  Perim saturation caps the goal distances at the goal distance of a given
+  abstract state. The cap_state parameter holds this abstract state (or -1
+  if goal distances are not capped) and is part of the key.
+
+  If the cached vectors exceed the given number of integers, we clear the
+  cache.
+*/
+class SaturatedCostsCache {
+    struct Entry {
+        int cap_state;
+        std::vector<int> active_costs;
+        CachedSaturation saturation;
+    };
+
+    std::vector<std::vector<int>> active_operators_by_abstraction;
+    std::vector<utils::HashMap<uint64_t, std::vector<Entry>>>
+        entries_by_abstraction;
+    const int64_t max_cached_values;
+    int64_t num_cached_values;
+    int64_t num_hits;
+    int64_t num_misses;
+    int num_clears;
+
+    std::vector<int> get_active_costs(
+        int abstraction_id, const std::vector<int> &costs) const;
+public:
+    SaturatedCostsCache(
+        const Abstractions &abstractions, int64_t max_cached_values);
+
+    // Return nullptr if the result has not been cached.
+    const CachedSaturation *lookup(
+        int abstraction_id, int cap_state, const std::vector<int> &costs);
+    const CachedSaturation &insert(
+        int abstraction_id, int cap_state, const std::vector<int> &costs,
+        CachedSaturation &&saturation);
+
+    void print_statistics() const;
+};
+}
+
+#endif
@@ -15,6 +15,7 @@ class Abstraction;
 class AbstractionFunction;
 class AbstractionGenerator;
 class CostPartitioningHeuristic;
+class SaturatedCostsCache;
 
 // Positive infinity. The name "INFINITY" is taken by an ISO C99 macro.
 const int INF = std::numeric_limits<int>::max();
@@ -31,7 +32,7 @@ using AbstractionGenerators =
     std::vector<std::shared_ptr<AbstractionGenerator>>;
 using CPFunction = std::function<CostPartitioningHeuristic(
     const Abstractions &, const std::vector<int> &, std::vector<int> &,
-    const std::vector<int> &)>;
+    const std::vector<int> &, SaturatedCostsCache *)>;
 using CPHeuristics = std::vector<CostPartitioningHeuristic>;
 using DeadEnds = partial_state_tree::PartialStateTree;
 using Order = std::vector<int>;
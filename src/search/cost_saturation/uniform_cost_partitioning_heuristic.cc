@@ -12,6 +12,7 @@
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/math.h"
+#include "../utils/parallel.h"
 #include "../utils/rng_options.h"
 
 using namespace std;
@@ -61,15 +62,17 @@ static vector<int> divide_costs_among_remaining_abstractions(
 }
 
 static CostPartitioningHeuristic compute_uniform_cost_partitioning(
-    const Abstractions &abstractions, const vector<int> &costs, bool debug) {
+    const Abstractions &abstractions, const vector<int> &costs,
+    int num_threads, bool debug) {
     vector<int> divided_costs = divide_costs_among_remaining_abstractions(
         abstractions, get_default_order(abstractions.size()), costs, 0, debug);
 
+    vector<vector<int>> h_values_by_abstraction =
+        compute_goal_distances_for_abstractions(
+            abstractions, divided_costs, num_threads);
     CostPartitioningHeuristic cp_heuristic;
     for (size_t i = 0; i < abstractions.size(); ++i) {
-        vector<int> h_values =
-            abstractions[i]->compute_goal_distances(divided_costs);
-        cp_heuristic.add_h_values(i, move(h_values));
+        cp_heuristic.add_h_values(i, move(h_values_by_abstraction[i]));
     }
     return cp_heuristic;
 }
@@ -151,9 +154,11 @@ shared_ptr<AbstractTask> get_scaled_costs_task(
 }
 
 static CostPartitioningHeuristic get_ucp_heuristic(
-    const TaskProxy &task_proxy, const Abstractions &abstractions, bool debug) {
+    const TaskProxy &task_proxy, const Abstractions &abstractions,
+    int num_threads, bool debug) {
     vector<int> costs = task_properties::get_operator_costs(task_proxy);
-    return compute_uniform_cost_partitioning(abstractions, costs, debug);
+    return compute_uniform_cost_partitioning(
+        abstractions, costs, num_threads, debug);
 }
 
 static CPHeuristics get_oucp_heuristics(
@@ -165,7 +170,8 @@ static CPHeuristics get_oucp_heuristics(
         task_proxy, abstractions, costs,
         [debug](
             const Abstractions &abstractions_, const vector<int> &order,
-            vector<int> &remaining_costs, const vector<int> &) {
+            vector<int> &remaining_costs, const vector<int> &,
+            SaturatedCostsCache *) {
             return compute_opportunistic_uniform_cost_partitioning(
                 abstractions_, order, remaining_costs, debug);
         });
@@ -192,6 +198,15 @@ public:
             "recalculate uniform cost partitioning after each considered abstraction",
             "false");
         add_option<bool>("debug", "print debugging messages", "false");
+        utils::add_parallel_options_to_feature(*this);
+        document_note(
+            "Parallelism",
+            "With threads > 1, the non-opportunistic variant computes the "
+            "goal distances of the abstractions in parallel. The "
+            "opportunistic variant handles the abstractions sequentially, "
+            "since the costs for each abstraction depend on its "
+            "predecessors. The heuristic is the same for all numbers of "
+            "threads.");
     }
 
     virtual shared_ptr<MaxCostPartitioningHeuristic> create_component(
@@ -216,7 +231,8 @@ public:
                 debug);
         } else {
             cp_heuristics.push_back(get_ucp_heuristic(
-                scaled_costs_task_proxy, abstractions, debug));
+                scaled_costs_task_proxy, abstractions,
+                options.get<int>("threads"), debug));
         }
 
         return plugins::make_shared_from_arg_tuples<
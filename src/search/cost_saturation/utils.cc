@@ -11,6 +11,7 @@
 #include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 #include "../utils/rng_options.h"
 
 #include <cassert>
@@ -150,6 +151,27 @@ void reduce_costs(
     }
 }
 
+vector<vector<int>> compute_goal_distances_for_abstractions(
+    const Abstractions &abstractions, const vector<int> &costs,
+    int num_threads, vector<vector<int>> *saturated_costs_by_abstraction) {
+    int num_abstractions = abstractions.size();
+    vector<vector<int>> h_values_by_abstraction(num_abstractions);
+    if (saturated_costs_by_abstraction) {
+        saturated_costs_by_abstraction->assign(num_abstractions, {});
+    }
+    // Abstractions are immutable, so each thread can handle any of them.
+    utils::parallel_for(num_abstractions, num_threads, [&](int, int i) {
+        const Abstraction &abstraction = *abstractions[i];
+        h_values_by_abstraction[i] = abstraction.compute_goal_distances(costs);
+        if (saturated_costs_by_abstraction) {
+            (*saturated_costs_by_abstraction)[i] =
+                abstraction.compute_saturated_costs(
+                    h_values_by_abstraction[i]);
+        }
+    });
+    return h_values_by_abstraction;
+}
+
 bool use_explicit_transitions(
     TransitionSystemType transition_type, const TaskProxy &task_proxy) {
     if (transition_type == TransitionSystemType::EXPLICIT) {
@@ -192,6 +214,12 @@ void add_order_options(plugins::Feature &feature) {
     feature.add_option<int>(
         "samples", "number of samples for diversification", "1000",
         plugins::Bounds("1", "infinity"));
+    feature.add_option<int>(
+        "max_stored_samples",
+        "maximum number of samples kept in memory for diversification. If "
+        "fewer than the number of samples, reservoir sampling keeps a uniform "
+        "subset of all sampled states.",
+        "infinity", plugins::Bounds("1", "infinity"));
     feature.add_option<double>(
         "max_optimization_time",
         "maximum time in seconds for optimizing each order with hill climbing",
@@ -207,7 +235,8 @@ get_cp_heuristic_collection_generator_from_options(
         opts.get<shared_ptr<OrderGenerator>>("orders"),
         opts.get<int>("max_orders"), opts.get<int>("max_size"),
         opts.get<double>("max_time"), opts.get<bool>("diversify"),
-        opts.get<int>("samples"), opts.get<double>("max_optimization_time"),
+        opts.get<int>("samples"), opts.get<int>("max_stored_samples"),
+        opts.get<double>("max_optimization_time"),
         utils::get_rng_arguments_from_options(opts));
 }
 
@@ -68,6 +68,17 @@ std::vector<int> get_abstract_state_ids(
 extern void reduce_costs(
     std::vector<int> &remaining_costs, const std::vector<int> &saturated_costs);
 
+/*
+  Compute the goal distances of all abstractions under the same cost
+  function with num_threads threads. If saturated_costs_by_abstraction is
+  given, also compute the saturated costs of all abstractions. The result
+  is independent of the number of threads.
+*/
+extern std::vector<std::vector<int>> compute_goal_distances_for_abstractions(
+    const Abstractions &abstractions, const std::vector<int> &costs,
+    int num_threads,
+    std::vector<std::vector<int>> *saturated_costs_by_abstraction = nullptr);
+
 // Determine whether to use explicit transitions based on the transition type
 // and task properties. AUTO mode uses explicit transitions if the task has
 // conditional effects, implicit otherwise.
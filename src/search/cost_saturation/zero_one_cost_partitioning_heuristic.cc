@@ -6,31 +6,57 @@
 #include "utils.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/parallel.h"
 
 using namespace std;
 
 namespace cost_saturation {
+/*
+  Each abstraction sees the remaining costs of the operators that are not
+  active in any of its predecessors in the order and zero costs for all
+  other operators. Since the cost functions don't depend on goal distances,
+  we compute them upfront and evaluate the abstractions in parallel.
+*/
 static CostPartitioningHeuristic compute_zero_one_cost_partitioning(
     const vector<unique_ptr<Abstraction>> &abstractions,
-    const vector<int> &order, vector<int> &remaining_costs,
-    const vector<int> &) {
+    const vector<int> &order, vector<int> &remaining_costs, int num_threads) {
     assert(abstractions.size() == order.size());
-    bool debug = false;
+    int num_abstractions = order.size();
+    int num_operators = remaining_costs.size();
 
-    CostPartitioningHeuristic cp_heuristic;
-    for (int pos : order) {
-        const Abstraction &abstraction = *abstractions[pos];
-        if (debug) {
-            cout << "remaining costs: ";
-            print_indexed_vector(remaining_costs);
+    // Store the first position in the order in which an operator is active.
+    vector<int> first_active_position(num_operators, num_abstractions);
+    for (int pos = 0; pos < num_abstractions; ++pos) {
+        const Abstraction &abstraction = *abstractions[order[pos]];
+        for (int op_id = 0; op_id < num_operators; ++op_id) {
+            if (first_active_position[op_id] == num_abstractions &&
+                abstraction.operator_is_active(op_id)) {
+                first_active_position[op_id] = pos;
+            }
         }
-        cp_heuristic.add_h_values(
-            pos, abstraction.compute_goal_distances(remaining_costs));
-        for (size_t op_id = 0; op_id < remaining_costs.size(); ++op_id) {
-            if (abstraction.operator_is_active(op_id)) {
-                remaining_costs[op_id] = 0;
+    }
+
+    vector<vector<int>> h_values_by_position(num_abstractions);
+    utils::parallel_for(num_abstractions, num_threads, [&](int, int pos) {
+        vector<int> costs = remaining_costs;
+        for (int op_id = 0; op_id < num_operators; ++op_id) {
+            if (first_active_position[op_id] < pos) {
+                costs[op_id] = 0;
             }
         }
+        h_values_by_position[pos] =
+            abstractions[order[pos]]->compute_goal_distances(costs);
+    });
+
+    CostPartitioningHeuristic cp_heuristic;
+    for (int pos = 0; pos < num_abstractions; ++pos) {
+        cp_heuristic.add_h_values(
+            order[pos], move(h_values_by_position[pos]));
+    }
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        if (first_active_position[op_id] < num_abstractions) {
+            remaining_costs[op_id] = 0;
+        }
     }
     return cp_heuristic;
 }
@@ -43,12 +69,25 @@ public:
         document_title("Greedy zero-one cost partitioning");
         add_options_for_cost_partitioning_heuristic(*this, "gzocp");
         add_order_options(*this);
+        utils::add_parallel_options_to_feature(*this);
+        document_note(
+            "Parallelism",
+            "With threads > 1, the goal distances of the abstractions are "
+            "computed in parallel. The heuristic is the same for all numbers "
+            "of threads.");
     }
 
     virtual shared_ptr<MaxCostPartitioningHeuristic> create_component(
         const plugins::Options &options) const override {
+        int num_threads = options.get<int>("threads");
         return get_max_cp_heuristic(
-            options, compute_zero_one_cost_partitioning);
+            options, [num_threads](
+                         const Abstractions &abstractions,
+                         const vector<int> &order, vector<int> &remaining_costs,
+                         const vector<int> &, SaturatedCostsCache *) {
+                return compute_zero_one_cost_partitioning(
+                    abstractions, order, remaining_costs, num_threads);
+            });
     }
 };
 
@@ -380,13 +380,140 @@ double LandmarkCanonicalHeuristic::get_cost_partitioned_heuristic_value(
     return max_h;
 }
 
-LandmarkPhO::LandmarkPhO(
+LPBasedCostPartitioningAlgorithm::LPBasedCostPartitioningAlgorithm(
     const vector<int> &operator_costs, const LandmarkGraph &graph,
-    bool saturate, lp::LPSolverType solver_type)
+    lp::LPSolverType solver_type, bool incremental)
     : CostPartitioningAlgorithm(operator_costs, graph),
-      saturate(saturate),
+      num_lps_solved(0),
+      num_lp_iterations(0),
       lp_solver(solver_type),
+      incremental(incremental) {
+}
+
+void LPBasedCostPartitioningAlgorithm::load_incremental_lp(
+    vector<lp::LPConstraint> &&rows,
+    const function<pair<double, double>(const unordered_set<int> &)>
+        &get_column_coefficients) {
+    assert(incremental);
+    int num_landmarks = landmark_graph.get_num_landmarks();
+    int num_cols = 2 * num_landmarks;
+    // All columns are closed initially.
+    named_vector::NamedVector<lp::LPVariable> lp_variables;
+    lp_variables.resize(num_cols, lp::LPVariable(0.0, 0.0, 0.0));
+    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
+        const Landmark &landmark =
+            landmark_graph.get_node(lm_id)->get_landmark();
+        for (bool past : {false, true}) {
+            const unordered_set<int> &achievers = get_achievers(landmark, past);
+            /*
+              Columns without achievers are never opened because the
+              corresponding states are dead ends.
+            */
+            if (achievers.empty()) {
+                continue;
+            }
+            int col = get_column(lm_id, past);
+            auto [objective_coefficient, matrix_coefficient] =
+                get_column_coefficients(achievers);
+            lp_variables[col].objective_coefficient = objective_coefficient;
+            for (int op_id : achievers) {
+                assert(utils::in_bounds(op_id, rows));
+                rows[op_id].insert(col, matrix_coefficient);
+            }
+        }
+    }
+
+    // Only keep non-empty constraints (see issue443).
+    named_vector::NamedVector<lp::LPConstraint> lp_constraints;
+    for (lp::LPConstraint &row : rows) {
+        if (!row.empty()) {
+            lp_constraints.push_back(move(row));
+        }
+    }
+    rows.clear();
+
+    lp_solver.load_problem(lp::LinearProgram(
+        lp::LPObjectiveSense::MAXIMIZE, move(lp_variables),
+        move(lp_constraints), lp_solver.get_infinity()));
+    column_is_open.assign(num_cols, false);
+}
+
+double LPBasedCostPartitioningAlgorithm::solve_incremental_lp(
+    const LandmarkStatusManager &lm_status_manager,
+    const State &ancestor_state) {
+    assert(incremental);
+    const ConstBitsetView past =
+        lm_status_manager.get_past_landmarks(ancestor_state);
+    const ConstBitsetView future =
+        lm_status_manager.get_future_landmarks(ancestor_state);
+    /*
+      The column of a landmark matching its status is open if the landmark
+      still has to be reached (again); all other columns are closed. We only
+      pass the bounds that differ from the previous LP to the LP solver.
+    */
+    int num_landmarks = landmark_graph.get_num_landmarks();
+    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
+        bool is_future = future.test(lm_id);
+        bool is_past = past.test(lm_id);
+        const Landmark &landmark =
+            landmark_graph.get_node(lm_id)->get_landmark();
+        if (is_future && get_achievers(landmark, is_past).empty()) {
+            return numeric_limits<double>::max();
+        }
+        for (bool past_column : {false, true}) {
+            int col = get_column(lm_id, past_column);
+            bool open = is_future && is_past == past_column;
+            if (open != column_is_open[col]) {
+                lp_solver.set_variable_upper_bound(
+                    col, open ? lp_solver.get_infinity() : 0.0);
+                column_is_open[col] = open;
+            }
+        }
+    }
+    return solve_lp();
+}
+
+double LPBasedCostPartitioningAlgorithm::solve_lp() {
+    lp_solver.solve();
+    ++num_lps_solved;
+    num_lp_iterations += lp_solver.get_num_iterations();
+
+    assert(lp_solver.has_optimal_solution());
+    return lp_solver.get_objective_value();
+}
+
+void LPBasedCostPartitioningAlgorithm::print_statistics(
+    utils::LogProxy &log) const {
+    if (log.is_at_least_normal()) {
+        double iterations_per_lp =
+            num_lps_solved ? static_cast<double>(num_lp_iterations) /
+                                 num_lps_solved
+                           : 0.0;
+        log << "Landmark LPs solved: " << num_lps_solved << endl;
+        log << "Landmark LP iterations: " << num_lp_iterations << endl;
+        log << "Landmark LP iterations per LP: " << iterations_per_lp << endl;
+    }
+}
+
+LandmarkPhO::LandmarkPhO(
+    const vector<int> &operator_costs, const LandmarkGraph &graph,
+    bool saturate, lp::LPSolverType solver_type, bool incremental)
+    : LPBasedCostPartitioningAlgorithm(
+          operator_costs, graph, solver_type, incremental),
+      saturate(saturate),
       lp(build_initial_lp()) {
+    if (incremental) {
+        /*
+          The objective coefficient of a column is the cost of the cheapest
+          operator with an entry in the column. The saturated costs are equal
+          to this cost.
+        */
+        load_incremental_lp(
+            move(lp_constraints), [this](const unordered_set<int> &achievers) {
+                double cost = compute_min_cost(achievers);
+                return make_pair(cost, this->saturate ? cost : 1.0);
+            });
+    }
 }
 
 lp::LinearProgram LandmarkPhO::build_initial_lp() {
@@ -425,8 +552,11 @@ double LandmarkPhO::compute_landmark_cost(
     /* Note that there are landmarks without achievers. Example: not-served(p)
        in miconic:s1-0.pddl. The fact is true in the initial state, and no
        operator achieves it. For such facts, the (infimum) cost is infinity. */
-    const unordered_set<int> &achievers =
-        get_achievers(lm.get_landmark(), past);
+    return compute_min_cost(get_achievers(lm.get_landmark(), past));
+}
+
+double LandmarkPhO::compute_min_cost(
+    const unordered_set<int> &achievers) const {
     double min_cost = lp_solver.get_infinity();
     for (int op_id : achievers) {
         assert(utils::in_bounds(op_id, operator_costs));
@@ -438,6 +568,9 @@ double LandmarkPhO::compute_landmark_cost(
 double LandmarkPhO::get_cost_partitioned_heuristic_value(
     const LandmarkStatusManager &lm_status_manager,
     const State &ancestor_state) {
+    if (incremental) {
+        return solve_incremental_lp(lm_status_manager, ancestor_state);
+    }
     const ConstBitsetView past =
         lm_status_manager.get_past_landmarks(ancestor_state);
     const ConstBitsetView future =
@@ -505,18 +638,20 @@ double LandmarkPhO::get_cost_partitioned_heuristic_value(
     lp_solver.load_problem(lp);
 
     // Solve the linear program.
-    lp_solver.solve();
-
-    assert(lp_solver.has_optimal_solution());
-    return lp_solver.get_objective_value();
+    return solve_lp();
 }
 
 OptimalCostPartitioningAlgorithm::OptimalCostPartitioningAlgorithm(
     const vector<int> &operator_costs, const LandmarkGraph &graph,
-    lp::LPSolverType solver_type)
-    : CostPartitioningAlgorithm(operator_costs, graph),
-      lp_solver(solver_type),
+    lp::LPSolverType solver_type, bool incremental)
+    : LPBasedCostPartitioningAlgorithm(
+          operator_costs, graph, solver_type, incremental),
       lp(build_initial_lp()) {
+    if (incremental) {
+        load_incremental_lp(
+            move(lp_constraints),
+            [](const unordered_set<int> &) { return make_pair(1.0, 1.0); });
+    }
 }
 
 lp::LinearProgram OptimalCostPartitioningAlgorithm::build_initial_lp() {
@@ -616,6 +751,10 @@ double OptimalCostPartitioningAlgorithm::get_cost_partitioned_heuristic_value(
     /* TODO: We could also do the same thing with action landmarks we do in the
         uniform cost partitioning case. */
 
+    if (incremental) {
+        return solve_incremental_lp(landmark_status_manager, ancestor_state);
+    }
+
     ConstBitsetView past =
         landmark_status_manager.get_past_landmarks(ancestor_state);
     ConstBitsetView future =
@@ -639,9 +778,6 @@ double OptimalCostPartitioningAlgorithm::get_cost_partitioned_heuristic_value(
     }
 
     lp_solver.load_problem(lp);
-    lp_solver.solve();
-
-    assert(lp_solver.has_optimal_solution());
-    return lp_solver.get_objective_value();
+    return solve_lp();
 }
 }
@@ -6,6 +6,8 @@
 
 #include "../lp/lp_solver.h"
 
+#include <cstdint>
+#include <functional>
 #include <unordered_set>
 #include <vector>
 
@@ -17,6 +19,7 @@ enum class ScoringFunction;
 }
 
 namespace utils {
+class LogProxy;
 class RandomNumberGenerator;
 }
 
@@ -38,6 +41,9 @@ public:
     virtual double get_cost_partitioned_heuristic_value(
         const LandmarkStatusManager &lm_status_manager,
         const State &ancestor_state) = 0;
+
+    virtual void print_statistics(utils::LogProxy &) const {
+    }
 };
 
 class UniformCostPartitioningAlgorithm : public CostPartitioningAlgorithm {
@@ -103,28 +109,83 @@ public:
         const State &ancestor_state) override;
 };
 
-class LandmarkPhO : public CostPartitioningAlgorithm {
+/*
+  Common base class for the cost partitioning algorithms that solve an LP with
+  one inequality (row) per operator in each state.
+
+  Without incremental mode, the LP has one variable (column) per landmark and
+  the constraint matrix is rebuilt and loaded into the LP solver for each state.
+
+  In incremental mode, the LP has two columns per landmark: the first one has
+  a non-zero entry for each first achiever of the landmark and is used while
+  the landmark has not been reached, the second one has a non-zero entry for
+  each possible achiever and is used when the landmark needs to be reached
+  again. This matrix is loaded into the LP solver only once. For each state,
+  we only change the upper bounds of the columns that need to be opened or
+  closed compared to the previously solved LP. Since the matrix and the
+  objective stay the same, the LP solver reoptimizes from the optimal basis
+  of the previous LP instead of solving the LP from scratch.
+*/
+class LPBasedCostPartitioningAlgorithm : public CostPartitioningAlgorithm {
+    // Columns with infinite upper bound in the LP loaded in incremental mode.
+    std::vector<bool> column_is_open;
+
+    int num_lps_solved;
+    int64_t num_lp_iterations;
+protected:
+    lp::LPSolver lp_solver;
+    const bool incremental;
+
+    static int get_column(int lm_id, bool past) {
+        return 2 * lm_id + (past ? 1 : 0);
+    }
+
+    /*
+      Build and load the LP for the incremental mode. The given rows define
+      the bounds of the operator constraints and must be empty. The function
+      returns the objective coefficient and the matrix coefficient of a
+      column, given the set of operators that have an entry in the column.
+    */
+    void load_incremental_lp(
+        std::vector<lp::LPConstraint> &&rows,
+        const std::function<std::pair<double, double>(
+            const std::unordered_set<int> &)> &get_column_coefficients);
+    double solve_incremental_lp(
+        const LandmarkStatusManager &lm_status_manager,
+        const State &ancestor_state);
+
+    // Solve the loaded LP and return its objective value.
+    double solve_lp();
+public:
+    LPBasedCostPartitioningAlgorithm(
+        const std::vector<int> &operator_costs, const LandmarkGraph &graph,
+        lp::LPSolverType solver_type, bool incremental);
+
+    virtual void print_statistics(utils::LogProxy &log) const override;
+};
+
+class LandmarkPhO : public LPBasedCostPartitioningAlgorithm {
     // See comment for OptimalCostPartitioningAlgorithm.
     const bool saturate;
-    lp::LPSolver lp_solver;
     std::vector<lp::LPConstraint> lp_constraints;
     lp::LinearProgram lp;
 
     lp::LinearProgram build_initial_lp();
 
     double compute_landmark_cost(const LandmarkNode &lm, bool past) const;
+    double compute_min_cost(const std::unordered_set<int> &achievers) const;
 public:
     LandmarkPhO(
         const std::vector<int> &operator_costs, const LandmarkGraph &graph,
-        bool saturate, lp::LPSolverType solver_type);
+        bool saturate, lp::LPSolverType solver_type, bool incremental);
 
     virtual double get_cost_partitioned_heuristic_value(
         const LandmarkStatusManager &lm_status_manager,
         const State &ancestor_state) override;
 };
 
-class OptimalCostPartitioningAlgorithm : public CostPartitioningAlgorithm {
-    lp::LPSolver lp_solver;
+class OptimalCostPartitioningAlgorithm
+    : public LPBasedCostPartitioningAlgorithm {
     /* We keep an additional copy of the constraints around to avoid
        some effort with recreating the vector (see issue443). */
     std::vector<lp::LPConstraint> lp_constraints;
@@ -143,7 +204,7 @@ class OptimalCostPartitioningAlgorithm : public CostPartitioningAlgorithm {
 public:
     OptimalCostPartitioningAlgorithm(
         const std::vector<int> &operator_costs, const LandmarkGraph &graph,
-        lp::LPSolverType solver_type);
+        lp::LPSolverType solver_type, bool incremental);
 
     virtual double get_cost_partitioned_heuristic_value(
         const LandmarkStatusManager &landmark_status_manager,
@@ -21,7 +21,7 @@ LandmarkCostPartitioningHeuristic::LandmarkCostPartitioningHeuristic(
     bool prog_gn, bool prog_r, const shared_ptr<AbstractTask> &transform,
     bool cache_estimates, const string &description, utils::Verbosity verbosity,
     CostPartitioningMethod cost_partitioning, bool alm,
-    lp::LPSolverType lpsolver,
+    lp::LPSolverType lpsolver, bool incremental_lp,
     cost_saturation::ScoringFunction scoring_function, int random_seed)
     : LandmarkHeuristic(
           pref, transform, cache_estimates, description, verbosity) {
@@ -31,7 +31,12 @@ LandmarkCostPartitioningHeuristic::LandmarkCostPartitioningHeuristic(
     check_unsupported_features(lm_factory);
     initialize(lm_factory, prog_goal, prog_gn, prog_r);
     set_cost_partitioning_algorithm(
-        cost_partitioning, lpsolver, alm, scoring_function, random_seed);
+        cost_partitioning, lpsolver, incremental_lp, alm, scoring_function,
+        random_seed);
+}
+
+LandmarkCostPartitioningHeuristic::~LandmarkCostPartitioningHeuristic() {
+    cost_partitioning_algorithm->print_statistics(log);
 }
 
 void LandmarkCostPartitioningHeuristic::check_unsupported_features(
@@ -51,14 +56,14 @@ void LandmarkCostPartitioningHeuristic::check_unsupported_features(
 
 void LandmarkCostPartitioningHeuristic::set_cost_partitioning_algorithm(
     CostPartitioningMethod cost_partitioning, lp::LPSolverType lpsolver,
-    bool use_action_landmarks,
+    bool incremental_lp, bool use_action_landmarks,
     cost_saturation::ScoringFunction scoring_function, int random_seed) {
     vector<int> operator_costs =
         task_properties::get_operator_costs(task_proxy);
     if (cost_partitioning == CostPartitioningMethod::OPTIMAL) {
         cost_partitioning_algorithm =
             make_unique<OptimalCostPartitioningAlgorithm>(
-                operator_costs, *landmark_graph, lpsolver);
+                operator_costs, *landmark_graph, lpsolver, incremental_lp);
     } else if (cost_partitioning == CostPartitioningMethod::CANONICAL) {
         cost_partitioning_algorithm = make_unique<LandmarkCanonicalHeuristic>(
             operator_costs, *landmark_graph);
@@ -68,7 +73,8 @@ void LandmarkCostPartitioningHeuristic::set_cost_partitioning_algorithm(
         bool saturated =
             cost_partitioning == CostPartitioningMethod::SATURATED_PHO;
         cost_partitioning_algorithm = make_unique<LandmarkPhO>(
-            operator_costs, *landmark_graph, saturated, lpsolver);
+            operator_costs, *landmark_graph, saturated, lpsolver,
+            incremental_lp);
     } else {
         bool reuse_costs = false;
         bool greedy = false;
@@ -159,6 +165,12 @@ public:
             "uniform");
         add_option<bool>("alm", "use action landmarks", "true");
         lp::add_lp_solver_option_to_feature(*this);
+        add_option<bool>(
+            "incremental_lp",
+            "keep the LP of the LP-based cost partitionings loaded in the LP "
+            "solver and only change variable bounds between states (see "
+            "note below)",
+            "true");
         cost_saturation::add_scoring_function_to_feature(*this);
         utils::add_rng_options_to_feature(*this);
 
@@ -181,6 +193,16 @@ public:
             "To use ``cost_partitioning=optimal``, you must build the "
             "planner with LP support. See "
             "[build instructions https://github.com/aibasel/downward/blob/main/BUILD.md].");
+        document_note(
+            "Incremental LPs",
+            "With ``incremental_lp=true``, the cost partitionings "
+            "``optimal``, ``pho`` and ``saturated_pho`` use an LP with two "
+            "variables per landmark, one for its first achievers and one for "
+            "its possible achievers. The LP is loaded into the LP solver once "
+            "and for each state only the bounds of the variables whose "
+            "landmark status differs from the previous LP are changed. The LP "
+            "solver then starts from the optimal basis of the previous LP. "
+            "The heuristic values are the same in both modes.");
         document_note(
             "Preferred operators",
             "Preferred operators should not be used for optimal planning. See "
@@ -209,6 +231,7 @@ public:
             opts.get<CostPartitioningMethod>("cost_partitioning"),
             opts.get<bool>("alm"),
             lp::get_lp_solver_arguments_from_options(opts),
+            opts.get<bool>("incremental_lp"),
             opts.get<cost_saturation::ScoringFunction>("scoring_function"),
             utils::get_rng_arguments_from_options(opts));
     }
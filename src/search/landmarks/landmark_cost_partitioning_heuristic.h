@@ -30,7 +30,7 @@ class LandmarkCostPartitioningHeuristic : public LandmarkHeuristic {
         const std::shared_ptr<LandmarkFactory> &landmark_factory);
     void set_cost_partitioning_algorithm(
         CostPartitioningMethod cost_partitioning, lp::LPSolverType lpsolver,
-        bool use_action_landmarks,
+        bool incremental_lp, bool use_action_landmarks,
         cost_saturation::ScoringFunction scoring_function, int random_seed);
 
     int get_heuristic_value(const State &ancestor_state) override;
@@ -41,8 +41,9 @@ public:
         const std::shared_ptr<AbstractTask> &transform, bool cache_estimates,
         const std::string &description, utils::Verbosity verbosity,
         CostPartitioningMethod cost_partitioning, bool alm,
-        lp::LPSolverType lpsolver,
+        lp::LPSolverType lpsolver, bool incremental_lp,
         cost_saturation::ScoringFunction scoring_function, int random_seed);
+    virtual ~LandmarkCostPartitioningHeuristic() override;
 
     virtual bool dead_ends_are_reliable() const override;
 };
@@ -5,6 +5,7 @@
 
 #include "../utils/logging.h"
 
+#include <unordered_set>
 #include <vector>
 
 class TaskProxy;
@@ -59,6 +60,11 @@ public:
 
     virtual bool supports_conditional_effects() const = 0;
 
+    // Add all factories that this factory uses, directly or indirectly.
+    virtual void get_nested_factories(
+        std::unordered_set<const LandmarkFactory *> &) const {
+    }
+
     bool achievers_are_calculated() const {
         return achievers_calculated;
     }
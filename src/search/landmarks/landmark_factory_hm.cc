@@ -10,6 +10,7 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <numeric>
@@ -449,9 +450,7 @@ Propositions LandmarkFactoryHM::initialize_preconditions(
 
     for (const Propositions &subset : subsets) {
         assert(set_indices.contains(subset));
-        int set_index = set_indices[subset];
-        pm_op.precondition.push_back(set_index);
-        hm_table[set_index].triggered_operators.emplace_back(op.get_id(), -1);
+        pm_op.precondition.push_back(set_indices.at(subset));
     }
     return precondition;
 }
@@ -466,36 +465,31 @@ Propositions LandmarkFactoryHM::initialize_postconditions(
 
     for (const Propositions &subset : subsets) {
         assert(set_indices.contains(subset));
-        int set_index = set_indices[subset];
-        pm_op.effect.push_back(set_index);
+        pm_op.effect.push_back(set_indices.at(subset));
     }
     return postcondition;
 }
 
 vector<int> LandmarkFactoryHM::compute_noop_precondition(
-    const vector<Propositions> &preconditions, int op_id, int noop_index) {
+    const vector<Propositions> &preconditions) const {
     vector<int> noop_condition;
     noop_condition.reserve(preconditions.size());
     for (const auto &subset : preconditions) {
         assert(static_cast<int>(subset.size()) <= m);
         assert(set_indices.contains(subset));
-        int set_index = set_indices[subset];
-        noop_condition.push_back(set_index);
-        // These propositions are "conditional preconditions" for this operator.
-        hm_table[set_index].triggered_operators.emplace_back(op_id, noop_index);
+        noop_condition.push_back(set_indices.at(subset));
     }
     return noop_condition;
 }
 
 vector<int> LandmarkFactoryHM::compute_noop_effect(
-    const vector<Propositions> &postconditions) {
+    const vector<Propositions> &postconditions) const {
     vector<int> noop_effect;
     noop_effect.reserve(postconditions.size());
     for (const auto &subset : postconditions) {
         assert(static_cast<int>(subset.size()) <= m);
         assert(set_indices.contains(subset));
-        int set_index = set_indices[subset];
-        noop_effect.push_back(set_index);
+        noop_effect.push_back(set_indices.at(subset));
     }
     return noop_effect;
 }
@@ -504,8 +498,6 @@ void LandmarkFactoryHM::add_conditional_noop(
     PiMOperator &pm_op, int op_id, const VariablesProxy &variables,
     const Propositions &propositions, const Propositions &preconditions,
     const Propositions &postconditions) {
-    int noop_index = static_cast<int>(pm_op.conditional_noops.size());
-
     /*
       Get the subsets that have >= 1 element in the precondition (unless
       the precondition is empty) or the postcondition and >= 1 element
@@ -518,8 +510,8 @@ void LandmarkFactoryHM::add_conditional_noop(
 
     num_unsatisfied_preconditions[op_id].second.push_back(
         static_cast<int>(noop_preconditions_subsets.size()));
-    vector<int> noop_condition = compute_noop_precondition(
-        noop_preconditions_subsets, op_id, noop_index);
+    vector<int> noop_condition =
+        compute_noop_precondition(noop_preconditions_subsets);
     vector<int> noop_effect = compute_noop_effect(noop_postconditions_subsets);
     pm_op.conditional_noops.emplace_back(
         move(noop_condition), move(noop_effect));
@@ -550,6 +542,21 @@ void LandmarkFactoryHM::initialize_noops(
     pm_op.conditional_noops.shrink_to_fit();
 }
 
+void LandmarkFactoryHM::add_triggered_operators(const PiMOperator &pm_op) {
+    for (int set_index : pm_op.precondition) {
+        hm_table[set_index].triggered_operators.emplace_back(pm_op.id, -1);
+    }
+    int num_noops = static_cast<int>(pm_op.conditional_noops.size());
+    for (int noop_index = 0; noop_index < num_noops; ++noop_index) {
+        // These propositions are "conditional preconditions" for this operator.
+        for (int set_index :
+             pm_op.conditional_noops[noop_index].effect_condition) {
+            hm_table[set_index].triggered_operators.emplace_back(
+                pm_op.id, noop_index);
+        }
+    }
+}
+
 void LandmarkFactoryHM::build_pm_operators(const TaskProxy &task_proxy) {
     OperatorsProxy operators = task_proxy.get_operators();
     int num_operators = static_cast<int>(operators.size());
@@ -558,30 +565,41 @@ void LandmarkFactoryHM::build_pm_operators(const TaskProxy &task_proxy) {
 
     VariablesProxy variables = task_proxy.get_variables();
 
-    /* Transfer operators from original problem.
-       Represent noops as conditional effects. */
-    for (int i = 0; i < num_operators; ++i) {
-        const OperatorProxy &op = operators[i];
-        PiMOperator &pm_op = pm_operators[op.get_id()];
+    /*
+      Transfer operators from original problem. Represent noops as
+      conditional effects. Computing the P^m operators only reads the set
+      indices and writes to the entries of the respective operator, so we
+      can compile the operators in parallel.
+    */
+    utils::parallel_for(num_operators, num_threads, [&](int, int i) {
+        const OperatorProxy op = operators[i];
+        PiMOperator &pm_op = pm_operators[i];
         pm_op.id = i;
 
         Propositions preconditions =
             initialize_preconditions(variables, op, pm_op);
         Propositions postconditions =
             initialize_postconditions(variables, op, pm_op);
-        initialize_noops(
-            variables, pm_op, op.get_id(), preconditions, postconditions);
+        initialize_noops(variables, pm_op, i, preconditions, postconditions);
+    });
+
+    /* The P^m propositions are shared between operators. Link them to the
+       operators they trigger in operator order to obtain the same result for
+       all numbers of threads. */
+    for (const PiMOperator &pm_op : pm_operators) {
+        add_triggered_operators(pm_op);
         print_pm_operator(variables, pm_op);
     }
 }
 
 LandmarkFactoryHM::LandmarkFactoryHM(
-    int m, bool conjunctive_landmarks, bool use_orders,
+    int m, bool conjunctive_landmarks, bool use_orders, int num_threads,
     utils::Verbosity verbosity)
     : LandmarkFactory(verbosity),
       m(m),
       conjunctive_landmarks(conjunctive_landmarks),
-      use_orders(use_orders) {
+      use_orders(use_orders),
+      num_threads(num_threads) {
 }
 
 void LandmarkFactoryHM::initialize_hm_table(const VariablesProxy &variables) {
@@ -1064,10 +1082,17 @@ public:
         add_option<bool>(
             "conjunctive_landmarks", "keep conjunctive landmarks", "true");
         add_use_orders_option_to_feature(*this);
+        utils::add_parallel_options_to_feature(*this);
         add_landmark_factory_options_to_feature(*this);
 
         document_language_support(
             "conditional_effects", "ignored, i.e. not supported");
+        document_note(
+            "Parallelism",
+            "With threads > 1, the P^m operators are compiled in parallel. "
+            "The fixpoint computation stays sequential because its result "
+            "depends on the order in which operators are processed. The "
+            "landmark graph is the same for all numbers of threads.");
     }
 
     virtual shared_ptr<LandmarkFactoryHM> create_component(
@@ -1075,6 +1100,7 @@ public:
         return plugins::make_shared_from_arg_tuples<LandmarkFactoryHM>(
             opts.get<int>("m"), opts.get<bool>("conjunctive_landmarks"),
             get_use_orders_arguments_from_options(opts),
+            utils::get_parallel_arguments_from_options(opts),
             get_landmark_factory_arguments_from_options(opts));
     }
 };
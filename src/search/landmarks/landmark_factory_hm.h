@@ -81,6 +81,7 @@ class LandmarkFactoryHM : public LandmarkFactory {
     const int m;
     const bool conjunctive_landmarks;
     const bool use_orders;
+    const int num_threads;
 
     std::unordered_map<int, LandmarkNode *> landmark_nodes;
 
@@ -141,10 +142,9 @@ class LandmarkFactoryHM : public LandmarkFactory {
         const VariablesProxy &variables, const OperatorProxy &op,
         PiMOperator &pm_op);
     std::vector<int> compute_noop_precondition(
-        const std::vector<Propositions> &preconditions, int op_id,
-        int noop_index);
+        const std::vector<Propositions> &preconditions) const;
     std::vector<int> compute_noop_effect(
-        const std::vector<Propositions> &postconditions);
+        const std::vector<Propositions> &postconditions) const;
     void add_conditional_noop(
         PiMOperator &pm_op, int op_id, const VariablesProxy &variables,
         const Propositions &propositions, const Propositions &preconditions,
@@ -152,6 +152,7 @@ class LandmarkFactoryHM : public LandmarkFactory {
     void initialize_noops(
         const VariablesProxy &variables, PiMOperator &pm_op, int op_id,
         const Propositions &preconditions, const Propositions &postconditions);
+    void add_triggered_operators(const PiMOperator &pm_op);
     void build_pm_operators(const TaskProxy &task_proxy);
 
     void postprocess(const TaskProxy &task_proxy);
@@ -233,7 +234,7 @@ class LandmarkFactoryHM : public LandmarkFactory {
 
 public:
     LandmarkFactoryHM(
-        int m, bool conjunctive_landmarks, bool use_orders,
+        int m, bool conjunctive_landmarks, bool use_orders, int num_threads,
         utils::Verbosity verbosity);
 
     virtual bool supports_conditional_effects() const override;
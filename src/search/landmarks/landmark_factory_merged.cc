@@ -6,8 +6,11 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/component_errors.h"
+#include "../utils/parallel.h"
 
 #include <ranges>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace std;
 using utils::ExitCode;
@@ -16,10 +19,39 @@ namespace landmarks {
 class LandmarkNode;
 
 LandmarkFactoryMerged::LandmarkFactoryMerged(
-    const vector<shared_ptr<LandmarkFactory>> &lm_factories,
+    const vector<shared_ptr<LandmarkFactory>> &lm_factories, int num_threads,
     utils::Verbosity verbosity)
-    : LandmarkFactory(verbosity), landmark_factories(lm_factories) {
+    : LandmarkFactory(verbosity),
+      landmark_factories(lm_factories),
+      num_threads(num_threads) {
     utils::verify_list_not_empty(lm_factories, "lm_factories");
+    if (num_threads > 1) {
+        verify_no_shared_nested_factories();
+    }
+}
+
+/*
+  Each distinct factory computes its landmark graph in its own thread. If
+  two of them used the same nested factory, both threads would compute and
+  cache the graph of the nested factory at the same time.
+*/
+void LandmarkFactoryMerged::verify_no_shared_nested_factories() const {
+    unordered_set<const LandmarkFactory *> direct_factories;
+    for (const shared_ptr<LandmarkFactory> &landmark_factory :
+         landmark_factories) {
+        direct_factories.insert(landmark_factory.get());
+    }
+    unordered_set<const LandmarkFactory *> used_factories;
+    for (const LandmarkFactory *factory : direct_factories) {
+        unordered_set<const LandmarkFactory *> factories = {factory};
+        factory->get_nested_factories(factories);
+        for (const LandmarkFactory *used_factory : factories) {
+            utils::verify_argument(
+                used_factories.insert(used_factory).second,
+                "With threads > 1, the factories given to lm_merged must not "
+                "share nested factories.");
+        }
+    }
 }
 
 LandmarkNode *LandmarkFactoryMerged::get_matching_landmark(
@@ -50,13 +82,38 @@ LandmarkNode *LandmarkFactoryMerged::get_matching_landmark(
 vector<shared_ptr<LandmarkGraph>>
 LandmarkFactoryMerged::generate_landmark_graphs_of_subfactories(
     const shared_ptr<AbstractTask> &task) {
+    /*
+      A factory caches its landmark graph, so computing the graph of the same
+      factory in two threads would be a data race. We therefore compute the
+      graph of each distinct factory exactly once.
+    */
+    vector<LandmarkFactory *> unique_factories;
+    unordered_map<LandmarkFactory *, int> factory_indices;
+    for (const shared_ptr<LandmarkFactory> &landmark_factory :
+         landmark_factories) {
+        LandmarkFactory *factory = landmark_factory.get();
+        int index = static_cast<int>(unique_factories.size());
+        if (factory_indices.emplace(factory, index).second) {
+            unique_factories.push_back(factory);
+        }
+    }
+
+    // Sub-factories are independent, so we can compute them concurrently.
+    vector<shared_ptr<LandmarkGraph>> unique_graphs(unique_factories.size());
+    utils::parallel_for(
+        unique_factories.size(), num_threads, [&](int, int factory_id) {
+            unique_graphs[factory_id] =
+                unique_factories[factory_id]->compute_landmark_graph(task);
+        });
+
+    // Merge in the order of the factories given by the user.
     vector<shared_ptr<LandmarkGraph>> landmark_graphs;
     landmark_graphs.reserve(landmark_factories.size());
     achievers_calculated = true;
     for (const shared_ptr<LandmarkFactory> &landmark_factory :
          landmark_factories) {
         landmark_graphs.push_back(
-            landmark_factory->compute_landmark_graph(task));
+            unique_graphs[factory_indices[landmark_factory.get()]]);
         achievers_calculated &= landmark_factory->achievers_are_calculated();
     }
     return landmark_graphs;
@@ -163,6 +220,15 @@ void LandmarkFactoryMerged::postprocess() {
     landmark_graph->set_landmark_ids();
 }
 
+void LandmarkFactoryMerged::get_nested_factories(
+    unordered_set<const LandmarkFactory *> &factories) const {
+    for (const shared_ptr<LandmarkFactory> &landmark_factory :
+         landmark_factories) {
+        factories.insert(landmark_factory.get());
+        landmark_factory->get_nested_factories(factories);
+    }
+}
+
 bool LandmarkFactoryMerged::supports_conditional_effects() const {
     return ranges::all_of(
         landmark_factories,
@@ -180,6 +246,7 @@ public:
             "Merges the landmarks and orderings from the parameter landmarks");
 
         add_list_option<shared_ptr<LandmarkFactory>>("lm_factories");
+        utils::add_parallel_options_to_feature(*this);
         add_landmark_factory_options_to_feature(*this);
 
         document_note(
@@ -189,6 +256,14 @@ public:
             "(gn > nat > reas > o_reas). ");
         document_note(
             "Note", "Does not currently support conjunctive landmarks");
+        document_note(
+            "Parallelism",
+            "With threads > 1, the landmark graphs of the given factories are "
+            "computed concurrently and merged in the given order afterwards, "
+            "so the result does not depend on the number of threads. The "
+            "given factories must not share nested factories in this case "
+            "(this is checked when the factory is created). "
+            "The log output of the factories may be interleaved.");
 
         document_language_support(
             "conditional_effects", "supported if all components support them");
@@ -198,6 +273,7 @@ public:
         const plugins::Options &opts) const override {
         return plugins::make_shared_from_arg_tuples<LandmarkFactoryMerged>(
             opts.get_list<shared_ptr<LandmarkFactory>>("lm_factories"),
+            utils::get_parallel_arguments_from_options(opts),
             get_landmark_factory_arguments_from_options(opts));
     }
 };
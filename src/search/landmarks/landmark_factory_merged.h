@@ -8,6 +8,7 @@
 namespace landmarks {
 class LandmarkFactoryMerged : public LandmarkFactory {
     std::vector<std::shared_ptr<LandmarkFactory>> landmark_factories;
+    const int num_threads;
 
     std::vector<std::shared_ptr<LandmarkGraph>>
     generate_landmark_graphs_of_subfactories(
@@ -24,12 +25,16 @@ class LandmarkFactoryMerged : public LandmarkFactory {
         const std::shared_ptr<AbstractTask> &task) override;
     void postprocess();
     LandmarkNode *get_matching_landmark(const Landmark &landmark) const;
+    void verify_no_shared_nested_factories() const;
 public:
     LandmarkFactoryMerged(
         const std::vector<std::shared_ptr<LandmarkFactory>> &lm_factories,
-        utils::Verbosity verbosity);
+        int num_threads, utils::Verbosity verbosity);
 
     virtual bool supports_conditional_effects() const override;
+    virtual void get_nested_factories(
+        std::unordered_set<const LandmarkFactory *> &factories)
+        const override;
 };
 }
 
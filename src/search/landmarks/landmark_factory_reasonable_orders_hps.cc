@@ -377,6 +377,12 @@ bool LandmarkFactoryReasonableOrdersHPS::supports_conditional_effects() const {
     return landmark_factory->supports_conditional_effects();
 }
 
+void LandmarkFactoryReasonableOrdersHPS::get_nested_factories(
+    unordered_set<const LandmarkFactory *> &factories) const {
+    factories.insert(landmark_factory.get());
+    landmark_factory->get_nested_factories(factories);
+}
+
 class LandmarkFactoryReasonableOrdersHPSFeature
     : public plugins::TypedFeature<
           LandmarkFactory, LandmarkFactoryReasonableOrdersHPS> {
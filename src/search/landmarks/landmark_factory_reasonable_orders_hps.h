@@ -34,6 +34,9 @@ public:
         utils::Verbosity verbosity);
 
     virtual bool supports_conditional_effects() const override;
+    virtual void get_nested_factories(
+        std::unordered_set<const LandmarkFactory *> &factories)
+        const override;
 };
 }
 
@@ -84,7 +84,7 @@ void LandmarkHeuristic::initialize(
 
     compute_landmark_graph(landmark_factory);
     landmark_status_manager = make_unique<LandmarkStatusManager>(
-        *landmark_graph, prog_goal, prog_gn, prog_r);
+        task_proxy, *landmark_graph, prog_goal, prog_gn, prog_r);
 
     initial_landmark_graph_has_cycle_of_natural_orderings =
         landmark_graph_has_cycle_of_natural_orderings(*landmark_graph);
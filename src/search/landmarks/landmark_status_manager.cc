@@ -3,22 +3,13 @@
 #include "landmark.h"
 #include "util.h"
 
+#include "../utils/collections.h"
+
 #include <ranges>
 
 using namespace std;
 
 namespace landmarks {
-static vector<const LandmarkNode *> get_goal_landmarks(
-    const LandmarkGraph &graph) {
-    vector<const LandmarkNode *> goals;
-    for (const auto &node : graph) {
-        if (node->get_landmark().is_true_in_goal) {
-            goals.push_back(node.get());
-        }
-    }
-    return goals;
-}
-
 static vector<pair<const LandmarkNode *, vector<const LandmarkNode *>>>
 get_greedy_necessary_children(const LandmarkGraph &graph) {
     vector<pair<const LandmarkNode *, vector<const LandmarkNode *>>> orderings;
@@ -53,14 +44,18 @@ get_reasonable_parents(const LandmarkGraph &graph) {
     return orderings;
 }
 
+static void sort_and_remove_duplicates(vector<vector<int>> &lists) {
+    for (vector<int> &list : lists) {
+        utils::sort_unique(list);
+        list.shrink_to_fit();
+    }
+}
+
 LandmarkStatusManager::LandmarkStatusManager(
-    LandmarkGraph &landmark_graph, bool progress_goals,
-    bool progress_greedy_necessary_orderings,
+    const TaskProxy &task_proxy, LandmarkGraph &landmark_graph,
+    bool progress_goals, bool progress_greedy_necessary_orderings,
     bool progress_reasonable_orderings)
     : landmark_graph(landmark_graph),
-      goal_landmarks(
-          progress_goals ? get_goal_landmarks(landmark_graph)
-                         : vector<const LandmarkNode *>{}),
       greedy_necessary_children(
           progress_greedy_necessary_orderings
               ? get_greedy_necessary_children(landmark_graph)
@@ -77,7 +72,62 @@ LandmarkStatusManager::LandmarkStatusManager(
       /* We initialize to false in `future_landmarks` because false is
          the neutral element for disjunction/set union. */
       future_landmarks(
-          vector<bool>(landmark_graph.get_num_landmarks(), false)) {
+          vector<bool>(landmark_graph.get_num_landmarks(), false)),
+      added_landmarks_blocks(
+          BitsetMath::compute_num_blocks(landmark_graph.get_num_landmarks()),
+          BitsetMath::zeros) {
+    compute_operator_candidates(task_proxy, progress_goals);
+}
+
+void LandmarkStatusManager::compute_operator_candidates(
+    const TaskProxy &task_proxy, bool progress_goals) {
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<vector<vector<int>>> landmarks_by_atom(variables.size());
+    vector<vector<int>> goal_landmarks_by_variable(variables.size());
+    for (VariableProxy var : variables) {
+        landmarks_by_atom[var.get_id()].resize(var.get_domain_size());
+    }
+    for (const auto &node : landmark_graph) {
+        int id = node->get_id();
+        const Landmark &landmark = node->get_landmark();
+        bool goal = progress_goals && landmark.is_true_in_goal;
+        bool derived =
+            ranges::any_of(landmark.atoms, [&](const FactPair &atom) {
+                return variables[atom.var].is_derived();
+            });
+        if (derived) {
+            derived_landmarks.push_back(id);
+            if (goal) {
+                derived_goal_landmarks.push_back(id);
+            }
+            continue;
+        }
+        for (const FactPair &atom : landmark.atoms) {
+            landmarks_by_atom[atom.var][atom.value].push_back(id);
+            if (goal) {
+                goal_landmarks_by_variable[atom.var].push_back(id);
+            }
+        }
+    }
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    addable_landmarks_by_operator.resize(operators.size());
+    deletable_goal_landmarks_by_operator.resize(operators.size());
+    for (OperatorProxy op : operators) {
+        vector<int> &addable = addable_landmarks_by_operator[op.get_id()];
+        vector<int> &deletable =
+            deletable_goal_landmarks_by_operator[op.get_id()];
+        for (EffectProxy effect : op.get_effects()) {
+            FactPair atom = effect.get_fact().get_pair();
+            const vector<int> &achieved =
+                landmarks_by_atom[atom.var][atom.value];
+            addable.insert(addable.end(), achieved.begin(), achieved.end());
+            const vector<int> &goals = goal_landmarks_by_variable[atom.var];
+            deletable.insert(deletable.end(), goals.begin(), goals.end());
+        }
+    }
+    sort_and_remove_duplicates(addable_landmarks_by_operator);
+    sort_and_remove_duplicates(deletable_goal_landmarks_by_operator);
 }
 
 BitsetView LandmarkStatusManager::get_past_landmarks(const State &state) {
@@ -132,13 +182,41 @@ void LandmarkStatusManager::progress_initial_state(const State &initial_state) {
     }
 }
 
+#ifndef NDEBUG
+/*
+  Check that the incremental progression yields the same result as
+  evaluating all landmarks in the parent and the current state.
+*/
+static void verify_progression(
+    const LandmarkGraph &landmark_graph, const vector<bool> &old_past,
+    const vector<bool> &old_future, const ConstBitsetView &parent_past,
+    const ConstBitsetView &parent_future, const State &parent_ancestor_state,
+    const ConstBitsetView &past, const ConstBitsetView &future,
+    const State &ancestor_state) {
+    for (const auto &node : landmark_graph) {
+        int id = node->get_id();
+        const Landmark &landmark = node->get_landmark();
+        bool true_in_state = landmark.is_true_in_state(ancestor_state);
+        bool true_in_parent = landmark.is_true_in_state(parent_ancestor_state);
+        bool expected_past =
+            old_past[id] && (parent_past.test(id) || true_in_state);
+        bool expected_future =
+            old_future[id] ||
+            (parent_future.test(id) && (!true_in_state || true_in_parent));
+        assert(past.test(id) == expected_past);
+        assert(future.test(id) == expected_future);
+    }
+}
+#endif
+
 void LandmarkStatusManager::progress(
-    const State &parent_ancestor_state, OperatorID,
+    const State &parent_ancestor_state, OperatorID op_id,
     const State &ancestor_state) {
     if (ancestor_state == parent_ancestor_state) {
         // This can happen, e.g., in Satellite-01.
         return;
     }
+    assert(utils::in_bounds(op_id.get_index(), addable_landmarks_by_operator));
 
     ConstBitsetView parent_past = get_past_landmarks(parent_ancestor_state);
     BitsetView past = get_past_landmarks(ancestor_state);
@@ -151,51 +229,95 @@ void LandmarkStatusManager::progress(
     assert(future.size() == landmark_graph.get_num_landmarks());
     assert(parent_future.size() == landmark_graph.get_num_landmarks());
 
-    progress_landmarks(
-        parent_past, parent_future, parent_ancestor_state, past, future,
-        ancestor_state);
-    progress_goals(ancestor_state, future);
+#ifndef NDEBUG
+    vector<bool> old_past(past.size());
+    vector<bool> old_future(future.size());
+    for (int id = 0; id < past.size(); ++id) {
+        old_past[id] = past.test(id);
+        old_future[id] = future.test(id);
+    }
+#endif
+
+    compute_added_landmarks(parent_ancestor_state, op_id, ancestor_state);
+    progress_landmarks(parent_past, parent_future, past, future);
+
+#ifndef NDEBUG
+    verify_progression(
+        landmark_graph, old_past, old_future, parent_past, parent_future,
+        parent_ancestor_state, past, future, ancestor_state);
+#endif
+
+    progress_goals(op_id, ancestor_state, future);
     progress_greedy_necessary_orderings(ancestor_state, past, future);
     progress_reasonable_orderings(past, future);
 }
 
-void LandmarkStatusManager::progress_landmarks(
-    ConstBitsetView &parent_past, ConstBitsetView &parent_future,
-    const State &parent_ancestor_state, BitsetView &past, BitsetView &future,
+void LandmarkStatusManager::compute_added_landmarks(
+    const State &parent_ancestor_state, OperatorID op_id,
     const State &ancestor_state) {
-    for (const auto &node : landmark_graph) {
-        int id = node->get_id();
-        const Landmark &landmark = node->get_landmark();
-        if (parent_future.test(id)) {
-            if (!landmark.is_true_in_state(ancestor_state)) {
-                /*
-                  A landmark that is future in the parent remains future
-                  if it does not hold in the current state. If it also
-                  wasn't past in the parent, it remains not past.
-                */
-                future.set(id);
-                if (!parent_past.test(id)) {
-                    past.reset(id);
-                }
-            } else if (landmark.is_true_in_state(parent_ancestor_state)) {
-                /*
-                  If the landmark held in the parent already, then it
-                  was not added by this transition and should remain
-                  future.
-                */
-                assert(parent_past.test(id));
-                future.set(id);
-            }
+    BitsetView added(
+        ArrayView<BitsetMath::Block>(
+            added_landmarks_blocks.data(), added_landmarks_blocks.size()),
+        landmark_graph.get_num_landmarks());
+    for (int id : added_landmarks) {
+        added.reset(id);
+    }
+    added_landmarks.clear();
+
+    auto check_landmark = [&](int id) {
+        const Landmark &landmark = landmark_graph.get_node(id)->get_landmark();
+        if (landmark.is_true_in_state(ancestor_state) &&
+            !landmark.is_true_in_state(parent_ancestor_state)) {
+            added.set(id);
+            added_landmarks.push_back(id);
         }
+    };
+    for (int id : addable_landmarks_by_operator[op_id.get_index()]) {
+        check_landmark(id);
+    }
+    for (int id : derived_landmarks) {
+        check_landmark(id);
     }
 }
 
+void LandmarkStatusManager::progress_landmarks(
+    ConstBitsetView &parent_past, ConstBitsetView &parent_future,
+    BitsetView &past, BitsetView &future) {
+    /*
+      Landmarks that hold in a state are always past. Therefore, a landmark
+      that is not past in the parent is true in the current state iff it is
+      added by this transition. Consequently, a landmark remains past iff it
+      was past in the parent or is added by this transition.
+
+      A landmark that is future in the parent remains future unless it is
+      added by this transition. This covers both landmarks that do not hold in
+      the current state and landmarks that held in the parent already.
+    */
+    ConstBitsetView added(
+        ConstArrayView<BitsetMath::Block>(
+            added_landmarks_blocks.data(), added_landmarks_blocks.size()),
+        landmark_graph.get_num_landmarks());
+    past.intersect_with_union(parent_past, added);
+    future.unite_with_difference(parent_future, added);
+}
+
 void LandmarkStatusManager::progress_goals(
-    const State &ancestor_state, BitsetView &future) {
-    for (auto &node : goal_landmarks) {
-        if (!node->get_landmark().is_true_in_state(ancestor_state)) {
-            future.set(node->get_id());
+    OperatorID op_id, const State &ancestor_state, BitsetView &future) {
+    /*
+      Goal landmarks that are false in the parent are future there, so only
+      goal landmarks that the transition may have made false need checking.
+    */
+    auto check_goal = [&](int id) {
+        const Landmark &landmark = landmark_graph.get_node(id)->get_landmark();
+        if (!landmark.is_true_in_state(ancestor_state)) {
+            future.set(id);
         }
+    };
+    for (int id : deletable_goal_landmarks_by_operator[op_id.get_index()]) {
+        check_goal(id);
+    }
+    for (int id : derived_goal_landmarks) {
+        check_goal(id);
     }
 }
 
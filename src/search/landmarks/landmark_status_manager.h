@@ -11,7 +11,6 @@ class LandmarkNode;
 
 class LandmarkStatusManager {
     LandmarkGraph &landmark_graph;
-    const std::vector<const LandmarkNode *> goal_landmarks;
     const std::vector<
         std::pair<const LandmarkNode *, std::vector<const LandmarkNode *>>>
         greedy_necessary_children;
@@ -19,14 +18,36 @@ class LandmarkStatusManager {
         std::pair<const LandmarkNode *, std::vector<const LandmarkNode *>>>
         reasonable_parents;
 
+    /*
+      A landmark can only become true in a transition if the operator adds
+      one of its atoms, and a goal landmark can only become false if the
+      operator changes the value of one of its variables. Landmarks with
+      derived atoms can change in any transition. We precompute these
+      candidates for each operator to avoid evaluating all landmarks in each
+      progression step.
+    */
+    std::vector<std::vector<int>> addable_landmarks_by_operator;
+    std::vector<std::vector<int>> deletable_goal_landmarks_by_operator;
+    std::vector<int> derived_landmarks;
+    std::vector<int> derived_goal_landmarks;
+
     PerStateBitset past_landmarks;
     PerStateBitset future_landmarks;
 
+    // Scratch space for the landmarks added by the current transition.
+    std::vector<BitsetMath::Block> added_landmarks_blocks;
+    std::vector<int> added_landmarks;
+
+    void compute_operator_candidates(
+        const TaskProxy &task_proxy, bool progress_goals);
+    void compute_added_landmarks(
+        const State &parent_ancestor_state, OperatorID op_id,
+        const State &ancestor_state);
     void progress_landmarks(
         ConstBitsetView &parent_past, ConstBitsetView &parent_future,
-        const State &parent_ancestor_state, BitsetView &past,
-        BitsetView &future, const State &ancestor_state);
-    void progress_goals(const State &ancestor_state, BitsetView &future);
+        BitsetView &past, BitsetView &future);
+    void progress_goals(
+        OperatorID op_id, const State &ancestor_state, BitsetView &future);
     void progress_greedy_necessary_orderings(
         const State &ancestor_state, const BitsetView &past,
         BitsetView &future);
@@ -34,7 +55,8 @@ class LandmarkStatusManager {
         const BitsetView &past, BitsetView &future);
 public:
     LandmarkStatusManager(
-        LandmarkGraph &landmark_graph, bool progress_goals,
+        const TaskProxy &task_proxy, LandmarkGraph &landmark_graph,
+        bool progress_goals,
         bool progress_greedy_necessary_orderings,
         bool progress_reasonable_orderings);
 
@@ -582,6 +582,16 @@ vector<double> CplexSolverInterface::extract_solution() const {
     return solution;
 }
 
+int CplexSolverInterface::get_num_iterations() const {
+    if (is_trivially_unsolvable()) {
+        return 0;
+    } else if (is_mip) {
+        return static_cast<int>(CPXgetmipitcnt(env, problem));
+    } else {
+        return CPXgetitcnt(env, problem);
+    }
+}
+
 int CplexSolverInterface::get_num_variables() const {
     return CPXgetnumcols(env, problem);
 }
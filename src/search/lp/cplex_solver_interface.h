@@ -274,6 +274,7 @@ public:
     virtual bool has_optimal_solution() const override;
     virtual double get_objective_value() const override;
     virtual std::vector<double> extract_solution() const override;
+    virtual int get_num_iterations() const override;
     virtual int get_num_variables() const override;
     virtual int get_num_constraints() const override;
     virtual bool has_temporary_constraints() const override;
@@ -227,6 +227,10 @@ vector<double> LPSolver::extract_solution() const {
     return pimpl->extract_solution();
 }
 
+int LPSolver::get_num_iterations() const {
+    return pimpl->get_num_iterations();
+}
+
 int LPSolver::get_num_variables() const {
     return pimpl->get_num_variables();
 }
@@ -165,6 +165,9 @@ public:
     */
     std::vector<double> extract_solution() const;
 
+    // Return the number of simplex iterations of the last call to solve().
+    int get_num_iterations() const;
+
     int get_num_variables() const;
     int get_num_constraints() const;
     int has_temporary_constraints() const;
@@ -63,6 +63,11 @@ public:
     */
     virtual std::vector<double> extract_solution() const = 0;
 
+    /*
+      Return the number of simplex iterations of the last call to solve().
+    */
+    virtual int get_num_iterations() const = 0;
+
     virtual int get_num_variables() const = 0;
     virtual int get_num_constraints() const = 0;
     virtual bool has_temporary_constraints() const = 0;
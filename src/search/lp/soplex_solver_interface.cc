@@ -225,6 +225,10 @@ vector<double> SoPlexSolverInterface::extract_solution() const {
     return sol.vec();
 }
 
+int SoPlexSolverInterface::get_num_iterations() const {
+    return soplex.numIterations();
+}
+
 int SoPlexSolverInterface::get_num_variables() const {
     return soplex.numCols();
 }
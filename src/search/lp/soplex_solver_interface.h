@@ -59,6 +59,8 @@ public:
 
     virtual std::vector<double> extract_solution() const override;
 
+    virtual int get_num_iterations() const override;
+
     virtual int get_num_variables() const override;
     virtual int get_num_constraints() const override;
     virtual bool has_temporary_constraints() const override;
@@ -19,14 +19,25 @@ CanonicalPDBs::CanonicalPDBs(
 }
 
 int CanonicalPDBs::get_value(const State &state) const {
+    state.unpack();
+    vector<int> ranks;
+    ranks.reserve(pdbs->size());
+    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
+        ranks.push_back(
+            pdb->get_projection().rank(state.get_unpacked_values()));
+    }
+    return get_value(ranks);
+}
+
+int CanonicalPDBs::get_value(const vector<int> &ranks) const {
     // If we have an empty collection, then pattern_cliques = { \emptyset }.
     assert(!pattern_cliques->empty());
+    assert(ranks.size() == pdbs->size());
     int max_h = 0;
     vector<int> h_values;
     h_values.reserve(pdbs->size());
-    state.unpack();
-    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
-        int h = pdb->get_value(state.get_unpacked_values());
+    for (size_t i = 0; i < pdbs->size(); ++i) {
+        int h = (*pdbs)[i]->get_value_for_rank(ranks[i]);
         if (h == numeric_limits<int>::max()) {
             return numeric_limits<int>::max();
         }
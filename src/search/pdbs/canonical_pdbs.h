@@ -19,6 +19,12 @@ public:
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
+    // Compute the value from the ranks of the state in all PDBs.
+    int get_value(const std::vector<int> &ranks) const;
+
+    const PDBCollection &get_pdbs() const {
+        return *pdbs;
+    }
 };
 }
 
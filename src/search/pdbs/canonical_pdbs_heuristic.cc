@@ -3,6 +3,7 @@
 #include "dominance_pruning.h"
 #include "utils.h"
 
+#include "../cost_saturation/abstraction_registry.h"
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
 #include "../utils/timer.h"
@@ -63,12 +64,22 @@ CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(
     const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity),
       canonical_pdbs(
-          get_canonical_pdbs(task, patterns, max_time_dominance_pruning, log)) {
+          get_canonical_pdbs(task, patterns, max_time_dominance_pruning, log)),
+      abstraction_registry(
+          cost_saturation::g_abstraction_registries[task_proxy]),
+      pdb_slots(add_pdbs_to_abstraction_registry(
+          canonical_pdbs.get_pdbs(), abstraction_registry)) {
+}
+
+CanonicalPDBsHeuristic::~CanonicalPDBsHeuristic() {
+    abstraction_registry.remove_abstraction_functions(pdb_slots);
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int h = canonical_pdbs.get_value(state);
+    abstraction_registry.set_state(ancestor_state, state);
+    int h = canonical_pdbs.get_value(
+        abstraction_registry.get_abstract_state_ids(pdb_slots));
     if (h == numeric_limits<int>::max()) {
         return DEAD_END;
     } else {
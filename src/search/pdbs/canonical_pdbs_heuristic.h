@@ -6,14 +6,25 @@
 
 #include "../heuristic.h"
 
+namespace cost_saturation {
+class AbstractionRegistry;
+}
+
 namespace plugins {
 class Feature;
 }
 
 namespace pdbs {
-// Implements the canonical heuristic function.
+/*
+  Implements the canonical heuristic function. The ranks of the evaluated
+  state come from the abstraction registry of the task, so that heuristics
+  with the same patterns share them.
+*/
 class CanonicalPDBsHeuristic : public Heuristic {
     CanonicalPDBs canonical_pdbs;
+    cost_saturation::AbstractionRegistry &abstraction_registry;
+    // Slot in the registry for each PDB.
+    std::vector<int> pdb_slots;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -24,6 +35,7 @@ public:
         double max_time_dominance_pruning,
         const std::shared_ptr<AbstractTask> &transform, bool cache_estimates,
         const std::string &description, utils::Verbosity verbosity);
+    virtual ~CanonicalPDBsHeuristic() override;
 };
 
 void add_canonical_pdbs_options_to_feature(plugins::Feature &feature);
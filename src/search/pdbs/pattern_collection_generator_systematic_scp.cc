@@ -17,6 +17,7 @@
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/math.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -82,6 +83,14 @@ get_num_active_ops(const Iterable &pattern, const TaskInfo &task_info) {
     return num_active_ops;
 }
 
+/*
+  The process CPU time includes the time of all threads, so with multiple
+  threads we measure wall-clock time instead.
+*/
+static utils::Clock get_clock(int num_threads) {
+    return (num_threads > 1) ? utils::Clock::WALL : utils::Clock::PROCESS_CPU;
+}
+
 static bool contains_positive_finite_value(const vector<int> &values) {
     return any_of(values.begin(), values.end(), [](int v) {
         return v > 0 && v != numeric_limits<int>::max();
@@ -101,6 +110,20 @@ static bool operators_with_positive_finite_costs_affect_pdb(
     return false;
 }
 
+static bool costs_changed_for_pattern(
+    const Pattern &pattern, const vector<int> &old_costs,
+    const vector<int> &new_costs,
+    const vector<vector<int>> &relevant_operators_per_variable) {
+    for (int var : pattern) {
+        for (int op : relevant_operators_per_variable[var]) {
+            if (old_costs[op] != new_costs[op]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 static unique_ptr<PatternCollection> get_patterns(
     const shared_ptr<AbstractTask> &task, int pattern_size,
     PatternType pattern_type, const utils::CountdownTimer &timer) {
@@ -268,7 +291,7 @@ PatternCollectionGeneratorSystematicSCP::
         bool saturate, cost_saturation::TransitionSystemType transition_type,
         PatternType pattern_type, bool ignore_useless_patterns,
         bool store_dead_ends, PatternOrder order, int random_seed,
-        utils::Verbosity verbosity)
+        int num_threads, utils::Verbosity verbosity)
     : PatternCollectionGenerator(verbosity),
       max_pattern_size(max_pattern_size),
       max_pdb_size(max_pdb_size),
@@ -284,21 +307,80 @@ PatternCollectionGeneratorSystematicSCP::
       ignore_useless_patterns(ignore_useless_patterns),
       store_dead_ends(store_dead_ends),
       pattern_order(order),
-      rng(utils::get_rng(random_seed)) {
+      rng(utils::get_rng(random_seed)),
+      num_threads(num_threads) {
+}
+
+/*
+  Evaluate the given pattern under the given costs. For implicit
+  projections, keep the evaluator and, if check_dead_ends is true and the
+  projection has dead ends, its goal distances, so that the caller can
+  store the dead ends.
+*/
+bool PatternCollectionGeneratorSystematicSCP::evaluate_pattern(
+    const TaskProxy &task_proxy,
+    const shared_ptr<cost_saturation::TaskInfo> &task_info,
+    const TaskInfo &evaluator_task_info, bool use_explicit,
+    const vector<int> &costs, priority_queues::AdaptiveQueue<int> &pq,
+    PatternCandidate &candidate) const {
+    const Pattern &pattern = candidate.pattern;
+    if (use_explicit) {
+        unique_ptr<cost_saturation::Abstraction> projection =
+            cost_saturation::ExplicitProjectionFactory(task_proxy, pattern)
+                .convert_to_abstraction();
+        // TODO: return true as soon as first settled state has positive
+        // costs.
+        return contains_positive_finite_value(
+            projection->compute_goal_distances(costs));
+    }
+    bool measure_time = (num_threads == 1);
+    if (measure_time) {
+        projection_computation_timer->resume();
+    }
+    candidate.evaluator = make_unique<PatternEvaluator>(
+        task_proxy, evaluator_task_info, pattern, costs);
+    if (measure_time) {
+        projection_computation_timer->stop();
+    }
+    candidate.dead_end_distances.clear();
+    bool useful = candidate.evaluator->is_useful(
+        pq, costs,
+        candidate.check_dead_ends ? &candidate.dead_end_distances : nullptr);
+
+#ifndef NDEBUG
+    vector<int> goal_distances =
+        cost_saturation::Projection(task_proxy, task_info, pattern)
+            .compute_goal_distances(costs);
+    assert(useful == contains_positive_finite_value(goal_distances));
+#else
+    utils::unused_variable(task_info);
+#endif
+    return useful;
 }
 
+/*
+  We process the patterns in batches of num_threads candidates. First, we
+  evaluate all candidates of a batch in parallel under the costs at the
+  start of the batch. Then, we commit the candidates sequentially in the
+  order of the pattern generator. Selecting a pattern reduces the costs, so
+  before committing a candidate, we check whether the costs of an operator
+  affecting the pattern changed since the start of the batch. Only then do
+  we evaluate the candidate again under the current costs. This yields the
+  same patterns (and dead ends) as evaluating all candidates sequentially.
+*/
 bool PatternCollectionGeneratorSystematicSCP::select_systematic_patterns(
     const shared_ptr<AbstractTask> &task,
     const shared_ptr<cost_saturation::TaskInfo> &task_info,
     const TaskInfo &evaluator_task_info,
     SequentialPatternGenerator &pattern_generator,
-    priority_queues::AdaptiveQueue<int> &pq,
+    vector<priority_queues::AdaptiveQueue<int>> &queues,
     const shared_ptr<PatternCollection> &patterns,
     const shared_ptr<ProjectionCollection> &projections,
     PatternSet &pattern_set, PatternSet &patterns_checked_for_dead_ends,
     int64_t &collection_size, double overall_remaining_time) {
     utils::CountdownTimer timer(
-        min(overall_remaining_time, max_time_per_restart));
+        min(overall_remaining_time, max_time_per_restart),
+        get_clock(num_threads));
     int remaining_total_evaluations =
         max_total_evaluations - num_pattern_evaluations;
     assert(remaining_total_evaluations >= 0);
@@ -310,139 +392,202 @@ bool PatternCollectionGeneratorSystematicSCP::select_systematic_patterns(
     State initial_state = task_proxy.get_initial_state();
     vector<int> variable_domains = get_variable_domains(task_proxy);
     vector<int> costs = task_properties::get_operator_costs(task_proxy);
+    bool use_explicit =
+        cost_saturation::use_explicit_transitions(transition_type, task_proxy);
     int pattern_id = -1;
+    vector<PatternCandidate> batch;
     while (true) {
-        ++pattern_id;
-
-        pattern_computation_timer->resume();
-        Pattern pattern = pattern_generator.get_pattern(pattern_id, timer);
-        pattern_computation_timer->stop();
-
-        if (timer.is_expired()) {
-            log << "Reached restart time limit." << endl;
-            return false;
-        }
-
         if (num_pattern_evaluations >= final_num_evaluations_this_restart) {
             log << "Reached maximum pattern evaluations per restart." << endl;
             return false;
         }
 
-        if (log.is_at_least_debug()) {
-            log << "Pattern " << pattern_id << ": " << pattern
-                << " size:" << get_pdb_size(variable_domains, pattern)
-                << " ops:" << get_num_active_ops(pattern, evaluator_task_info)
-                << endl;
-        }
+        // Collect candidates that pass the cost-independent checks.
+        int batch_size = min(
+            num_threads,
+            final_num_evaluations_this_restart - num_pattern_evaluations);
+        batch.clear();
+        bool time_expired = false;
+        bool generated_all_patterns = false;
+        while (static_cast<int>(batch.size()) < batch_size) {
+            ++pattern_id;
+
+            pattern_computation_timer->resume();
+            Pattern pattern = pattern_generator.get_pattern(pattern_id, timer);
+            pattern_computation_timer->stop();
+
+            if (timer.is_expired()) {
+                time_expired = true;
+                break;
+            }
 
-        if (pattern.empty()) {
-            log << "Generated all patterns up to size " << max_pattern_size
-                << "." << endl;
-            return false;
-        } else if (pattern_set.count(pattern)) {
-            continue;
-        }
+            if (log.is_at_least_debug()) {
+                log << "Pattern " << pattern_id << ": " << pattern
+                    << " size:" << get_pdb_size(variable_domains, pattern)
+                    << " ops:"
+                    << get_num_active_ops(pattern, evaluator_task_info)
+                    << endl;
+            }
 
-        int pdb_size = get_pdb_size(variable_domains, pattern);
-        if (pdb_size == -1 || pdb_size > max_pdb_size) {
-            // Pattern is too large.
-            continue;
-        }
+            if (pattern.empty()) {
+                generated_all_patterns = true;
+                break;
+            } else if (pattern_set.count(pattern)) {
+                continue;
+            }
 
-        if (static_cast<int>(projections->size()) == max_patterns) {
-            log << "Reached maximum number of patterns." << endl;
-            return true;
-        }
+            int pdb_size = get_pdb_size(variable_domains, pattern);
+            if (pdb_size == -1 || pdb_size > max_pdb_size) {
+                // Pattern is too large.
+                continue;
+            }
 
-        if (max_collection_size != numeric_limits<int>::max() &&
-            pdb_size >
-                static_cast<int64_t>(max_collection_size) - collection_size) {
-            log << "Reached maximum collection size." << endl;
-            return true;
+            PatternCandidate candidate;
+            /* Only check each pattern for dead ends once, even if the batch
+               contains it twice. */
+            candidate.check_dead_ends =
+                dead_ends && !use_explicit &&
+                !patterns_checked_for_dead_ends.count(pattern) &&
+                none_of(
+                    batch.begin(), batch.end(),
+                    [&pattern](const PatternCandidate &other) {
+                        return other.pattern == pattern;
+                    });
+            candidate.pattern = move(pattern);
+            candidate.pdb_size = pdb_size;
+            batch.push_back(move(candidate));
         }
 
-        /* If there are no state-changing transitions with positive finite
-           costs, there can be no positive finite goal distances. */
-        if (ignore_useless_patterns &&
-            !operators_with_positive_finite_costs_affect_pdb(
-                pattern, costs, relevant_operators_per_variable)) {
-            if (log.is_at_least_debug()) {
-                log << "Only operators with cost=0 or cost=infty affect "
-                    << pattern << endl;
-            }
-            continue;
+        // Evaluate the candidates speculatively under the current costs.
+        vector<int> costs_at_batch_start;
+        if (num_threads > 1) {
+            costs_at_batch_start = costs;
         }
-
-        bool use_explicit = cost_saturation::use_explicit_transitions(
-            transition_type, task_proxy);
-
-        bool select_pattern = true;
+        bool selected_pattern_in_batch = false;
         if (saturate) {
             projection_evaluation_timer->resume();
-            if (use_explicit) {
-                unique_ptr<cost_saturation::Abstraction> projection =
-                    cost_saturation::ExplicitProjectionFactory(
-                        task_proxy, pattern)
-                        .convert_to_abstraction();
-                // TODO: return true as soon as first settled state has positive
-                // costs.
-                select_pattern = contains_positive_finite_value(
-                    projection->compute_goal_distances(costs));
-            } else {
-                // Only check each pattern for dead ends once.
-                DeadEnds *tmp_dead_ends = dead_ends;
-                if (tmp_dead_ends) {
-                    if (patterns_checked_for_dead_ends.count(pattern)) {
-                        tmp_dead_ends = nullptr;
-                    } else {
-                        patterns_checked_for_dead_ends.insert(pattern);
+            utils::parallel_for(
+                batch.size(), num_threads, [&](int thread_id, int i) {
+                    PatternCandidate &candidate = batch[i];
+                    if (ignore_useless_patterns &&
+                        !operators_with_positive_finite_costs_affect_pdb(
+                            candidate.pattern, costs,
+                            relevant_operators_per_variable)) {
+                        return;
                     }
-                }
-                projection_computation_timer->resume();
-                PatternEvaluator pattern_evaluator(
-                    task_proxy, evaluator_task_info, pattern, costs);
-                projection_computation_timer->stop();
-                select_pattern = pattern_evaluator.is_useful(
-                    pattern, pq, tmp_dead_ends, costs);
-
-#ifndef NDEBUG
-                vector<int> goal_distances =
-                    cost_saturation::Projection(task_proxy, task_info, pattern)
-                        .compute_goal_distances(costs);
-                assert(
-                    select_pattern ==
-                    contains_positive_finite_value(goal_distances));
-#endif
-            }
+                    candidate.useful = evaluate_pattern(
+                        task_proxy, task_info, evaluator_task_info,
+                        use_explicit, costs, queues[thread_id], candidate);
+                    candidate.evaluated = true;
+                });
             projection_evaluation_timer->stop();
         }
 
-        ++num_pattern_evaluations;
+        for (PatternCandidate &candidate : batch) {
+            const Pattern &pattern = candidate.pattern;
+            if (pattern_set.count(pattern)) {
+                // The batch contained the pattern twice.
+                continue;
+            }
 
-        if (select_pattern) {
-            if (saturate) {
-                log << "Add pattern " << pattern << endl;
+            if (num_pattern_evaluations >=
+                final_num_evaluations_this_restart) {
+                log << "Reached maximum pattern evaluations per restart."
+                    << endl;
+                return false;
+            }
+
+            if (static_cast<int>(projections->size()) == max_patterns) {
+                log << "Reached maximum number of patterns." << endl;
+                return true;
             }
-            unique_ptr<cost_saturation::Abstraction> projection;
-            if (use_explicit) {
-                projection = cost_saturation::ExplicitProjectionFactory(
-                                 task_proxy, pattern)
-                                 .convert_to_abstraction();
-            } else {
-                projection = make_unique<cost_saturation::Projection>(
-                    task_proxy, task_info, pattern);
+
+            if (max_collection_size != numeric_limits<int>::max() &&
+                candidate.pdb_size > static_cast<int64_t>(max_collection_size) -
+                                         collection_size) {
+                log << "Reached maximum collection size." << endl;
+                return true;
+            }
+
+            /* If there are no state-changing transitions with positive finite
+               costs, there can be no positive finite goal distances. */
+            if (ignore_useless_patterns &&
+                !operators_with_positive_finite_costs_affect_pdb(
+                    pattern, costs, relevant_operators_per_variable)) {
+                if (log.is_at_least_debug()) {
+                    log << "Only operators with cost=0 or cost=infty affect "
+                        << pattern << endl;
+                }
+                continue;
             }
+
+            bool select_pattern = true;
             if (saturate) {
-                vector<int> goal_distances =
-                    projection->compute_goal_distances(costs);
-                vector<int> saturated_costs =
-                    projection->compute_saturated_costs(goal_distances);
-                cost_saturation::reduce_costs(costs, saturated_costs);
+                if (!candidate.evaluated ||
+                    (selected_pattern_in_batch &&
+                     costs_changed_for_pattern(
+                         pattern, costs_at_batch_start, costs,
+                         relevant_operators_per_variable))) {
+                    projection_evaluation_timer->resume();
+                    candidate.useful = evaluate_pattern(
+                        task_proxy, task_info, evaluator_task_info,
+                        use_explicit, costs, queues[0], candidate);
+                    projection_evaluation_timer->stop();
+                }
+                select_pattern = candidate.useful;
+                if (candidate.check_dead_ends) {
+                    patterns_checked_for_dead_ends.insert(pattern);
+                    if (!candidate.dead_end_distances.empty()) {
+                        // Add new dead ends to database.
+                        candidate.evaluator->store_new_dead_ends(
+                            pattern, candidate.dead_end_distances,
+                            *dead_ends);
+                    }
+                }
+                // Free memory early.
+                candidate.evaluator = nullptr;
+                utils::release_vector_memory(candidate.dead_end_distances);
+            }
+
+            ++num_pattern_evaluations;
+
+            if (select_pattern) {
+                if (saturate) {
+                    log << "Add pattern " << pattern << endl;
+                }
+                unique_ptr<cost_saturation::Abstraction> projection;
+                if (use_explicit) {
+                    projection = cost_saturation::ExplicitProjectionFactory(
+                                     task_proxy, pattern)
+                                     .convert_to_abstraction();
+                } else {
+                    projection = make_unique<cost_saturation::Projection>(
+                        task_proxy, task_info, pattern);
+                }
+                if (saturate) {
+                    vector<int> goal_distances =
+                        projection->compute_goal_distances(costs);
+                    vector<int> saturated_costs =
+                        projection->compute_saturated_costs(goal_distances);
+                    cost_saturation::reduce_costs(costs, saturated_costs);
+                }
+                patterns->push_back(pattern);
+                projections->push_back(move(projection));
+                pattern_set.insert(pattern);
+                collection_size += candidate.pdb_size;
+                selected_pattern_in_batch = true;
             }
-            patterns->push_back(pattern);
-            projections->push_back(move(projection));
-            pattern_set.insert(pattern);
-            collection_size += pdb_size;
+        }
+
+        if (time_expired) {
+            log << "Reached restart time limit." << endl;
+            return false;
+        }
+
+        if (generated_all_patterns) {
+            log << "Generated all patterns up to size " << max_pattern_size
+                << "." << endl;
+            return false;
         }
     }
 }
@@ -454,13 +599,11 @@ string PatternCollectionGeneratorSystematicSCP::name() const {
 PatternCollectionInformation
 PatternCollectionGeneratorSystematicSCP::compute_patterns(
     const shared_ptr<AbstractTask> &task) {
-    utils::CountdownTimer timer(max_time);
-    pattern_computation_timer = make_unique<utils::Timer>();
-    pattern_computation_timer->stop();
-    projection_computation_timer = make_unique<utils::Timer>();
-    projection_computation_timer->stop();
-    projection_evaluation_timer = make_unique<utils::Timer>();
-    projection_evaluation_timer->stop();
+    utils::Clock clock = get_clock(num_threads);
+    utils::CountdownTimer timer(max_time, clock);
+    pattern_computation_timer = make_unique<utils::Timer>(false, clock);
+    projection_computation_timer = make_unique<utils::Timer>(false, clock);
+    projection_evaluation_timer = make_unique<utils::Timer>(false, clock);
     TaskProxy task_proxy(*task);
     task_properties::verify_no_axioms(task_proxy);
 
@@ -477,7 +620,7 @@ PatternCollectionGeneratorSystematicSCP::compute_patterns(
     shared_ptr<cost_saturation::TaskInfo> task_info =
         make_shared<cost_saturation::TaskInfo>(task_proxy);
     TaskInfo evaluator_task_info(task_proxy);
-    if (ignore_useless_patterns) {
+    if (ignore_useless_patterns || num_threads > 1) {
         relevant_operators_per_variable =
             get_relevant_operators_per_variable(task_proxy);
     }
@@ -487,7 +630,7 @@ PatternCollectionGeneratorSystematicSCP::compute_patterns(
     SequentialPatternGenerator pattern_generator(
         task, evaluator_task_info, max_pattern_size, pattern_type,
         pattern_order, *rng);
-    priority_queues::AdaptiveQueue<int> pq;
+    vector<priority_queues::AdaptiveQueue<int>> queues(num_threads);
     shared_ptr<PatternCollection> patterns = make_shared<PatternCollection>();
     shared_ptr<ProjectionCollection> projections =
         make_shared<ProjectionCollection>();
@@ -499,7 +642,7 @@ PatternCollectionGeneratorSystematicSCP::compute_patterns(
     while (!limit_reached) {
         int num_patterns_before = projections->size();
         limit_reached = select_systematic_patterns(
-            task, task_info, evaluator_task_info, pattern_generator, pq,
+            task, task_info, evaluator_task_info, pattern_generator, queues,
             patterns, projections, pattern_set, patterns_checked_for_dead_ends,
             collection_size, timer.get_remaining_time());
         int num_patterns_after = projections->size();
@@ -612,7 +755,19 @@ public:
             "in the partial ordering of the causal graph)",
             "cg_down");
         utils::add_rng_options_to_feature(*this);
+        utils::add_parallel_options_to_feature(*this);
         add_generator_options_to_feature(*this);
+        document_note(
+            "Parallelism",
+            "With threads > 1, batches of candidate patterns are evaluated in "
+            "parallel. The candidates are then committed in the original "
+            "order, re-evaluating a candidate if selecting an earlier "
+            "pattern changed the costs of its operators. Therefore, the "
+            "selected patterns are the same for all numbers of threads "
+            "unless a time limit is reached. In this case, max_time and "
+            "max_time_per_restart limit the wall-clock time instead of the "
+            "CPU time, and all threads count against CPU time limits of the "
+            "planner.");
     }
 
     virtual shared_ptr<PatternCollectionGeneratorSystematicSCP>
@@ -630,6 +785,7 @@ public:
             opts.get<bool>("ignore_useless_patterns"),
             opts.get<bool>("store_dead_ends"), opts.get<PatternOrder>("order"),
             utils::get_rng_arguments_from_options(opts),
+            utils::get_parallel_arguments_from_options(opts),
             get_generator_arguments_from_options(opts));
     }
 };
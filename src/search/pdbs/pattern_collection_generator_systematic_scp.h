@@ -27,6 +27,7 @@ class Timer;
 }
 
 namespace pdbs {
+class PatternEvaluator;
 class SequentialPatternGenerator;
 struct TaskInfo;
 
@@ -57,6 +58,7 @@ class PatternCollectionGeneratorSystematicSCP
     const bool store_dead_ends;
     const PatternOrder pattern_order;
     const std::shared_ptr<utils::RandomNumberGenerator> rng;
+    const int num_threads;
 
     std::vector<std::vector<int>> relevant_operators_per_variable;
 
@@ -66,12 +68,29 @@ class PatternCollectionGeneratorSystematicSCP
     std::unique_ptr<utils::Timer> projection_computation_timer;
     std::unique_ptr<utils::Timer> projection_evaluation_timer;
 
+    struct PatternCandidate {
+        Pattern pattern;
+        int pdb_size = -1;
+        bool check_dead_ends = false;
+        bool evaluated = false;
+        bool useful = false;
+        std::unique_ptr<PatternEvaluator> evaluator;
+        std::vector<int> dead_end_distances;
+    };
+
+    bool evaluate_pattern(
+        const TaskProxy &task_proxy,
+        const std::shared_ptr<cost_saturation::TaskInfo> &task_info,
+        const TaskInfo &evaluator_task_info, bool use_explicit,
+        const std::vector<int> &costs,
+        priority_queues::AdaptiveQueue<int> &pq,
+        PatternCandidate &candidate) const;
     bool select_systematic_patterns(
         const std::shared_ptr<AbstractTask> &task,
         const std::shared_ptr<cost_saturation::TaskInfo> &task_info,
         const TaskInfo &evaluator_task_info,
         SequentialPatternGenerator &pattern_generator,
-        priority_queues::AdaptiveQueue<int> &pq,
+        std::vector<priority_queues::AdaptiveQueue<int>> &queues,
         const std::shared_ptr<PatternCollection> &patterns,
         const std::shared_ptr<ProjectionCollection> &projections,
         PatternSet &pattern_set, PatternSet &patterns_checked_for_dead_ends,
@@ -88,7 +107,7 @@ public:
         bool saturate, cost_saturation::TransitionSystemType transition_type,
         PatternType pattern_type, bool ignore_useless_patterns,
         bool store_dead_ends, PatternOrder order, int random_seed,
-        utils::Verbosity verbosity);
+        int num_threads, utils::Verbosity verbosity);
 };
 }
 
@@ -54,6 +54,15 @@ public:
     PatternDatabase(Projection &&projection, std::vector<int> &&distances);
     int get_value(const std::vector<int> &state) const;
 
+    // Return the value of the abstract state with the given rank.
+    int get_value_for_rank(int rank) const {
+        return distances[rank];
+    }
+
+    const Projection &get_projection() const {
+        return projection;
+    }
+
     const Pattern &get_pattern() const {
         return projection.get_pattern();
     }
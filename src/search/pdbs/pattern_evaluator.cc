@@ -354,8 +354,8 @@ void PatternEvaluator::store_new_dead_ends(
 }
 
 bool PatternEvaluator::is_useful(
-    const Pattern &pattern, priority_queues::AdaptiveQueue<int> &pq,
-    DeadEnds *dead_ends, const vector<int> &costs) const {
+    priority_queues::AdaptiveQueue<int> &pq, const vector<int> &costs,
+    vector<int> *dead_end_distances) const {
     assert(all_of(costs.begin(), costs.end(), [](int c) { return c >= 0; }));
     vector<int> distances(num_states, INF);
     int num_settled = 0;
@@ -415,9 +415,8 @@ bool PatternEvaluator::is_useful(
         has_dead_end == any_of(distances.begin(), distances.end(), [](int d) {
             return d == INF;
         }));
-    if (dead_ends && has_dead_end) {
-        // Add new dead ends to database.
-        store_new_dead_ends(pattern, distances, *dead_ends);
+    if (dead_end_distances && has_dead_end) {
+        *dead_end_distances = move(distances);
     }
     return found_positive_finite_goal_distance;
 }
@@ -96,19 +96,25 @@ class PatternEvaluator {
         const std::vector<int> &pattern_domain_sizes, int state_index,
         const std::vector<FactPair> &abstract_facts) const;
 
-    void store_new_dead_ends(
-        const Pattern &pattern, const std::vector<int> &distances,
-        DeadEnds &dead_ends) const;
-
 public:
     PatternEvaluator(
         const TaskProxy &task_proxy, const TaskInfo &task_info,
         const pdbs::Pattern &pattern, const std::vector<int> &costs);
     ~PatternEvaluator();
 
+    /*
+      Return true iff the projection has a state with positive finite goal
+      distance under the given costs. If the projection has dead ends and
+      dead_end_distances is given, store all goal distances in it, so that
+      the caller can store the dead ends later.
+    */
     bool is_useful(
-        const Pattern &pattern, priority_queues::AdaptiveQueue<int> &pq,
-        DeadEnds *dead_ends, const std::vector<int> &costs) const;
+        priority_queues::AdaptiveQueue<int> &pq, const std::vector<int> &costs,
+        std::vector<int> *dead_end_distances) const;
+
+    void store_new_dead_ends(
+        const Pattern &pattern, const std::vector<int> &distances,
+        DeadEnds &dead_ends) const;
 };
 }
 
@@ -6,6 +6,8 @@
 
 #include "../task_proxy.h"
 
+#include "../cost_saturation/abstraction_registry.h"
+#include "../cost_saturation/projection.h"
 #include "../task_utils/causal_graph.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
@@ -139,6 +141,21 @@ void dump_pattern_collection_generation_statistics(
     }
 }
 
+vector<int> add_pdbs_to_abstraction_registry(
+    const PDBCollection &pdbs,
+    cost_saturation::AbstractionRegistry &abstraction_registry) {
+    cost_saturation::AbstractionFunctions projection_functions;
+    projection_functions.reserve(pdbs.size());
+    for (const shared_ptr<PatternDatabase> &pdb : pdbs) {
+        const Projection &projection = pdb->get_projection();
+        projection_functions.push_back(
+            make_unique<cost_saturation::ProjectionFunction>(
+                projection.get_pattern(), projection.get_hash_multipliers()));
+    }
+    return abstraction_registry.add_abstraction_functions(
+        move(projection_functions));
+}
+
 string get_rovner_et_al_reference() {
     return utils::format_conference_reference(
         {"Alexander Rovner", "Silvan Sievers", "Malte Helmert"},
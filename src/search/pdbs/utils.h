@@ -10,6 +10,10 @@
 #include <memory>
 #include <string>
 
+namespace cost_saturation {
+class AbstractionRegistry;
+}
+
 namespace utils {
 class LogProxy;
 class RandomNumberGenerator;
@@ -61,6 +65,15 @@ extern void dump_pattern_collection_generation_statistics(
     const std::string &identifier, utils::Duration runtime,
     const PatternCollectionInformation &pci, utils::LogProxy &log);
 
+/*
+  Hand a projection function for each PDB to the given abstraction registry
+  and return their slots. Projections to the same pattern share a slot, so
+  all heuristics for the task rank each state only once per pattern.
+*/
+extern std::vector<int> add_pdbs_to_abstraction_registry(
+    const PDBCollection &pdbs,
+    cost_saturation::AbstractionRegistry &abstraction_registry);
+
 extern std::string get_rovner_et_al_reference();
 }
 
@@ -8,6 +8,7 @@
 
 #include "../utils/logging.h"
 
+#include <cassert>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -40,15 +41,15 @@ ZeroOnePDBs::ZeroOnePDBs(
     }
 }
 
-int ZeroOnePDBs::get_value(const State &state) const {
+int ZeroOnePDBs::get_value(const vector<int> &ranks) const {
     /*
       Because we use cost partitioning, we can simply add up all
       heuristic values of all patterns in the pattern collection.
     */
-    state.unpack();
+    assert(ranks.size() == pattern_databases.size());
     int h_val = 0;
-    for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
-        int pdb_value = pdb->get_value(state.get_unpacked_values());
+    for (size_t i = 0; i < pattern_databases.size(); ++i) {
+        int pdb_value = pattern_databases[i]->get_value_for_rank(ranks[i]);
         if (pdb_value == numeric_limits<int>::max())
             return numeric_limits<int>::max();
         h_val += pdb_value;
@@ -3,7 +3,6 @@
 
 #include "types.h"
 
-class State;
 class TaskProxy;
 
 namespace utils {
@@ -17,7 +16,12 @@ public:
     ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
     ~ZeroOnePDBs() = default;
 
-    int get_value(const State &state) const;
+    // Compute the value from the ranks of the state in all PDBs.
+    int get_value(const std::vector<int> &ranks) const;
+
+    const PDBCollection &get_pdbs() const {
+        return pattern_databases;
+    }
     /*
       Returns the sum of all mean finite h-values of every PDB.
       This is an approximation of the real mean finite h-value of the Heuristic,
@@ -1,5 +1,8 @@
 #include "zero_one_pdbs_heuristic.h"
 
+#include "utils.h"
+
+#include "../cost_saturation/abstraction_registry.h"
 #include "../plugins/plugin.h"
 
 #include <limits>
@@ -23,12 +26,22 @@ ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
     const shared_ptr<AbstractTask> &transform, bool cache_estimates,
     const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity),
-      zero_one_pdbs(get_zero_one_pdbs_from_generator(task, patterns)) {
+      zero_one_pdbs(get_zero_one_pdbs_from_generator(task, patterns)),
+      abstraction_registry(
+          cost_saturation::g_abstraction_registries[task_proxy]),
+      pdb_slots(add_pdbs_to_abstraction_registry(
+          zero_one_pdbs.get_pdbs(), abstraction_registry)) {
+}
+
+ZeroOnePDBsHeuristic::~ZeroOnePDBsHeuristic() {
+    abstraction_registry.remove_abstraction_functions(pdb_slots);
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int h = zero_one_pdbs.get_value(state);
+    abstraction_registry.set_state(ancestor_state, state);
+    int h = zero_one_pdbs.get_value(
+        abstraction_registry.get_abstract_state_ids(pdb_slots));
     if (h == numeric_limits<int>::max())
         return DEAD_END;
     return h;
@@ -6,11 +6,22 @@
 
 #include "../heuristic.h"
 
+namespace cost_saturation {
+class AbstractionRegistry;
+}
+
 namespace pdbs {
 class PatternDatabase;
 
+/*
+  The ranks of the evaluated state come from the abstraction registry of
+  the task, so that heuristics with the same patterns share them.
+*/
 class ZeroOnePDBsHeuristic : public Heuristic {
     ZeroOnePDBs zero_one_pdbs;
+    cost_saturation::AbstractionRegistry &abstraction_registry;
+    // Slot in the registry for each PDB.
+    std::vector<int> pdb_slots;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
@@ -18,6 +29,7 @@ public:
         const std::shared_ptr<PatternCollectionGenerator> &patterns,
         const std::shared_ptr<AbstractTask> &transform, bool cache_estimates,
         const std::string &name, utils::Verbosity verbosity);
+    virtual ~ZeroOnePDBsHeuristic() override;
 };
 }
 
@@ -66,6 +66,22 @@ void BitsetView::intersect(const BitsetView &other) {
     }
 }
 
+void BitsetView::intersect_with_union(
+    const ConstBitsetView &a, const ConstBitsetView &b) {
+    assert(num_bits == a.num_bits && num_bits == b.num_bits);
+    for (int i = 0; i < data.size(); ++i) {
+        data[i] &= a.data[i] | b.data[i];
+    }
+}
+
+void BitsetView::unite_with_difference(
+    const ConstBitsetView &a, const ConstBitsetView &b) {
+    assert(num_bits == a.num_bits && num_bits == b.num_bits);
+    for (int i = 0; i < data.size(); ++i) {
+        data[i] |= a.data[i] & ~b.data[i];
+    }
+}
+
 bool BitsetView::intersects(const BitsetView &other) const {
     assert(num_bits == other.num_bits);
     for (int i = 0; i < data.size(); ++i) {
@@ -25,6 +25,8 @@ public:
 class ConstBitsetView {
     ConstArrayView<BitsetMath::Block> data;
     int num_bits;
+
+    friend class BitsetView;
 public:
     ConstBitsetView(ConstArrayView<BitsetMath::Block> data, int num_bits);
 
@@ -70,6 +72,12 @@ public:
     void reset();
     bool test(int index) const;
     void intersect(const BitsetView &other);
+    // Block-wise *this &= (a | b).
+    void intersect_with_union(
+        const ConstBitsetView &a, const ConstBitsetView &b);
+    // Block-wise *this |= (a & ~b).
+    void unite_with_difference(
+        const ConstBitsetView &a, const ConstBitsetView &b);
     bool intersects(const BitsetView &other) const;
     int size() const;
 
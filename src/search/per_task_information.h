@@ -7,6 +7,7 @@
 #include "utils/hash.h"
 
 #include <functional>
+#include <mutex>
 
 /*
   A PerTaskInformation<T> acts like a HashMap<TaskID, T>
@@ -17,6 +18,10 @@
   (2) If a task is destroyed, its associated data in all PerTaskInformation
       objects is automatically destroyed as well.
 
+  Accessing and destroying entries is thread-safe: it is protected by the
+  mutex that also protects subscriptions to tasks. Entries are only
+  destroyed together with their tasks, so references to them remain valid
+  while the task exists.
 */
 template<class Entry>
 class PerTaskInformation : public subscriber::Subscriber<AbstractTask> {
@@ -49,6 +54,8 @@ public:
     }
 
     Entry &operator[](const TaskProxy &task_proxy) {
+        std::lock_guard<std::recursive_mutex> lock(
+            subscriber::get_subscription_mutex<AbstractTask>());
         TaskID id = task_proxy.get_id();
         const auto &it = entries.find(id);
         if (it == entries.end()) {
@@ -59,6 +66,8 @@ public:
     }
 
     virtual void notify_service_destroyed(const AbstractTask *task) override {
+        std::lock_guard<std::recursive_mutex> lock(
+            subscriber::get_subscription_mutex<AbstractTask>());
         TaskID id = TaskProxy(*task).get_id();
         entries.erase(id);
     }
@@ -34,14 +34,31 @@ int main(int argc, const char **argv) {
         if (static_cast<string>(argv[1]) != "--help") {
             utils::g_log << get_revision_info() << endl;
             utils::g_log << "reading input..." << endl;
-            tasks::read_root_task(cin);
+            string binary_input =
+                get_task_file_option(argc, argv, "--read-binary-task");
+            if (binary_input.empty()) {
+                tasks::read_root_task(cin);
+            } else {
+                tasks::read_root_task_from_binary_file(binary_input);
+            }
             utils::g_log << "done reading input!" << endl;
+            string binary_output =
+                get_task_file_option(argc, argv, "--write-binary-task");
+            if (!binary_output.empty()) {
+                utils::g_log << "writing binary task to " << binary_output
+                             << "..." << endl;
+                tasks::write_root_task_to_binary_file(binary_output);
+            }
             TaskProxy task_proxy(*tasks::g_root_task);
             unit_cost = task_properties::is_unit_cost(task_proxy);
         }
 
         shared_ptr<SearchAlgorithm> search_algorithm =
             parse_cmd_line(argc, argv, unit_cost);
+        if (!search_algorithm &&
+            !get_task_file_option(argc, argv, "--write-binary-task").empty()) {
+            utils::exit_with(ExitCode::SUCCESS);
+        }
 
         utils::Timer search_timer;
         search_algorithm->search();
@@ -6,6 +6,7 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
@@ -18,10 +19,11 @@ namespace potentials {
 DiversePotentialHeuristics::DiversePotentialHeuristics(
     int num_samples, int max_num_heuristics, double max_potential,
     lp::LPSolverType lpsolver, const shared_ptr<AbstractTask> &transform,
-    int random_seed, utils::Verbosity verbosity)
+    int random_seed, int num_threads, utils::Verbosity verbosity)
     : optimizer(transform, lpsolver, max_potential),
       max_num_heuristics(max_num_heuristics),
       num_samples(num_samples),
+      num_threads(num_threads),
       rng(utils::get_rng(random_seed)),
       log(utils::get_log_for_verbosity(verbosity)) {
 }
@@ -30,21 +32,28 @@ SamplesToFunctionsMap
 DiversePotentialHeuristics::filter_samples_and_compute_functions(
     const vector<State> &samples) {
     utils::Timer filtering_timer;
-    utils::HashSet<State> dead_ends;
     int num_duplicates = 0;
     int num_dead_ends = 0;
-    SamplesToFunctionsMap samples_to_functions;
+    vector<State> unique_samples;
+    utils::HashSet<State> seen;
     for (const State &sample : samples) {
         // Skipping duplicates is not necessary, but saves LP evaluations.
-        if (samples_to_functions.count(sample) || dead_ends.count(sample)) {
+        if (seen.insert(sample).second) {
+            unique_samples.push_back(sample);
+        } else {
             ++num_duplicates;
-            continue;
         }
-        optimizer.optimize_for_state(sample);
-        if (optimizer.has_optimal_solution()) {
-            samples_to_functions[sample] = optimizer.get_potential_function();
+    }
+
+    /* Solve the LPs for all samples (in parallel) and then insert the results
+       in sample order, which yields the same map for all numbers of threads. */
+    vector<unique_ptr<PotentialFunction>> functions =
+        optimize_for_each_state(optimizer, unique_samples, num_threads);
+    SamplesToFunctionsMap samples_to_functions;
+    for (size_t i = 0; i < unique_samples.size(); ++i) {
+        if (functions[i]) {
+            samples_to_functions[unique_samples[i]] = move(functions[i]);
         } else {
-            dead_ends.insert(sample);
             ++num_dead_ends;
         }
     }
@@ -133,7 +142,8 @@ DiversePotentialHeuristics::find_functions() {
 
     // Sample states.
     vector<State> samples =
-        sample_without_dead_end_detection(optimizer, num_samples, *rng);
+        sample_without_dead_end_detection(
+        optimizer, num_samples, *rng, num_threads);
 
     // Filter dead end samples.
     SamplesToFunctionsMap samples_to_functions =
@@ -167,6 +177,7 @@ public:
         add_admissible_potentials_options_to_feature(
             *this, "diverse_potentials");
         utils::add_rng_options_to_feature(*this);
+        utils::add_parallel_options_to_feature(*this);
     }
 
     virtual shared_ptr<PotentialMaxHeuristic> create_component(
@@ -178,7 +189,7 @@ public:
                 opts.get<double>("max_potential"),
                 opts.get<lp::LPSolverType>("lpsolver"),
                 opts.get<shared_ptr<AbstractTask>>("transform"),
-                opts.get<int>("random_seed"),
+                opts.get<int>("random_seed"), opts.get<int>("threads"),
                 opts.get<utils::Verbosity>("verbosity"))
                 .find_functions(),
             opts.get<shared_ptr<AbstractTask>>("transform"),
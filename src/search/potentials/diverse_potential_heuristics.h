@@ -30,6 +30,7 @@ class DiversePotentialHeuristics {
     // with num_samples parameter?
     const int max_num_heuristics;
     const int num_samples;
+    const int num_threads;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
     utils::LogProxy log;
     std::vector<std::unique_ptr<PotentialFunction>> diverse_functions;
@@ -58,7 +59,7 @@ public:
         int num_samples, int max_num_heuristics, double max_potential,
         lp::LPSolverType lpsolver,
         const std::shared_ptr<AbstractTask> &transform, int random_seed,
-        utils::Verbosity verbosity);
+        int num_threads, utils::Verbosity verbosity);
     ~DiversePotentialHeuristics() = default;
 
     // Sample states, then cover them.
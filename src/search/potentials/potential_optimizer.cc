@@ -23,6 +23,7 @@ PotentialOptimizer::PotentialOptimizer(
     double max_potential)
     : task(transform),
       task_proxy(*task),
+      lp_solver_type(lpsolver),
       lp_solver(lpsolver),
       max_potential(max_potential),
       num_lp_vars(0) {
@@ -90,6 +91,11 @@ void PotentialOptimizer::optimize_for_samples(const vector<State> &samples) {
     solve_and_extract();
 }
 
+unique_ptr<PotentialOptimizer>
+PotentialOptimizer::create_independent_copy() const {
+    return make_unique<PotentialOptimizer>(task, lp_solver_type, max_potential);
+}
+
 shared_ptr<AbstractTask> PotentialOptimizer::get_task() const {
     return task;
 }
@@ -44,6 +44,7 @@ class PotentialFunction;
 class PotentialOptimizer {
     std::shared_ptr<AbstractTask> task;
     TaskProxy task_proxy;
+    const lp::LPSolverType lp_solver_type;
     lp::LPSolver lp_solver;
     const double max_potential;
     int num_lp_vars;
@@ -62,6 +63,13 @@ public:
         lp::LPSolverType lpsolver, double max_potential);
     ~PotentialOptimizer() = default;
 
+    /*
+      Return a new optimizer for the same task with its own LP solver. This
+      allows solving LPs in parallel since LP solvers may not be shared
+      between threads.
+    */
+    std::unique_ptr<PotentialOptimizer> create_independent_copy() const;
+
     std::shared_ptr<AbstractTask> get_task() const;
     bool potentials_are_bounded() const;
 
@@ -4,6 +4,7 @@
 #include "util.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -14,24 +15,25 @@ using namespace std;
 
 namespace potentials {
 static void filter_dead_ends(
-    PotentialOptimizer &optimizer, vector<State> &samples) {
+    PotentialOptimizer &optimizer, vector<State> &samples, int num_threads) {
     assert(!optimizer.potentials_are_bounded());
+    vector<unique_ptr<PotentialFunction>> functions =
+        optimize_for_each_state(optimizer, samples, num_threads);
     vector<State> non_dead_end_samples;
-    for (const State &sample : samples) {
-        optimizer.optimize_for_state(sample);
-        if (optimizer.has_optimal_solution())
-            non_dead_end_samples.push_back(sample);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (functions[i])
+            non_dead_end_samples.push_back(samples[i]);
     }
     swap(samples, non_dead_end_samples);
 }
 
 static void optimize_for_samples(
     PotentialOptimizer &optimizer, int num_samples,
-    utils::RandomNumberGenerator &rng) {
-    vector<State> samples =
-        sample_without_dead_end_detection(optimizer, num_samples, rng);
+    utils::RandomNumberGenerator &rng, int num_threads) {
+    vector<State> samples = sample_without_dead_end_detection(
+        optimizer, num_samples, rng, num_threads);
     if (!optimizer.potentials_are_bounded()) {
-        filter_dead_ends(optimizer, samples);
+        filter_dead_ends(optimizer, samples, num_threads);
     }
     optimizer.optimize_for_samples(samples);
 }
@@ -44,12 +46,12 @@ static vector<unique_ptr<PotentialFunction>>
 create_sample_based_potential_functions(
     int num_samples, int num_heuristics, double max_potential,
     lp::LPSolverType lpsolver, const shared_ptr<AbstractTask> &transform,
-    int random_seed) {
+    int random_seed, int num_threads) {
     vector<unique_ptr<PotentialFunction>> functions;
     PotentialOptimizer optimizer(transform, lpsolver, max_potential);
     shared_ptr<utils::RandomNumberGenerator> rng(utils::get_rng(random_seed));
     for (int i = 0; i < num_heuristics; ++i) {
-        optimize_for_samples(optimizer, num_samples, *rng);
+        optimize_for_samples(optimizer, num_samples, *rng, num_threads);
         functions.push_back(optimizer.get_potential_function());
     }
     return functions;
@@ -74,6 +76,7 @@ public:
         add_admissible_potentials_options_to_feature(
             *this, "sample_based_potentials");
         utils::add_rng_options_to_feature(*this);
+        utils::add_parallel_options_to_feature(*this);
     }
 
     virtual shared_ptr<PotentialMaxHeuristic> create_component(
@@ -84,7 +87,7 @@ public:
                 opts.get<double>("max_potential"),
                 opts.get<lp::LPSolverType>("lpsolver"),
                 opts.get<shared_ptr<AbstractTask>>("transform"),
-                opts.get<int>("random_seed")),
+                opts.get<int>("random_seed"), opts.get<int>("threads")),
             opts.get<shared_ptr<AbstractTask>>("transform"),
             opts.get<bool>("cache_estimates"), opts.get<string>("description"),
             opts.get<utils::Verbosity>("verbosity"));
@@ -8,7 +8,10 @@
 #include "../plugins/plugin.h"
 #include "../task_utils/sampling.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
+#include "../utils/rng.h"
 
+#include <iterator>
 #include <limits>
 
 using namespace std;
@@ -16,21 +19,75 @@ using namespace std;
 namespace potentials {
 vector<State> sample_without_dead_end_detection(
     PotentialOptimizer &optimizer, int num_samples,
-    utils::RandomNumberGenerator &rng) {
+    utils::RandomNumberGenerator &rng, int num_threads) {
     const shared_ptr<AbstractTask> task = optimizer.get_task();
     const TaskProxy task_proxy(*task);
     State initial_state = task_proxy.get_initial_state();
     optimizer.optimize_for_state(initial_state);
     int init_h = optimizer.get_potential_function()->get_value(initial_state);
-    sampling::RandomWalkSampler sampler(task_proxy, rng);
+
+    if (num_threads == 1) {
+        sampling::RandomWalkSampler sampler(task_proxy, rng);
+        vector<State> samples;
+        samples.reserve(num_samples);
+        for (int i = 0; i < num_samples; ++i) {
+            samples.push_back(sampler.sample_state(init_h));
+        }
+        return samples;
+    }
+
+    // Draw all seeds up front to make the result independent of scheduling.
+    vector<int> seeds;
+    seeds.reserve(num_threads);
+    for (int block = 0; block < num_threads; ++block) {
+        seeds.push_back(rng.random(numeric_limits<int>::max()));
+    }
+    vector<vector<State>> samples_by_block(num_threads);
+    utils::parallel_for(num_threads, num_threads, [&](int, int block) {
+        int begin = (static_cast<long long>(num_samples) * block) / num_threads;
+        int end =
+            (static_cast<long long>(num_samples) * (block + 1)) / num_threads;
+        utils::RandomNumberGenerator block_rng(seeds[block]);
+        sampling::RandomWalkSampler sampler(task_proxy, block_rng);
+        vector<State> &block_samples = samples_by_block[block];
+        block_samples.reserve(end - begin);
+        for (int i = begin; i < end; ++i) {
+            block_samples.push_back(sampler.sample_state(init_h));
+        }
+    });
+
     vector<State> samples;
     samples.reserve(num_samples);
-    for (int i = 0; i < num_samples; ++i) {
-        samples.push_back(sampler.sample_state(init_h));
+    for (vector<State> &block_samples : samples_by_block) {
+        move(
+            block_samples.begin(), block_samples.end(),
+            back_inserter(samples));
     }
     return samples;
 }
 
+vector<unique_ptr<PotentialFunction>> optimize_for_each_state(
+    PotentialOptimizer &optimizer, const vector<State> &states,
+    int num_threads) {
+    vector<unique_ptr<PotentialOptimizer>> copies(num_threads);
+    vector<unique_ptr<PotentialFunction>> functions(states.size());
+    utils::parallel_for(
+        states.size(), num_threads, [&](int thread_id, int state_id) {
+            PotentialOptimizer *local_optimizer = &optimizer;
+            if (thread_id > 0) {
+                if (!copies[thread_id]) {
+                    copies[thread_id] = optimizer.create_independent_copy();
+                }
+                local_optimizer = copies[thread_id].get();
+            }
+            local_optimizer->optimize_for_state(states[state_id]);
+            if (local_optimizer->has_optimal_solution()) {
+                functions[state_id] = local_optimizer->get_potential_function();
+            }
+        });
+    return functions;
+}
+
 string get_admissible_potentials_reference() {
     return "The algorithm is based on" +
            utils::format_conference_reference(
@@ -21,11 +21,28 @@ class RandomNumberGenerator;
 }
 
 namespace potentials {
+class PotentialFunction;
 class PotentialOptimizer;
 
+/*
+  Sample states with random walks. For num_threads > 1, the samples are
+  split into num_threads blocks, each of which is sampled with an
+  independent random number generator seeded from rng. The result is
+  deterministic for a given number of threads.
+*/
 std::vector<State> sample_without_dead_end_detection(
     PotentialOptimizer &optimizer, int num_samples,
-    utils::RandomNumberGenerator &rng);
+    utils::RandomNumberGenerator &rng, int num_threads);
+
+/*
+  Optimize a separate potential function for each given state and return the
+  functions in the order of the states. The entry for a state is nullptr if
+  the LP has no optimal solution for it. For num_threads > 1, each worker
+  thread uses its own copy of the optimizer.
+*/
+std::vector<std::unique_ptr<PotentialFunction>> optimize_for_each_state(
+    PotentialOptimizer &optimizer, const std::vector<State> &states,
+    int num_threads);
 
 std::string get_admissible_potentials_reference();
 void add_admissible_potentials_options_to_feature(
@@ -1,13 +1,23 @@
 #include "stubborn_sets.h"
 
+#include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
+#include "../utils/collections.h"
 #include "../utils/logging.h"
 
 using namespace std;
 
 namespace stubborn_sets {
-StubbornSets::StubbornSets(utils::Verbosity verbosity)
-    : PruningMethod(verbosity), num_operators(-1) {
+StubbornSets::StubbornSets(
+    double min_required_pruning_ratio,
+    int expansions_before_checking_pruning_ratio, utils::Verbosity verbosity)
+    : PruningMethod(verbosity),
+      min_required_pruning_ratio(min_required_pruning_ratio),
+      num_expansions_before_checking_pruning_ratio(
+          expansions_before_checking_pruning_ratio),
+      num_pruning_calls(0),
+      is_pruning_disabled(false),
+      num_operators(-1) {
 }
 
 void StubbornSets::initialize(const shared_ptr<AbstractTask> &task) {
@@ -56,7 +66,44 @@ void StubbornSets::compute_achievers(const TaskProxy &task_proxy) {
     }
 }
 
+bool StubbornSets::should_disable_pruning() const {
+    double pruning_ratio =
+        (num_successors_before_pruning == 0)
+            ? 1.
+            : 1. - (static_cast<double>(num_successors_after_pruning) /
+                    static_cast<double>(num_successors_before_pruning));
+    if (log.is_at_least_normal()) {
+        log << "Pruning ratio after "
+            << num_expansions_before_checking_pruning_ratio
+            << " calls: " << pruning_ratio << endl;
+    }
+    return pruning_ratio < min_required_pruning_ratio;
+}
+
+void StubbornSets::release_memory() {
+    utils::release_vector_memory(sorted_op_preconditions);
+    utils::release_vector_memory(sorted_op_effects);
+    utils::release_vector_memory(achievers);
+    utils::release_vector_memory(stubborn);
+}
+
 void StubbornSets::prune(const State &state, vector<OperatorID> &op_ids) {
+    if (is_pruning_disabled) {
+        return;
+    }
+    if (num_pruning_calls == num_expansions_before_checking_pruning_ratio &&
+        min_required_pruning_ratio > 0. && should_disable_pruning()) {
+        if (log.is_at_least_normal()) {
+            log << "-- pruning ratio is lower than minimum pruning ratio ("
+                << min_required_pruning_ratio << ") -> switching off pruning"
+                << endl;
+        }
+        is_pruning_disabled = true;
+        release_memory();
+        return;
+    }
+    ++num_pruning_calls;
+
     // Clear stubborn set from previous call.
     stubborn.assign(num_operators, false);
 
@@ -72,4 +119,32 @@ void StubbornSets::prune(const State &state, vector<OperatorID> &op_ids) {
     }
     op_ids.swap(remaining_op_ids);
 }
+
+void add_stubborn_sets_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<double>(
+        "min_required_pruning_ratio",
+        "disable pruning if the pruning ratio is lower than this value after"
+        " 'expansions_before_checking_pruning_ratio' expansions",
+        "0.0", plugins::Bounds("0.0", "1.0"));
+    feature.add_option<int>(
+        "expansions_before_checking_pruning_ratio",
+        "number of expansions before deciding whether to disable pruning",
+        "1000", plugins::Bounds("0", "infinity"));
+    add_pruning_options_to_feature(feature);
+    feature.document_note(
+        "Adaptive pruning",
+        "With ``min_required_pruning_ratio > 0``, stubborn sets switch "
+        "themselves off like LimitedPruning does, but without the additional "
+        "pruning method in between. Once pruning is disabled, the memory "
+        "used for computing stubborn sets is released.");
+}
+
+tuple<double, int, utils::Verbosity> get_stubborn_sets_arguments_from_options(
+    const plugins::Options &opts) {
+    return tuple_cat(
+        make_tuple(
+            opts.get<double>("min_required_pruning_ratio"),
+            opts.get<int>("expansions_before_checking_pruning_ratio")),
+        get_pruning_arguments_from_options(opts));
+}
 }
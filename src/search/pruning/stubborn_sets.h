@@ -4,11 +4,28 @@
 #include "../pruning_method.h"
 #include "../task_proxy.h"
 
+namespace plugins {
+class Feature;
+class Options;
+}
+
 namespace stubborn_sets {
 inline FactPair find_unsatisfied_condition(
     const std::vector<FactPair> &conditions, const State &state);
 
 class StubbornSets : public PruningMethod {
+    /*
+      Adaptive mode: like LimitedPruning, we switch off pruning if the pruning
+      ratio is too low after a given number of expansions. Doing this here
+      avoids the additional indirection and allows releasing the memory used
+      for computing stubborn sets once pruning is disabled.
+    */
+    const double min_required_pruning_ratio;
+    const int num_expansions_before_checking_pruning_ratio;
+    int num_pruning_calls;
+    bool is_pruning_disabled;
+
+    bool should_disable_pruning() const;
     void compute_sorted_operators(const TaskProxy &task_proxy);
     void compute_achievers(const TaskProxy &task_proxy);
     virtual void prune(
@@ -55,11 +72,21 @@ protected:
     }
 
     virtual void compute_stubborn_set(const State &state) = 0;
+
+    // Free data structures that are only needed for computing stubborn sets.
+    virtual void release_memory();
 public:
-    explicit StubbornSets(utils::Verbosity verbosity);
+    StubbornSets(
+        double min_required_pruning_ratio,
+        int expansions_before_checking_pruning_ratio,
+        utils::Verbosity verbosity);
     virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
 };
 
+extern void add_stubborn_sets_options_to_feature(plugins::Feature &feature);
+extern std::tuple<double, int, utils::Verbosity>
+get_stubborn_sets_arguments_from_options(const plugins::Options &opts);
+
 // Return the first unsatified condition, or FactPair::no_fact if there is none.
 inline FactPair find_unsatisfied_condition(
     const std::vector<FactPair> &conditions, const State &state) {
@@ -23,8 +23,12 @@ static bool contain_conflicting_fact(
     return false;
 }
 
-StubbornSetsActionCentric::StubbornSetsActionCentric(utils::Verbosity verbosity)
-    : StubbornSets(verbosity) {
+StubbornSetsActionCentric::StubbornSetsActionCentric(
+    double min_required_pruning_ratio,
+    int expansions_before_checking_pruning_ratio, utils::Verbosity verbosity)
+    : StubbornSets(
+          min_required_pruning_ratio, expansions_before_checking_pruning_ratio,
+          verbosity) {
 }
 
 void StubbornSetsActionCentric::compute_stubborn_set(const State &state) {
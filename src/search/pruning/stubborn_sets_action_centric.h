@@ -17,7 +17,10 @@ class StubbornSetsActionCentric : public stubborn_sets::StubbornSets {
     virtual void handle_stubborn_operator(const State &state, int op_no) = 0;
     virtual void compute_stubborn_set(const State &state) override;
 protected:
-    explicit StubbornSetsActionCentric(utils::Verbosity verbosity);
+    StubbornSetsActionCentric(
+        double min_required_pruning_ratio,
+        int expansions_before_checking_pruning_ratio,
+        utils::Verbosity verbosity);
     bool can_disable(int op1_no, int op2_no) const;
     bool can_conflict(int op1_no, int op2_no) const;
 
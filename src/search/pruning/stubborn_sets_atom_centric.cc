@@ -11,8 +11,11 @@ using namespace std;
 namespace stubborn_sets_atom_centric {
 StubbornSetsAtomCentric::StubbornSetsAtomCentric(
     bool use_sibling_shortcut, AtomSelectionStrategy atom_selection_strategy,
-    utils::Verbosity verbosity)
-    : StubbornSets(verbosity),
+    double min_required_pruning_ratio,
+    int expansions_before_checking_pruning_ratio, utils::Verbosity verbosity)
+    : StubbornSets(
+          min_required_pruning_ratio, expansions_before_checking_pruning_ratio,
+          verbosity),
       use_sibling_shortcut(use_sibling_shortcut),
       atom_selection_strategy(atom_selection_strategy) {
 }
@@ -283,7 +286,7 @@ public:
             "the goal atoms. All strategies use the fast_downward strategy for "
             "breaking ties.",
             "quick_skip");
-        add_pruning_options_to_feature(*this);
+        stubborn_sets::add_stubborn_sets_options_to_feature(*this);
     }
 
     virtual shared_ptr<StubbornSetsAtomCentric> create_component(
@@ -291,7 +294,7 @@ public:
         return plugins::make_shared_from_arg_tuples<StubbornSetsAtomCentric>(
             opts.get<bool>("use_sibling_shortcut"),
             opts.get<AtomSelectionStrategy>("atom_selection_strategy"),
-            get_pruning_arguments_from_options(opts));
+            stubborn_sets::get_stubborn_sets_arguments_from_options(opts));
     }
 };
 
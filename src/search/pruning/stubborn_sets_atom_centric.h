@@ -56,6 +56,8 @@ public:
     explicit StubbornSetsAtomCentric(
         bool use_sibling_shortcut,
         AtomSelectionStrategy atom_selection_strategy,
+        double min_required_pruning_ratio,
+        int expansions_before_checking_pruning_ratio,
         utils::Verbosity verbosity);
     virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
 };
@@ -101,8 +101,12 @@ static void get_conflicting_vars(
     }
 }
 
-StubbornSetsEC::StubbornSetsEC(utils::Verbosity verbosity)
-    : StubbornSetsActionCentric(verbosity) {
+StubbornSetsEC::StubbornSetsEC(
+    double min_required_pruning_ratio,
+    int expansions_before_checking_pruning_ratio, utils::Verbosity verbosity)
+    : StubbornSetsActionCentric(
+          min_required_pruning_ratio, expansions_before_checking_pruning_ratio,
+          verbosity) {
 }
 
 void StubbornSetsEC::initialize(const shared_ptr<AbstractTask> &task) {
@@ -350,13 +354,13 @@ public:
                 "Proceedings of the 23rd International Conference on Automated Planning "
                 "and Scheduling (ICAPS 2013)",
                 "251-259", "AAAI Press", "2013"));
-        add_pruning_options_to_feature(*this);
+        stubborn_sets::add_stubborn_sets_options_to_feature(*this);
     }
 
     virtual shared_ptr<StubbornSetsEC> create_component(
         const plugins::Options &opts) const override {
         return plugins::make_shared_from_arg_tuples<StubbornSetsEC>(
-            get_pruning_arguments_from_options(opts));
+            stubborn_sets::get_stubborn_sets_arguments_from_options(opts));
     }
 };
 
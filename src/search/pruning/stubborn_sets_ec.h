@@ -34,7 +34,10 @@ protected:
     virtual void handle_stubborn_operator(
         const State &state, int op_no) override;
 public:
-    explicit StubbornSetsEC(utils::Verbosity verbosity);
+    StubbornSetsEC(
+        double min_required_pruning_ratio,
+        int expansions_before_checking_pruning_ratio,
+        utils::Verbosity verbosity);
     virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
 };
 }
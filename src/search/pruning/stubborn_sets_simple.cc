@@ -1,21 +1,139 @@
 #include "stubborn_sets_simple.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 
+#include <bit>
+
 using namespace std;
 
 namespace stubborn_sets_simple {
-StubbornSetsSimple::StubbornSetsSimple(utils::Verbosity verbosity)
-    : StubbornSetsActionCentric(verbosity) {
+StubbornSetsSimple::StubbornSetsSimple(
+    int max_bit_matrices_memory_in_mb, double min_required_pruning_ratio,
+    int expansions_before_checking_pruning_ratio, utils::Verbosity verbosity)
+    : StubbornSetsActionCentric(
+          min_required_pruning_ratio, expansions_before_checking_pruning_ratio,
+          verbosity),
+      max_bit_matrices_memory_in_mb(max_bit_matrices_memory_in_mb),
+      use_bit_matrices(false),
+      num_blocks(0) {
 }
 
 void StubbornSetsSimple::initialize(const shared_ptr<AbstractTask> &task) {
     StubbornSets::initialize(task);
-    interference_relation.resize(num_operators);
-    interference_relation_computed.resize(num_operators, false);
+    TaskProxy task_proxy(*task);
+    int num_facts = 0;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        fact_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+    }
+    num_blocks = (num_operators + bits_per_block - 1) / bits_per_block;
+    double matrices_memory_in_mb =
+        static_cast<double>(num_operators + num_facts) * num_blocks *
+        sizeof(Block) / (1024 * 1024);
+    use_bit_matrices = max_bit_matrices_memory_in_mb > 0 &&
+                       matrices_memory_in_mb <= max_bit_matrices_memory_in_mb;
+    if (use_bit_matrices) {
+        compute_bit_matrices(task_proxy, num_facts);
+        stubborn_blocks.resize(num_blocks);
+    } else {
+        utils::release_vector_memory(fact_offsets);
+        interference_relation.resize(num_operators);
+        interference_relation_computed.resize(num_operators, false);
+    }
     log << "pruning method: stubborn sets simple" << endl;
+    if (log.is_at_least_normal()) {
+        log << "Memory for interference and achiever bit matrices: "
+            << matrices_memory_in_mb << " MiB -> "
+            << (use_bit_matrices ? "precompute" : "compute lazily") << endl;
+    }
+}
+
+void StubbornSetsSimple::compute_bit_matrices(
+    const TaskProxy &task_proxy, int num_facts) {
+    /*
+      Two operators interfere iff one of them has an effect that conflicts
+      with a precondition or an effect of the other one. We collect the
+      operators with a precondition and with an effect on each variable, so
+      that we only need to look at operators that mention the same variables.
+    */
+    int num_variables = task_proxy.get_variables().size();
+    using OperatorValues = vector<pair<int, int>>;
+    vector<OperatorValues> precondition_ops_by_var(num_variables);
+    vector<OperatorValues> effect_ops_by_var(num_variables);
+    for (int op_no = 0; op_no < num_operators; ++op_no) {
+        for (const FactPair &pre : sorted_op_preconditions[op_no]) {
+            precondition_ops_by_var[pre.var].emplace_back(op_no, pre.value);
+        }
+        for (const FactPair &eff : sorted_op_effects[op_no]) {
+            effect_ops_by_var[eff.var].emplace_back(op_no, eff.value);
+        }
+    }
+
+    auto set_bit = [](Block *row, int op_no) {
+        row[op_no / bits_per_block] |= Block(1) << (op_no % bits_per_block);
+    };
+    auto add_conflicting = [&](Block *row, const OperatorValues &op_values,
+                               int value) {
+        for (auto [op2_no, value2] : op_values) {
+            if (value2 != value) {
+                set_bit(row, op2_no);
+            }
+        }
+    };
+
+    interference_matrix.assign(
+        static_cast<size_t>(num_operators) * num_blocks, 0);
+    for (int op_no = 0; op_no < num_operators; ++op_no) {
+        Block *row = get_interference_row(op_no);
+        for (const FactPair &eff : sorted_op_effects[op_no]) {
+            // op disables op2 or op and op2 conflict.
+            add_conflicting(row, precondition_ops_by_var[eff.var], eff.value);
+            add_conflicting(row, effect_ops_by_var[eff.var], eff.value);
+        }
+        for (const FactPair &pre : sorted_op_preconditions[op_no]) {
+            // op2 disables op.
+            add_conflicting(row, effect_ops_by_var[pre.var], pre.value);
+        }
+        // Operators do not interfere with themselves.
+        row[op_no / bits_per_block] &= ~(Block(1) << (op_no % bits_per_block));
+    }
+
+    achiever_matrix.assign(static_cast<size_t>(num_facts) * num_blocks, 0);
+    for (int var = 0; var < num_variables; ++var) {
+        for (size_t value = 0; value < achievers[var].size(); ++value) {
+            Block *row = get_achiever_row(FactPair(var, value));
+            for (int op_no : achievers[var][value]) {
+                set_bit(row, op_no);
+            }
+        }
+    }
+}
+
+void StubbornSetsSimple::add_operators(const Block *row) {
+    for (int block = 0; block < num_blocks; ++block) {
+        Block new_ops = row[block] & ~stubborn_blocks[block];
+        if (new_ops) {
+            stubborn_blocks[block] |= new_ops;
+            while (new_ops) {
+                int op_no = block * bits_per_block + countr_zero(new_ops);
+                enqueue_stubborn_operator(op_no);
+                new_ops &= new_ops - 1;
+            }
+        }
+    }
+}
+
+void StubbornSetsSimple::release_memory() {
+    StubbornSetsActionCentric::release_memory();
+    utils::release_vector_memory(interference_relation);
+    utils::release_vector_memory(interference_relation_computed);
+    utils::release_vector_memory(fact_offsets);
+    utils::release_vector_memory(interference_matrix);
+    utils::release_vector_memory(achiever_matrix);
+    utils::release_vector_memory(stubborn_blocks);
 }
 
 const vector<int> &StubbornSetsSimple::get_interfering_operators(int op1_no) {
@@ -39,6 +157,10 @@ const vector<int> &StubbornSetsSimple::get_interfering_operators(int op1_no) {
 
 // Add all operators that achieve the fact (var, value) to stubborn set.
 void StubbornSetsSimple::add_necessary_enabling_set(const FactPair &fact) {
+    if (use_bit_matrices) {
+        add_operators(get_achiever_row(fact));
+        return;
+    }
     for (int op_no : achievers[fact.var][fact.value]) {
         enqueue_stubborn_operator(op_no);
     }
@@ -46,12 +168,19 @@ void StubbornSetsSimple::add_necessary_enabling_set(const FactPair &fact) {
 
 // Add all operators that interfere with op.
 void StubbornSetsSimple::add_interfering(int op_no) {
+    if (use_bit_matrices) {
+        add_operators(get_interference_row(op_no));
+        return;
+    }
     for (int interferer_no : get_interfering_operators(op_no)) {
         enqueue_stubborn_operator(interferer_no);
     }
 }
 
 void StubbornSetsSimple::initialize_stubborn_set(const State &state) {
+    if (use_bit_matrices) {
+        fill(stubborn_blocks.begin(), stubborn_blocks.end(), 0);
+    }
     // Add a necessary enabling set for an unsatisfied goal.
     FactPair unsatisfied_goal = find_unsatisfied_goal(state);
     assert(unsatisfied_goal != FactPair::no_fact);
@@ -101,13 +230,20 @@ public:
                 "Proceedings of the 24th International Conference on Automated Planning "
                 " and Scheduling (ICAPS 2014)",
                 "323-331", "AAAI Press", "2014"));
-        add_pruning_options_to_feature(*this);
+        add_option<int>(
+            "max_bit_matrices_memory",
+            "maximum memory in MiB for precomputing the interference relation "
+            "and the achievers as bit matrices. If the matrices need more "
+            "memory, the interference relation is computed lazily instead.",
+            "0", plugins::Bounds("0", "infinity"));
+        stubborn_sets::add_stubborn_sets_options_to_feature(*this);
     }
 
     virtual shared_ptr<StubbornSetsSimple> create_component(
         const plugins::Options &opts) const override {
         return plugins::make_shared_from_arg_tuples<StubbornSetsSimple>(
-            get_pruning_arguments_from_options(opts));
+            opts.get<int>("max_bit_matrices_memory"),
+            stubborn_sets::get_stubborn_sets_arguments_from_options(opts));
     }
 };
 
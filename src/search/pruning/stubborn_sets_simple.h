@@ -3,15 +3,47 @@
 
 #include "stubborn_sets_action_centric.h"
 
+#include <cstdint>
+
 namespace stubborn_sets_simple {
 /* Implementation of simple instantiation of strong stubborn sets.
    Disjunctive action landmarks are computed trivially.*/
 class StubbornSetsSimple : public stubborn_sets::StubbornSetsActionCentric {
+    using Block = uint64_t;
+    static const int bits_per_block = 64;
+
+    const int max_bit_matrices_memory_in_mb;
+
     /* interference_relation[op1_no] contains all operator indices
        of operators that interfere with op1. */
     std::vector<std::vector<int>> interference_relation;
     std::vector<bool> interference_relation_computed;
 
+    /*
+      If they fit into the memory limit, we precompute the interference
+      relation and the achievers as bit matrices with one row per operator and
+      one row per fact, respectively. Each row has a bit for each operator.
+      Adding all operators of a row to the stubborn set then works on whole
+      blocks of operators at once.
+    */
+    bool use_bit_matrices;
+    int num_blocks;
+    std::vector<int> fact_offsets;
+    std::vector<Block> interference_matrix;
+    std::vector<Block> achiever_matrix;
+    // Bit representation of the stubborn set if bit matrices are used.
+    std::vector<Block> stubborn_blocks;
+
+    Block *get_interference_row(int op_no) {
+        return &interference_matrix[static_cast<size_t>(op_no) * num_blocks];
+    }
+    Block *get_achiever_row(const FactPair &fact) {
+        size_t fact_id = fact_offsets[fact.var] + fact.value;
+        return &achiever_matrix[fact_id * num_blocks];
+    }
+    void compute_bit_matrices(const TaskProxy &task_proxy, int num_facts);
+    void add_operators(const Block *row);
+
     void add_necessary_enabling_set(const FactPair &fact);
     void add_interfering(int op_no);
 
@@ -24,8 +56,12 @@ protected:
     virtual void initialize_stubborn_set(const State &state) override;
     virtual void handle_stubborn_operator(
         const State &state, int op_no) override;
+    virtual void release_memory() override;
 public:
-    explicit StubbornSetsSimple(utils::Verbosity verbosity);
+    StubbornSetsSimple(
+        int max_bit_matrices_memory_in_mb, double min_required_pruning_ratio,
+        int expansions_before_checking_pruning_ratio,
+        utils::Verbosity verbosity);
     virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
 };
 }
@@ -22,12 +22,15 @@ using namespace std;
 using utils::ExitCode;
 
 static successor_generator::SuccessorGenerator &get_successor_generator(
-    const TaskProxy &task_proxy, utils::LogProxy &log) {
+    const TaskProxy &task_proxy,
+    successor_generator::SuccessorGeneratorType type, utils::LogProxy &log) {
     log << "Building successor generator... " << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator &successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        (type == successor_generator::SuccessorGeneratorType::COMPILED)
+            ? successor_generator::g_compiled_successor_generators[task_proxy]
+            : successor_generator::g_successor_generators[task_proxy];
     successor_generator_timer.stop();
     log << "done!" << endl;
     int peak_memory_after = utils::get_peak_memory_in_kb();
@@ -41,6 +44,7 @@ static successor_generator::SuccessorGenerator &get_successor_generator(
 
 SearchAlgorithm::SearchAlgorithm(
     OperatorCost cost_type, int bound, double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
     const string &description, utils::Verbosity verbosity)
     : description(description),
       status(IN_PROGRESS),
@@ -49,7 +53,8 @@ SearchAlgorithm::SearchAlgorithm(
       task_proxy(*task),
       log(utils::get_log_for_verbosity(verbosity)),
       state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy, log)),
+      successor_generator(
+          get_successor_generator(task_proxy, successor_generator_type, log)),
       search_space(state_registry, log),
       statistics(log),
       bound(bound),
@@ -79,7 +84,11 @@ SearchAlgorithm::SearchAlgorithm(
       log(utils::get_log_for_verbosity(
           opts.get<utils::Verbosity>("verbosity"))),
       state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy, log)),
+      successor_generator(get_successor_generator(
+          task_proxy,
+          opts.get<successor_generator::SuccessorGeneratorType>(
+              "successor_generator"),
+          log)),
       search_space(state_registry, log),
       statistics(log),
       cost_type(opts.get<OperatorCost>("cost_type")),
@@ -143,7 +152,8 @@ bool SearchAlgorithm::check_goal_and_set_plan(const State &state) {
         log << "Solution found!" << endl;
         utils::Timer recompute_timer;
         Plan plan =
-            search_space.trace_path(task_proxy, successor_generator, state);
+            search_space.trace_path(
+                task_proxy, successor_generator, state, cost_type);
         recompute_timer.stop();
         log << "Time for recomputing plan: " << recompute_timer << endl;
         set_plan(plan);
@@ -232,18 +242,26 @@ void add_search_algorithm_options_to_feature(
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    feature.add_option<successor_generator::SuccessorGeneratorType>(
+        "successor_generator",
+        "data structure for computing the applicable operators of states",
+        "tree");
     feature.add_option<string>(
         "description", "description used to identify search algorithm in logs",
         "\"" + description + "\"");
     utils::add_log_options_to_feature(feature);
 }
 
-tuple<OperatorCost, int, double, string, utils::Verbosity>
+tuple<
+    OperatorCost, int, double, successor_generator::SuccessorGeneratorType,
+    string, utils::Verbosity>
 get_search_algorithm_arguments_from_options(const plugins::Options &opts) {
     return tuple_cat(
         ::get_cost_type_arguments_from_options(opts),
         make_tuple(
             opts.get<int>("bound"), opts.get<double>("max_time"),
+            opts.get<successor_generator::SuccessorGeneratorType>(
+                "successor_generator"),
             opts.get<string>("description")),
         utils::get_log_arguments_from_options(opts));
 }
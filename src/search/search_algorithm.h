@@ -27,6 +27,7 @@ class OrderedSet;
 
 namespace successor_generator {
 class SuccessorGenerator;
+enum class SuccessorGeneratorType;
 }
 
 enum SearchStatus {
@@ -86,6 +87,7 @@ protected:
 public:
     SearchAlgorithm(
         OperatorCost cost_type, int bound, double max_time,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
         const std::string &description, utils::Verbosity verbosity);
     explicit SearchAlgorithm(
         const plugins::Options
@@ -140,7 +142,9 @@ extern std::tuple<std::shared_ptr<PruningMethod>>
 get_search_pruning_arguments_from_options(const plugins::Options &opts);
 extern void add_search_algorithm_options_to_feature(
     plugins::Feature &feature, const std::string &description);
-extern std::tuple<OperatorCost, int, double, std::string, utils::Verbosity>
+extern std::tuple<
+    OperatorCost, int, double, successor_generator::SuccessorGeneratorType,
+    std::string, utils::Verbosity>
 get_search_algorithm_arguments_from_options(const plugins::Options &opts);
 extern void add_successors_order_options_to_feature(plugins::Feature &feature);
 extern std::tuple<bool, bool, int> get_successors_order_arguments_from_options(
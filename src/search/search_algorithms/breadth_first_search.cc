@@ -20,7 +20,8 @@ BreadthFirstSearch::BreadthFirstSearch(
     const string &description, utils::Verbosity verbosity)
     : SearchAlgorithm(
           ONE, numeric_limits<int>::max(), numeric_limits<double>::infinity(),
-          description, verbosity),
+          successor_generator::SuccessorGeneratorType::TREE, description,
+          verbosity),
       single_plan(single_plan),
       write_plan(write_plan),
       last_plan_cost(-1),
@@ -15,8 +15,11 @@ static const int INF = numeric_limits<int>::max();
 
 DepthFirstSearch::DepthFirstSearch(
     bool single_plan, OperatorCost cost_type, int bound, double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
     const string &description, utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       single_plan(single_plan),
       max_depth(0),
       cheapest_plan_cost(INF) {
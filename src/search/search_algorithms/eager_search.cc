@@ -13,6 +13,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <set>
@@ -25,10 +26,14 @@ EagerSearch::EagerSearch(
     const shared_ptr<Evaluator> &f_eval,
     const vector<shared_ptr<Evaluator>> &preferred,
     const shared_ptr<PruningMethod> &pruning,
-    const shared_ptr<Evaluator> &lazy_evaluator, OperatorCost cost_type,
-    int bound, double max_time, const string &description,
-    utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    const shared_ptr<Evaluator> &lazy_evaluator, int max_delta_chain_length,
+    SearchNodeInfoType search_node_info, OperatorCost cost_type, int bound,
+    double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       reopen_closed_nodes(reopen_closed),
       open_list(open->create_state_open_list()),
       f_evaluator(f_eval), // default nullptr
@@ -39,9 +44,27 @@ EagerSearch::EagerSearch(
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
+    if (search_node_info != SearchNodeInfoType::FULL && reopen_closed) {
+        cerr << "search_node_info without g values requires "
+             << "reopen_closed=false" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    state_registry.enable_delta_compression(max_delta_chain_length);
+    search_space.set_node_info_type(search_node_info);
 }
 
 void EagerSearch::initialize() {
+    /*
+      We check the bound here since iterated search sets it after
+      construction. Without g values, we never notice cheaper paths to open
+      states, so their real g values would stay too high for pruning.
+    */
+    if (search_space.get_node_info_type() != SearchNodeInfoType::FULL &&
+        bound != numeric_limits<int>::max()) {
+        cerr << "search_node_info without g values does not support a "
+             << "finite bound" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
     log << "Conducting best first search"
         << (reopen_closed_nodes ? " with" : " without")
         << " reopening closed nodes, (real) bound = " << bound << endl;
@@ -350,16 +373,36 @@ void add_eager_search_options_to_feature(
     add_search_pruning_options_to_feature(feature);
     // We do not add a lazy_evaluator options here
     // because it is only used for astar but not the other plugins.
+    feature.add_option<int>(
+        "max_delta_chain_length",
+        "store registered states as the difference to their parent state "
+        "instead of storing their packed data. A state is stored in packed "
+        "form if it would otherwise be reconstructed from more than this "
+        "number of ancestors. Larger values save more memory but make state "
+        "lookups slower. Use 0 to store all states in packed form.",
+        "0", plugins::Bounds("0", "255"));
+    feature.add_option<SearchNodeInfoType>(
+        "search_node_info",
+        "information stored for each search node. Without g values, all "
+        "evaluators see g = 0 and the parent of a node is the first state "
+        "that reached it, so only use the options other than 'full' for "
+        "searches that ignore g values, such as greedy best-first search. "
+        "They require reopen_closed=false and an infinite bound.",
+        "full");
     add_search_algorithm_options_to_feature(feature, description);
 }
 
 tuple<
-    shared_ptr<PruningMethod>, shared_ptr<Evaluator>, OperatorCost, int, double,
+    shared_ptr<PruningMethod>, shared_ptr<Evaluator>, int, SearchNodeInfoType,
+    OperatorCost, int, double, successor_generator::SuccessorGeneratorType,
     string, utils::Verbosity>
 get_eager_search_arguments_from_options(const plugins::Options &opts) {
     return tuple_cat(
         get_search_pruning_arguments_from_options(opts),
-        make_tuple(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
+        make_tuple(
+            opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr),
+            opts.get<int>("max_delta_chain_length"),
+            opts.get<SearchNodeInfoType>("search_node_info")),
         get_search_algorithm_arguments_from_options(opts));
 }
 }
@@ -51,7 +51,9 @@ public:
         const std::vector<std::shared_ptr<Evaluator>> &preferred,
         const std::shared_ptr<PruningMethod> &pruning,
         const std::shared_ptr<Evaluator> &lazy_evaluator,
+        int max_delta_chain_length, SearchNodeInfoType search_node_info,
         OperatorCost cost_type, int bound, double max_time,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
         const std::string &description, utils::Verbosity verbosity);
 
     virtual void print_statistics() const override;
@@ -62,8 +64,9 @@ public:
 extern void add_eager_search_options_to_feature(
     plugins::Feature &feature, const std::string &description);
 extern std::tuple<
-    std::shared_ptr<PruningMethod>, std::shared_ptr<Evaluator>, OperatorCost,
-    int, double, std::string, utils::Verbosity>
+    std::shared_ptr<PruningMethod>, std::shared_ptr<Evaluator>, int,
+    SearchNodeInfoType, OperatorCost, int, double,
+    successor_generator::SuccessorGeneratorType, std::string, utils::Verbosity>
 get_eager_search_arguments_from_options(const plugins::Options &opts);
 }
 
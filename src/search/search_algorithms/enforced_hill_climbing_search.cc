@@ -51,9 +51,12 @@ static shared_ptr<OpenListFactory> create_ehc_open_list_factory(
 EnforcedHillClimbingSearch::EnforcedHillClimbingSearch(
     const shared_ptr<Evaluator> &h, PreferredUsage preferred_usage,
     const vector<shared_ptr<Evaluator>> &preferred, OperatorCost cost_type,
-    int bound, double max_time, const string &description,
-    utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    int bound, double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       evaluator(h),
       preferred_operator_evaluators(preferred),
       preferred_usage(preferred_usage),
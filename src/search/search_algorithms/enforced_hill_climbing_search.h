@@ -61,6 +61,7 @@ public:
         const std::shared_ptr<Evaluator> &h, PreferredUsage preferred_usage,
         const std::vector<std::shared_ptr<Evaluator>> &preferred,
         OperatorCost cost_type, int bound, double max_time,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
         const std::string &description, utils::Verbosity verbosity);
 
     virtual void print_statistics() const override;
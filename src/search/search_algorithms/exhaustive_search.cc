@@ -1,11 +1,15 @@
 #include "exhaustive_search.h"
 
+#include "../algorithms/int_packer.h"
 #include "../plugins/plugin.h"
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/system.h"
 
 #include <cassert>
+#include <cstdint>
+#include <fstream>
 
 using namespace std;
 
@@ -15,9 +19,10 @@ static bool is_strips_fact(const string &fact_name) {
            fact_name.rfind("NegatedAtom", 0) == string::npos;
 }
 
-static vector<vector<int>> construct_and_dump_fact_mapping(
+static const string atom_prefix = "Atom ";
+
+static vector<vector<int>> construct_fact_mapping(
     const TaskProxy &task_proxy) {
-    string atom_prefix = "Atom ";
     int num_variables = task_proxy.get_variables().size();
     vector<vector<int>> mapping(num_variables);
     int next_atom_index = 0;
@@ -29,8 +34,6 @@ static vector<vector<int>> construct_and_dump_fact_mapping(
                 task_proxy.get_variables()[var].get_fact(val).get_name();
             if (is_strips_fact(fact_name)) {
                 mapping[var][val] = next_atom_index;
-                cout << "F " << next_atom_index << " "
-                     << fact_name.substr(atom_prefix.size()) << endl;
                 ++next_atom_index;
             } else {
                 mapping[var][val] = -1;
@@ -40,23 +43,280 @@ static vector<vector<int>> construct_and_dump_fact_mapping(
     return mapping;
 }
 
-ExhaustiveSearch::ExhaustiveSearch()
+static void dump_fact_mapping(
+    const TaskProxy &task_proxy, const vector<vector<int>> &mapping) {
+    for (size_t var = 0; var < mapping.size(); ++var) {
+        for (size_t val = 0; val < mapping[var].size(); ++val) {
+            int fact_id = mapping[var][val];
+            if (fact_id != -1) {
+                string fact_name =
+                    task_proxy.get_variables()[var].get_fact(val).get_name();
+                cout << "F " << fact_id << " "
+                     << fact_name.substr(atom_prefix.size()) << endl;
+            }
+        }
+    }
+}
+
+/*
+  Binary dump format (all integers are stored in little-endian order):
+
+  Header:
+    "FDSSDUMP", uint32 version, uint32 flags (bit 0: compressed),
+    uint32 number of variables, uint32 bins per state. For each variable:
+    uint32 domain size, bin index, shift and read mask of the variable in
+    packed states (bins are uint32 values), and for each value the int32
+    fact ID (-1 for non-STRIPS facts), the varint length of the fact name
+    and the name.
+
+  Chunks:
+    "CHNK", uint32 ID of the first state, uint32 number of states, uint64
+    payload size. The payload contains the states in the order of their
+    IDs. For each state, we store a uint8 goal flag, the packed state, the
+    varint number of transitions and the targets of the transitions as
+    zigzag varints, each relative to the previous target (the first one
+    relative to the source state).
+
+    With compression, each packed state is XORed with the previous state
+    of the chunk and stored as a sequence of (varint number of zero bytes,
+    varint number of literal bytes, literal bytes) triples.
+
+  Index:
+    uint32 number of chunks, and for each chunk the uint32 ID of its
+    first state and the uint64 file offset of the chunk.
+
+  Footer:
+    uint64 file offset of the index, "FDSSINDX".
+
+  The reader in misc/read-state-space-dump.py documents how to decode the
+  dump and converts it to the text format.
+*/
+static const uint32_t BINARY_DUMP_VERSION = 1;
+static const uint32_t COMPRESSED_FLAG = 1;
+
+class BinaryDumpWriter {
+    const int num_bins;
+    const int bytes_per_state;
+    const int states_per_chunk;
+    const bool compress;
+    string filename;
+    vector<char> stream_buffer;
+    ofstream file;
+
+    vector<uint8_t> payload;
+    vector<uint8_t> previous_state;
+    // Little-endian representation of the current packed state.
+    vector<uint8_t> state_bytes;
+    int first_state_id_in_chunk;
+    int num_states_in_chunk;
+    vector<pair<uint32_t, uint64_t>> chunk_index;
+    uint64_t num_bytes_written;
+
+    template<typename T>
+    static void append_fixed(vector<uint8_t> &buffer, T value) {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    static void append_varint(vector<uint8_t> &buffer, uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^
+               static_cast<uint64_t>(value >> 63);
+    }
+
+    void write(const vector<uint8_t> &buffer) {
+        file.write(
+            reinterpret_cast<const char *>(buffer.data()), buffer.size());
+        if (!file) {
+            cerr << "Could not write to " << filename << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        num_bytes_written += buffer.size();
+    }
+
+    void append_state(const uint8_t *state) {
+        if (!compress) {
+            payload.insert(payload.end(), state, state + bytes_per_state);
+            return;
+        }
+        vector<uint8_t> delta(bytes_per_state);
+        for (int i = 0; i < bytes_per_state; ++i) {
+            delta[i] = state[i] ^ previous_state[i];
+        }
+        int pos = 0;
+        while (pos < bytes_per_state) {
+            int zeros_begin = pos;
+            while (pos < bytes_per_state && delta[pos] == 0) {
+                ++pos;
+            }
+            int literals_begin = pos;
+            while (pos < bytes_per_state && delta[pos] != 0) {
+                ++pos;
+            }
+            append_varint(payload, literals_begin - zeros_begin);
+            append_varint(payload, pos - literals_begin);
+            payload.insert(
+                payload.end(), delta.begin() + literals_begin,
+                delta.begin() + pos);
+        }
+        previous_state.assign(state, state + bytes_per_state);
+    }
+
+    void flush_chunk() {
+        if (num_states_in_chunk == 0) {
+            return;
+        }
+        chunk_index.emplace_back(first_state_id_in_chunk, num_bytes_written);
+        vector<uint8_t> chunk_header = {'C', 'H', 'N', 'K'};
+        append_fixed<uint32_t>(chunk_header, first_state_id_in_chunk);
+        append_fixed<uint32_t>(chunk_header, num_states_in_chunk);
+        append_fixed<uint64_t>(chunk_header, payload.size());
+        write(chunk_header);
+        write(payload);
+        payload.clear();
+        first_state_id_in_chunk += num_states_in_chunk;
+        num_states_in_chunk = 0;
+        fill(previous_state.begin(), previous_state.end(), 0);
+    }
+public:
+    BinaryDumpWriter(
+        const string &filename, const TaskProxy &task_proxy,
+        const int_packer::IntPacker &state_packer,
+        const vector<vector<int>> &fact_mapping, int states_per_chunk,
+        bool compress)
+        : num_bins(state_packer.get_num_bins()),
+          bytes_per_state(num_bins * sizeof(PackedStateBin)),
+          states_per_chunk(states_per_chunk),
+          compress(compress),
+          filename(filename),
+          stream_buffer(1 << 20),
+          previous_state(bytes_per_state, 0),
+          first_state_id_in_chunk(0),
+          num_states_in_chunk(0),
+          num_bytes_written(0) {
+        // We only write large blocks, but a large buffer doesn't hurt.
+        file.rdbuf()->pubsetbuf(stream_buffer.data(), stream_buffer.size());
+        file.open(filename, ios::binary);
+        if (!file) {
+            cerr << "Could not open " << filename << " for writing" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+
+        vector<uint8_t> header = {'F', 'D', 'S', 'S', 'D', 'U', 'M', 'P'};
+        append_fixed<uint32_t>(header, BINARY_DUMP_VERSION);
+        append_fixed<uint32_t>(header, compress ? COMPRESSED_FLAG : 0);
+        VariablesProxy variables = task_proxy.get_variables();
+        append_fixed<uint32_t>(header, variables.size());
+        append_fixed<uint32_t>(header, state_packer.get_num_bins());
+        for (VariableProxy var : variables) {
+            int var_id = var.get_id();
+            append_fixed<uint32_t>(header, var.get_domain_size());
+            append_fixed<uint32_t>(header, state_packer.get_bin_index(var_id));
+            append_fixed<uint32_t>(header, state_packer.get_shift(var_id));
+            append_fixed<uint32_t>(header, state_packer.get_read_mask(var_id));
+            for (int value = 0; value < var.get_domain_size(); ++value) {
+                int fact_id = fact_mapping[var_id][value];
+                string name = var.get_fact(value).get_name();
+                if (fact_id != -1) {
+                    name = name.substr(atom_prefix.size());
+                }
+                append_fixed<uint32_t>(header, fact_id);
+                append_varint(header, name.size());
+                header.insert(header.end(), name.begin(), name.end());
+            }
+        }
+        write(header);
+    }
+
+    void add_state(
+        const PackedStateBin *buffer, bool is_goal,
+        const vector<int> &successor_ids) {
+        int state_id = first_state_id_in_chunk + num_states_in_chunk;
+        payload.push_back(is_goal);
+        state_bytes.clear();
+        for (int i = 0; i < num_bins; ++i) {
+            append_fixed<PackedStateBin>(state_bytes, buffer[i]);
+        }
+        append_state(state_bytes.data());
+        append_varint(payload, successor_ids.size());
+        int64_t previous_id = state_id;
+        for (int succ_id : successor_ids) {
+            append_varint(payload, zigzag(succ_id - previous_id));
+            previous_id = succ_id;
+        }
+        if (++num_states_in_chunk == states_per_chunk) {
+            flush_chunk();
+        }
+    }
+
+    void finish() {
+        flush_chunk();
+        uint64_t index_offset = num_bytes_written;
+        vector<uint8_t> index;
+        append_fixed<uint32_t>(index, chunk_index.size());
+        for (const auto &[first_state_id, offset] : chunk_index) {
+            append_fixed<uint32_t>(index, first_state_id);
+            append_fixed<uint64_t>(index, offset);
+        }
+        append_fixed<uint64_t>(index, index_offset);
+        for (char c : string("FDSSINDX")) {
+            index.push_back(c);
+        }
+        write(index);
+        file.close();
+    }
+
+    uint64_t get_num_bytes_written() const {
+        return num_bytes_written;
+    }
+
+    int get_num_chunks() const {
+        return chunk_index.size();
+    }
+};
+
+ExhaustiveSearch::ExhaustiveSearch(
+    DumpFormat format, const string &filename, int states_per_chunk,
+    bool compress)
     : SearchAlgorithm(
           ONE, numeric_limits<int>::max(), numeric_limits<double>::infinity(),
-          "dump_reachable_search_space", utils::Verbosity::NORMAL) {
+          successor_generator::SuccessorGeneratorType::TREE,
+          "dump_reachable_search_space", utils::Verbosity::NORMAL),
+      format(format),
+      filename(filename),
+      states_per_chunk(states_per_chunk),
+      compress(compress) {
 }
 
+ExhaustiveSearch::~ExhaustiveSearch() = default;
+
 void ExhaustiveSearch::initialize() {
     utils::g_log << "Dumping the reachable state space..." << endl;
-    cout << "# F (fact): [fact ID] [name]" << endl;
-    cout << "# G (goal state): [goal state ID] [fact ID 1] [fact ID 2] ..."
-         << endl;
-    cout
-        << "# N (non-goal state): [non-goal state ID] [fact ID 1] [fact ID 2] ..."
-        << endl;
-    cout << "# T (transition): [source state ID] [target state ID]" << endl;
-    cout << "# The initial state has ID 0." << endl;
-    fact_mapping = construct_and_dump_fact_mapping(task_proxy);
+    fact_mapping = construct_fact_mapping(task_proxy);
+    if (format == DumpFormat::TEXT) {
+        cout << "# F (fact): [fact ID] [name]" << endl;
+        cout << "# G (goal state): [goal state ID] [fact ID 1] [fact ID 2] ..."
+             << endl;
+        cout
+            << "# N (non-goal state): [non-goal state ID] [fact ID 1] [fact ID 2] ..."
+            << endl;
+        cout << "# T (transition): [source state ID] [target state ID]" << endl;
+        cout << "# The initial state has ID 0." << endl;
+        dump_fact_mapping(task_proxy, fact_mapping);
+    } else {
+        utils::g_log << "Writing binary dump to " << filename << endl;
+        binary_dump = make_unique<BinaryDumpWriter>(
+            filename, task_proxy, state_registry.get_state_packer(),
+            fact_mapping, states_per_chunk, compress);
+    }
     assert(state_registry.size() <= 1);
     State initial_state = state_registry.get_initial_state();
     statistics.inc_generated();
@@ -67,6 +327,13 @@ void ExhaustiveSearch::initialize() {
 void ExhaustiveSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    if (binary_dump) {
+        utils::g_log << "Binary dump chunks: " << binary_dump->get_num_chunks()
+                     << endl;
+        utils::g_log << "Binary dump size: "
+                     << binary_dump->get_num_bytes_written() << " bytes"
+                     << endl;
+    }
 }
 
 void ExhaustiveSearch::dump_state(const State &state) const {
@@ -85,13 +352,18 @@ void ExhaustiveSearch::dump_state(const State &state) const {
 
 SearchStatus ExhaustiveSearch::step() {
     if (current_state_id == static_cast<int>(state_registry.size())) {
+        if (binary_dump) {
+            binary_dump->finish();
+        }
         utils::g_log << "Finished dumping the reachable state space." << endl;
         return SOLVED;
     }
 
     State s = state_registry.lookup_state(StateID(current_state_id));
     statistics.inc_expanded();
-    dump_state(s);
+    if (format == DumpFormat::TEXT) {
+        dump_state(s);
+    }
 
     /* Next time we'll look at the next state that was created in the registry.
        This results in a breadth-first order. */
@@ -101,13 +373,24 @@ SearchStatus ExhaustiveSearch::step() {
     successor_generator.generate_applicable_ops(s, applicable_op_ids);
 
     OperatorsProxy operators = task_proxy.get_operators();
+    vector<int> successor_ids;
+    successor_ids.reserve(applicable_op_ids.size());
     for (OperatorID op_id : applicable_op_ids) {
         // Add successor states to registry.
         State succ_state =
             state_registry.get_successor_state(s, operators[op_id]);
         statistics.inc_generated();
-        cout << "T " << s.get_id().value << " " << succ_state.get_id().value
-             << endl;
+        successor_ids.push_back(succ_state.get_id().value);
+    }
+
+    if (format == DumpFormat::TEXT) {
+        for (int succ_id : successor_ids) {
+            cout << "T " << s.get_id().value << " " << succ_id << endl;
+        }
+    } else {
+        binary_dump->add_state(
+            s.get_buffer(), task_properties::is_goal_state(task_proxy, s),
+            successor_ids);
     }
     return IN_PROGRESS;
 }
@@ -118,13 +401,40 @@ public:
     ExhaustiveSearchFeature() : TypedFeature("dump_reachable_search_space") {
         document_title("Exhaustive search");
         document_synopsis("Dump the reachable state space.");
+        add_option<DumpFormat>("format", "output format", "text");
+        add_option<string>(
+            "filename", "file for the binary dump", "\"state_space.dump\"");
+        add_option<int>(
+            "states_per_chunk",
+            "number of states per chunk of the binary dump",
+            "65536", plugins::Bounds("1", "infinity"));
+        add_option<bool>(
+            "compress",
+            "store each state of the binary dump as the XOR difference to "
+            "the previous state with run-length encoded zero bytes",
+            "false");
+
+        document_note(
+            "Binary format",
+            "The binary format stores packed states, varint-encoded "
+            "transitions and an index of all chunks. It is several times "
+            "smaller and much faster to write than the text format. Use "
+            "misc/read-state-space-dump.py to read it or to convert it to "
+            "the text format.");
     }
 
     virtual shared_ptr<ExhaustiveSearch> create_component(
-        const plugins::Options &) const override {
-        return plugins::make_shared_from_arg_tuples<ExhaustiveSearch>();
+        const plugins::Options &opts) const override {
+        return plugins::make_shared_from_arg_tuples<ExhaustiveSearch>(
+            opts.get<DumpFormat>("format"), opts.get<string>("filename"),
+            opts.get<int>("states_per_chunk"), opts.get<bool>("compress"));
     }
 };
 
 static plugins::FeaturePlugin<ExhaustiveSearchFeature> _plugin;
+
+static plugins::TypedEnumPlugin<DumpFormat> _enum_plugin({
+    {"text", "write facts, states and transitions as text to stdout"},
+    {"binary", "write a chunked binary dump to the given file"},
+});
 }
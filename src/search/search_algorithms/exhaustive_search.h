@@ -3,8 +3,23 @@
 
 #include "../search_algorithm.h"
 
+#include <memory>
+#include <string>
+
 namespace exhaustive_search {
+class BinaryDumpWriter;
+
+enum class DumpFormat {
+    TEXT,
+    BINARY
+};
+
 class ExhaustiveSearch : public SearchAlgorithm {
+    const DumpFormat format;
+    const std::string filename;
+    const int states_per_chunk;
+    const bool compress;
+    std::unique_ptr<BinaryDumpWriter> binary_dump;
     int current_state_id;
     std::vector<std::vector<int>> fact_mapping;
 
@@ -15,7 +30,10 @@ protected:
     virtual SearchStatus step() override;
 
 public:
-    ExhaustiveSearch();
+    ExhaustiveSearch(
+        DumpFormat format, const std::string &filename, int states_per_chunk,
+        bool compress);
+    virtual ~ExhaustiveSearch() override;
 
     virtual void print_statistics() const override;
 };
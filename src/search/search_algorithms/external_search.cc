@@ -0,0 +1,479 @@
+#include "external_search.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/collections.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <queue>
+
+using namespace std;
+
+namespace external_search {
+static bool less_state(
+    const PackedStateBin *state1, const PackedStateBin *state2, int num_bins) {
+    return lexicographical_compare(
+        state1, state1 + num_bins, state2, state2 + num_bins);
+}
+
+static bool equal_state(
+    const PackedStateBin *state1, const PackedStateBin *state2, int num_bins) {
+    return equal(state1, state1 + num_bins, state2);
+}
+
+static void remove_file(const string &filename) {
+    if (remove(filename.c_str()) != 0) {
+        cerr << "Could not remove file " << filename << endl;
+    }
+}
+
+/*
+  Write packed states sequentially to a binary file.
+*/
+class StateFileWriter {
+    const string filename;
+    ofstream stream;
+    const int num_bins;
+    int64_t num_states;
+public:
+    StateFileWriter(const string &filename, int num_bins)
+        : filename(filename),
+          stream(filename, ios::binary | ios::trunc),
+          num_bins(num_bins),
+          num_states(0) {
+        if (!stream) {
+            cerr << "Could not open " << filename << " for writing." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+
+    void write(const PackedStateBin *state) {
+        stream.write(
+            reinterpret_cast<const char *>(state),
+            num_bins * sizeof(PackedStateBin));
+        ++num_states;
+    }
+
+    int64_t close() {
+        stream.close();
+        if (!stream) {
+            cerr << "Could not write " << filename << "." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        return num_states;
+    }
+};
+
+/*
+  Read packed states sequentially from a binary file in chunks.
+*/
+class StateFileReader {
+    static const int states_per_chunk = 4096;
+    ifstream stream;
+    const int num_bins;
+    vector<PackedStateBin> chunk;
+    int num_states_in_chunk;
+    int pos;
+public:
+    StateFileReader(const string &filename, int num_bins)
+        : stream(filename, ios::binary),
+          num_bins(num_bins),
+          chunk(states_per_chunk * num_bins),
+          num_states_in_chunk(0),
+          pos(-1) {
+        if (!stream) {
+            cerr << "Could not open " << filename << " for reading." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+
+    // Advance to the next state. Return false if there is none.
+    bool next() {
+        ++pos;
+        if (pos == num_states_in_chunk) {
+            if (!stream) {
+                return false;
+            }
+            stream.read(
+                reinterpret_cast<char *>(chunk.data()),
+                chunk.size() * sizeof(PackedStateBin));
+            num_states_in_chunk =
+                stream.gcount() / (num_bins * sizeof(PackedStateBin));
+            pos = 0;
+        }
+        return pos < num_states_in_chunk;
+    }
+
+    const PackedStateBin *get() const {
+        assert(pos >= 0 && pos < num_states_in_chunk);
+        return &chunk[pos * num_bins];
+    }
+};
+
+ExternalSearch::ExternalSearch(
+    const string &directory, int buffer_memory, OperatorCost cost_type,
+    double max_time, const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          cost_type, numeric_limits<int>::max(), max_time,
+          successor_generator::SuccessorGeneratorType::TREE, description,
+          verbosity),
+      directory(directory),
+      max_buffered_states(
+          max<int64_t>(
+              1, static_cast<int64_t>(buffer_memory) * 1024 * 1024 /
+                     (state_registry.get_state_packer().get_num_bins() *
+                      sizeof(PackedStateBin)))),
+      state_packer(state_registry.get_state_packer()),
+      num_bins(state_packer.get_num_bins()),
+      num_buffered_states(0),
+      num_files_created(0),
+      num_bytes_written(0) {
+}
+
+ExternalSearch::~ExternalSearch() {
+    current_layer = nullptr;
+    for (const Layer &layer : layers) {
+        remove_file(layer.filename);
+    }
+    for (const auto &[g, bucket] : buckets) {
+        for (const string &run : bucket.runs) {
+            remove_file(run);
+        }
+    }
+}
+
+string ExternalSearch::get_new_filename(const string &kind) {
+    return directory + "/external-search-" +
+           to_string(utils::get_process_id()) + "-" +
+           to_string(num_files_created++) + "-" + kind + ".bin";
+}
+
+vector<int> ExternalSearch::unpack(const PackedStateBin *buffer) const {
+    int num_variables = task_proxy.get_variables().size();
+    vector<int> values(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        values[var] = state_packer.get(buffer, var);
+    }
+    return values;
+}
+
+void ExternalSearch::pack(
+    const vector<int> &values, PackedStateBin *buffer) const {
+    for (size_t var = 0; var < values.size(); ++var) {
+        state_packer.set(buffer, var, values[var]);
+    }
+}
+
+void ExternalSearch::insert_into_bucket(int g, const vector<int> &values) {
+    vector<PackedStateBin> &buffer = buckets[g].buffer;
+    size_t offset = buffer.size();
+    buffer.resize(offset + num_bins, 0);
+    pack(values, &buffer[offset]);
+    ++num_buffered_states;
+    if (num_buffered_states >= max_buffered_states) {
+        flush_all_buckets();
+    }
+}
+
+// Sort the buffer, remove duplicates and write it to a new run file.
+void ExternalSearch::write_run(Bucket &bucket) {
+    vector<PackedStateBin> &buffer = bucket.buffer;
+    int num_states = buffer.size() / num_bins;
+    if (num_states == 0) {
+        return;
+    }
+    vector<int> order(num_states);
+    iota(order.begin(), order.end(), 0);
+    auto get_state = [&](int index) {
+        return &buffer[static_cast<size_t>(index) * num_bins];
+    };
+    sort(order.begin(), order.end(), [&](int i, int j) {
+        return less_state(get_state(i), get_state(j), num_bins);
+    });
+
+    string filename = get_new_filename("run");
+    StateFileWriter writer(filename, num_bins);
+    const PackedStateBin *last = nullptr;
+    for (int index : order) {
+        const PackedStateBin *state = get_state(index);
+        if (!last || !equal_state(last, state, num_bins)) {
+            writer.write(state);
+            last = state;
+        }
+    }
+    num_bytes_written += writer.close() * num_bins * sizeof(PackedStateBin);
+    bucket.runs.push_back(filename);
+    num_buffered_states -= num_states;
+    utils::release_vector_memory(buffer);
+}
+
+void ExternalSearch::flush_all_buckets() {
+    for (auto &[g, bucket] : buckets) {
+        write_run(bucket);
+    }
+    assert(num_buffered_states == 0);
+}
+
+/*
+  Merge the sorted runs into a single sorted file without duplicates and
+  store the number of states in the file in num_states.
+*/
+string ExternalSearch::merge_runs(
+    const vector<string> &runs, int64_t &num_states) {
+    vector<unique_ptr<StateFileReader>> readers;
+    using Entry = int;
+    auto greater_entry = [&](Entry i, Entry j) {
+        return less_state(readers[j]->get(), readers[i]->get(), num_bins);
+    };
+    priority_queue<Entry, vector<Entry>, decltype(greater_entry)> queue(
+        greater_entry);
+    for (const string &run : runs) {
+        readers.push_back(make_unique<StateFileReader>(run, num_bins));
+        if (readers.back()->next()) {
+            queue.push(readers.size() - 1);
+        }
+    }
+
+    string filename = get_new_filename("merged");
+    StateFileWriter writer(filename, num_bins);
+    vector<PackedStateBin> last;
+    while (!queue.empty()) {
+        Entry entry = queue.top();
+        queue.pop();
+        const PackedStateBin *state = readers[entry]->get();
+        if (last.empty() || !equal_state(last.data(), state, num_bins)) {
+            writer.write(state);
+            last.assign(state, state + num_bins);
+        }
+        if (readers[entry]->next()) {
+            queue.push(entry);
+        }
+    }
+    num_states = writer.close();
+    num_bytes_written += num_states * num_bins * sizeof(PackedStateBin);
+    readers.clear();
+    for (const string &run : runs) {
+        remove_file(run);
+    }
+    return filename;
+}
+
+/*
+  Return a new file with all candidate states that do not occur in the layer
+  and store the number of states in the new file in num_states.
+*/
+string ExternalSearch::subtract_layer(
+    const string &candidates, const Layer &layer, int64_t &num_states) {
+    StateFileReader candidate_reader(candidates, num_bins);
+    StateFileReader layer_reader(layer.filename, num_bins);
+    string filename = get_new_filename("candidates");
+    StateFileWriter writer(filename, num_bins);
+    bool has_layer_state = layer_reader.next();
+    while (candidate_reader.next()) {
+        const PackedStateBin *state = candidate_reader.get();
+        while (has_layer_state &&
+               less_state(layer_reader.get(), state, num_bins)) {
+            has_layer_state = layer_reader.next();
+        }
+        if (!has_layer_state ||
+            !equal_state(layer_reader.get(), state, num_bins)) {
+            writer.write(state);
+        }
+    }
+    num_states = writer.close();
+    num_bytes_written += num_states * num_bins * sizeof(PackedStateBin);
+    remove_file(candidates);
+    return filename;
+}
+
+/*
+  Turn the bucket with the lowest g value into the next layer by removing
+  duplicates. Return false if there are no more states to expand.
+*/
+bool ExternalSearch::start_next_layer() {
+    while (!buckets.empty()) {
+        auto it = buckets.begin();
+        int g = it->first;
+        Bucket &bucket = it->second;
+        write_run(bucket);
+        vector<string> runs = move(bucket.runs);
+        buckets.erase(it);
+
+        int64_t num_states;
+        string filename = merge_runs(runs, num_states);
+        for (const Layer &layer : layers) {
+            filename = subtract_layer(filename, layer, num_states);
+        }
+        if (num_states == 0) {
+            remove_file(filename);
+            continue;
+        }
+        layers.push_back({g, filename, num_states});
+        log << "Layer " << layers.size() - 1 << " [g=" << g << ", "
+            << num_states << " states]" << endl;
+        current_layer = make_unique<StateFileReader>(filename, num_bins);
+        return true;
+    }
+    return false;
+}
+
+void ExternalSearch::initialize() {
+    log << "Conducting external-memory search, storing layers in "
+        << directory << endl;
+    State initial_state = task_proxy.get_initial_state();
+    statistics.inc_generated();
+    insert_into_bucket(0, initial_state.get_unpacked_values());
+    start_next_layer();
+}
+
+vector<OperatorID> ExternalSearch::trace_path(const vector<int> &goal) const {
+    vector<OperatorID> path;
+    vector<int> current = goal;
+    int current_layer_id = layers.size() - 1;
+    int current_g = layers.back().g;
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<OperatorID> applicable_op_ids;
+    while (current_layer_id > 0) {
+        bool found = false;
+        for (int layer_id = current_layer_id - 1; layer_id >= 0 && !found;
+             --layer_id) {
+            const Layer &layer = layers[layer_id];
+            int cost = current_g - layer.g;
+            assert(cost >= 0);
+            StateFileReader reader(layer.filename, num_bins);
+            while (!found && reader.next()) {
+                State state = task_proxy.create_state(unpack(reader.get()));
+                applicable_op_ids.clear();
+                successor_generator.generate_applicable_ops(
+                    state, applicable_op_ids);
+                for (OperatorID op_id : applicable_op_ids) {
+                    OperatorProxy op = operators[op_id];
+                    if (get_adjusted_cost(op) == cost &&
+                        state.get_unregistered_successor(op)
+                                .get_unpacked_values() == current) {
+                        path.push_back(op_id);
+                        current = state.get_unpacked_values();
+                        current_layer_id = layer_id;
+                        current_g = layer.g;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!found) {
+            cerr << "Could not reconstruct plan." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+SearchStatus ExternalSearch::step() {
+    while (!current_layer->next()) {
+        current_layer = nullptr;
+        if (!start_next_layer()) {
+            log << "Completely explored state space -- no solution!" << endl;
+            return UNSOLVABLE;
+        }
+    }
+
+    State state = task_proxy.create_state(unpack(current_layer->get()));
+    statistics.inc_expanded();
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        log << "Solution found!" << endl;
+        set_plan(trace_path(state.get_unpacked_values()));
+        return SOLVED;
+    }
+
+    int g = layers.back().g;
+    vector<OperatorID> applicable_op_ids;
+    successor_generator.generate_applicable_ops(state, applicable_op_ids);
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : applicable_op_ids) {
+        OperatorProxy op = operators[op_id];
+        State succ_state = state.get_unregistered_successor(op);
+        statistics.inc_generated();
+        insert_into_bucket(
+            g + get_adjusted_cost(op), succ_state.get_unpacked_values());
+    }
+    return IN_PROGRESS;
+}
+
+void ExternalSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    int64_t num_states = 0;
+    for (const Layer &layer : layers) {
+        num_states += layer.num_states;
+    }
+    log << "Layers: " << layers.size() << endl;
+    log << "States in layers: " << num_states << endl;
+    log << "Bytes written to disk: " << num_bytes_written << endl;
+}
+
+class ExternalSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, ExternalSearch> {
+public:
+    ExternalSearchFeature() : TypedFeature("external_search") {
+        document_title("External-memory uniform-cost search");
+        document_synopsis(
+            "Uniform-cost search that stores states on disk instead of in "
+            "memory. The search expands layers of states with the same "
+            "g value in order of increasing g. Duplicates are detected with "
+            "a delay by external merge sort: successors are collected in "
+            "sorted run files per g value and when a g value is expanded, "
+            "its runs are merged and all states from previous layers are "
+            "removed. Plans are reconstructed by scanning the layers "
+            "backwards. With cost_type=one, this is an external-memory "
+            "breadth-first search.");
+        add_option<string>(
+            "directory", "directory for storing the layer files", "\".\"");
+        add_option<int>(
+            "buffer_memory",
+            "memory in MiB for buffering successor states before writing "
+            "them to disk",
+            "256", plugins::Bounds("1", "infinity"));
+        ::add_cost_type_options_to_feature(*this);
+        add_option<double>(
+            "max_time",
+            "maximum time in seconds the search is allowed to run for",
+            "infinity");
+        add_option<string>(
+            "description",
+            "description used to identify search algorithm in logs",
+            "\"external_search\"");
+        utils::add_log_options_to_feature(*this);
+
+        document_note(
+            "Disk usage",
+            "Each expanded state is stored once on disk. All files are "
+            "removed when the search ends. Duplicate detection reads all "
+            "previous layers for each new layer, so the search is most "
+            "efficient for tasks with few distinct g values.");
+        document_language_support("action costs", "supported");
+        document_language_support("conditional effects", "supported");
+        document_language_support("axioms", "supported");
+        document_property("admissible", "yes");
+        document_property("complete", "yes");
+    }
+
+    virtual shared_ptr<ExternalSearch> create_component(
+        const plugins::Options &opts) const override {
+        return plugins::make_shared_from_arg_tuples<ExternalSearch>(
+            opts.get<string>("directory"), opts.get<int>("buffer_memory"),
+            ::get_cost_type_arguments_from_options(opts),
+            opts.get<double>("max_time"), opts.get<string>("description"),
+            utils::get_log_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<ExternalSearchFeature> _plugin;
+}
@@ -0,0 +1,95 @@
+#ifndef SEARCH_ALGORITHMS_EXTERNAL_SEARCH_H
+#define SEARCH_ALGORITHMS_EXTERNAL_SEARCH_H
+
+#include "../search_algorithm.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace int_packer {
+class IntPacker;
+}
+
+namespace external_search {
+class StateFileReader;
+
+/*
+  A layer contains all states with the same g value that were expanded
+  together. Layers are stored on disk as sorted files of packed states.
+*/
+struct Layer {
+    int g;
+    std::string filename;
+    int64_t num_states;
+};
+
+/*
+  Successor states for a given g value that have not been expanded yet. We
+  collect them in a buffer and write the buffer to a sorted run file once the
+  buffers of all buckets exceed the memory limit.
+*/
+struct Bucket {
+    std::vector<PackedStateBin> buffer;
+    std::vector<std::string> runs;
+};
+
+/*
+  Uniform-cost search with delayed duplicate detection in external memory.
+  The search expands layers of states with the same g value in order of
+  increasing g. Successors are only written to their bucket. Once a bucket
+  becomes the next layer, its runs are merged and all states that already
+  occur in previous layers are removed. Plans are reconstructed by scanning
+  the layers backwards.
+
+  NOTE:
+    Doesn't support bound.
+    Doesn't support pruning methods.
+*/
+class ExternalSearch : public SearchAlgorithm {
+    const std::string directory;
+    const int64_t max_buffered_states;
+    const int_packer::IntPacker &state_packer;
+    const int num_bins;
+
+    std::vector<Layer> layers;
+    std::map<int, Bucket> buckets;
+    int64_t num_buffered_states;
+    int num_files_created;
+    int64_t num_bytes_written;
+
+    // Reader for the layer that is currently being expanded.
+    std::unique_ptr<StateFileReader> current_layer;
+
+    std::string get_new_filename(const std::string &kind);
+    std::vector<int> unpack(const PackedStateBin *buffer) const;
+    void pack(const std::vector<int> &values, PackedStateBin *buffer) const;
+
+    void insert_into_bucket(int g, const std::vector<int> &values);
+    void write_run(Bucket &bucket);
+    void flush_all_buckets();
+    std::string merge_runs(
+        const std::vector<std::string> &runs, int64_t &num_states);
+    std::string subtract_layer(
+        const std::string &candidates, const Layer &layer,
+        int64_t &num_states);
+    bool start_next_layer();
+
+    std::vector<OperatorID> trace_path(const std::vector<int> &goal) const;
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+public:
+    ExternalSearch(
+        const std::string &directory, int buffer_memory,
+        OperatorCost cost_type, double max_time,
+        const std::string &description, utils::Verbosity verbosity);
+    virtual ~ExternalSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
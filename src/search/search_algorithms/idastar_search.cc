@@ -62,8 +62,12 @@ void FifoCache::clear() {
 IDAstarSearch::IDAstarSearch(
     const shared_ptr<Evaluator> &h_evaluator, int initial_f_limit,
     int cache_size, bool single_plan, OperatorCost cost_type, int bound,
-    double max_time, const string &description, utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       h_evaluator(h_evaluator),
       single_plan(single_plan),
       iteration(0),
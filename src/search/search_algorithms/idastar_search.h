@@ -61,8 +61,9 @@ public:
     IDAstarSearch(
         const std::shared_ptr<Evaluator> &h_evaluator, int initial_f_limit,
         int cache_size, bool single_plan, OperatorCost cost_type, int bound,
-        double max_time, const std::string &description,
-        utils::Verbosity verbosity);
+        double max_time,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
+        const std::string &description, utils::Verbosity verbosity);
 
     void save_plan_if_necessary() override;
 
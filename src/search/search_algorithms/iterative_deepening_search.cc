@@ -13,8 +13,11 @@ using namespace std;
 namespace iterative_deepening_search {
 IterativeDeepeningSearch::IterativeDeepeningSearch(
     bool single_plan, OperatorCost cost_type, int bound, double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
     const string &description, utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       single_plan(single_plan),
       sg(task_proxy),
       last_plan_cost(-1) {
@@ -22,6 +22,7 @@ protected:
 public:
     IterativeDeepeningSearch(
         bool single_plan, OperatorCost cost_type, int bound, double max_time,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
         const std::string &description, utils::Verbosity verbosity);
 
     void save_plan_if_necessary() override;
@@ -10,11 +10,16 @@ using namespace std;
 
 namespace iterative_width_search {
 IterativeWidthSearch::IterativeWidthSearch(
-    int width, OperatorCost cost_type, int bound, double max_time,
+    int width, SearchNodeInfoType search_node_info, OperatorCost cost_type,
+    int bound, double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
     const string &description, utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       task_info(task_proxy),
       novelty_table(width, task_info) {
+    search_space.set_node_info_type(search_node_info);
     utils::g_log << "Setting up iterative width search." << endl;
 }
 
@@ -108,6 +113,12 @@ public:
         add_option<int>(
             "width", "maximum conjunction size", "2",
             plugins::Bounds("1", "2"));
+        add_option<SearchNodeInfoType>(
+            "search_node_info",
+            "information stored for each search node. The search never "
+            "needs g values, so 'parent_only' and 'parent_free' save memory "
+            "without changing the search behavior.",
+            "full");
         add_search_algorithm_options_to_feature(*this, "iw");
     }
 
@@ -115,6 +126,7 @@ public:
         const plugins::Options &options) const override {
         return plugins::make_shared_from_arg_tuples<IterativeWidthSearch>(
             options.get<int>("width"),
+            options.get<SearchNodeInfoType>("search_node_info"),
             get_search_algorithm_arguments_from_options(options));
     }
 };
@@ -25,7 +25,9 @@ protected:
 
 public:
     IterativeWidthSearch(
-        int width, OperatorCost cost_type, int bound, double max_time,
+        int width, SearchNodeInfoType search_node_info,
+        OperatorCost cost_type, int bound, double max_time,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
         const std::string &description, utils::Verbosity verbosity);
 
     virtual void print_statistics() const override;
@@ -22,9 +22,12 @@ LazySearch::LazySearch(
     const shared_ptr<OpenListFactory> &open, bool reopen_closed,
     const vector<shared_ptr<Evaluator>> &preferred, bool randomize_successors,
     bool preferred_successors_first, int random_seed, OperatorCost cost_type,
-    int bound, double max_time, const string &description,
-    utils::Verbosity verbosity)
-    : SearchAlgorithm(cost_type, bound, max_time, description, verbosity),
+    int bound, double max_time,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          cost_type, bound, max_time, successor_generator_type, description,
+          verbosity),
       open_list(open->create_edge_open_list()),
       reopen_closed_nodes(reopen_closed),
       randomize_successors(randomize_successors),
@@ -4,3 +4,7 @@ static_assert(
     sizeof(SearchNodeInfo) == sizeof(int) + sizeof(StateID),
     "The size of SearchNodeInfo is larger than expected. This probably means "
     "that packing two fields into one integer using bitfields is not supported.");
+
+static_assert(
+    sizeof(CompactSearchNodeInfo) == sizeof(StateID),
+    "CompactSearchNodeInfo should only use the space of a state ID.");
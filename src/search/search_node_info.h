@@ -3,6 +3,9 @@
 
 #include "state_id.h"
 
+#include <cassert>
+#include <cstdint>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
@@ -22,4 +25,47 @@ struct SearchNodeInfo {
     }
 };
 
+/*
+  Search node information without g value that only needs four bytes per
+  state. The status is stored in the two highest bits of the parent state
+  ID, so state IDs from MAX_PARENT_ID + 1 upwards are reserved and can't be
+  used as parents.
+*/
+class CompactSearchNodeInfo {
+    static const int STATUS_SHIFT = 30;
+    static const uint32_t PARENT_MASK = (1U << STATUS_SHIFT) - 1;
+    static const int MAX_PARENT_ID = PARENT_MASK - 1;
+
+    // Lower 30 bits: parent state ID + 1 (0 for no parent).
+    uint32_t data;
+
+public:
+    CompactSearchNodeInfo() : data(0) {
+        static_assert(SearchNodeInfo::NEW == 0);
+    }
+
+    static bool can_store_parent(StateID parent_state_id) {
+        return parent_state_id.value <= MAX_PARENT_ID;
+    }
+
+    SearchNodeInfo::NodeStatus get_status() const {
+        return static_cast<SearchNodeInfo::NodeStatus>(data >> STATUS_SHIFT);
+    }
+
+    void set_status(SearchNodeInfo::NodeStatus status) {
+        data = (data & PARENT_MASK) |
+               (static_cast<uint32_t>(status) << STATUS_SHIFT);
+    }
+
+    StateID get_parent_state_id() const {
+        return StateID(static_cast<int>(data & PARENT_MASK) - 1);
+    }
+
+    void set_parent_state_id(StateID parent_state_id) {
+        assert(can_store_parent(parent_state_id));
+        data = (data & ~PARENT_MASK) |
+               static_cast<uint32_t>(parent_state_id.value + 1);
+    }
+};
+
 #endif
@@ -4,8 +4,11 @@
 #include "search_node_info.h"
 #include "task_proxy.h"
 
+#include "algorithms/priority_queues.h"
+#include "plugins/plugin.h"
 #include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
+#include "utils/hash.h"
 #include "utils/logging.h"
 #include "utils/system.h"
 
@@ -15,112 +18,193 @@
 using namespace std;
 
 SearchNode::SearchNode(const State &state, SearchNodeInfo &info)
-    : state(state), info(info) {
+    : state(state), info(&info), compact_info(nullptr), status(nullptr) {
     assert(state.get_id() != StateID::no_state);
 }
 
+SearchNode::SearchNode(const State &state, CompactSearchNodeInfo &info)
+    : state(state), info(nullptr), compact_info(&info), status(nullptr) {
+    assert(state.get_id() != StateID::no_state);
+}
+
+SearchNode::SearchNode(const State &state, uint8_t &status)
+    : state(state), info(nullptr), compact_info(nullptr), status(&status) {
+    assert(state.get_id() != StateID::no_state);
+}
+
+SearchNodeInfo::NodeStatus SearchNode::get_status() const {
+    if (info) {
+        return static_cast<SearchNodeInfo::NodeStatus>(info->status);
+    } else if (compact_info) {
+        return compact_info->get_status();
+    } else {
+        return static_cast<SearchNodeInfo::NodeStatus>(*status);
+    }
+}
+
+void SearchNode::set_status(SearchNodeInfo::NodeStatus new_status) {
+    if (info) {
+        info->status = new_status;
+    } else if (compact_info) {
+        compact_info->set_status(new_status);
+    } else {
+        *status = new_status;
+    }
+}
+
 const State &SearchNode::get_state() const {
     return state;
 }
 
 bool SearchNode::is_open() const {
-    return info.status == SearchNodeInfo::OPEN;
+    return get_status() == SearchNodeInfo::OPEN;
 }
 
 bool SearchNode::is_closed() const {
-    return info.status == SearchNodeInfo::CLOSED;
+    return get_status() == SearchNodeInfo::CLOSED;
 }
 
 bool SearchNode::is_dead_end() const {
-    return info.status == SearchNodeInfo::DEAD_END;
+    return get_status() == SearchNodeInfo::DEAD_END;
 }
 
 bool SearchNode::is_new() const {
-    return info.status == SearchNodeInfo::NEW;
+    return get_status() == SearchNodeInfo::NEW;
 }
 
 int SearchNode::get_g() const {
-    assert(info.g >= 0);
-    return info.g;
+    if (!info) {
+        return 0;
+    }
+    assert(info->g >= 0);
+    return info->g;
 }
 
 void SearchNode::open_initial() {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = 0;
-    info.parent_state_id = StateID::no_state;
+    assert(is_new());
+    set_status(SearchNodeInfo::OPEN);
+    if (info) {
+        info->g = 0;
+        info->parent_state_id = StateID::no_state;
+    }
 }
 
 void SearchNode::update_parent(
     const SearchNode &parent_node, const OperatorProxy &, int adjusted_cost) {
-    info.g = parent_node.info.g + adjusted_cost;
-    info.parent_state_id = parent_node.get_state().get_id();
+    StateID parent_id = parent_node.get_state().get_id();
+    if (info) {
+        info->g = parent_node.get_g() + adjusted_cost;
+        info->parent_state_id = parent_id;
+    } else if (compact_info) {
+        if (!CompactSearchNodeInfo::can_store_parent(parent_id)) {
+            cerr << "Too many states for search_node_info=parent_only."
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        compact_info->set_parent_state_id(parent_id);
+    }
 }
 
 void SearchNode::open_new_node(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
+    assert(is_new());
+    set_status(SearchNodeInfo::OPEN);
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen_closed_node(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::CLOSED);
-    info.status = SearchNodeInfo::OPEN;
+    assert(is_closed());
+    set_status(SearchNodeInfo::OPEN);
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::update_open_node_parent(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::OPEN);
+    assert(is_open());
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::update_closed_node_parent(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::CLOSED);
+    assert(is_closed());
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close() {
-    assert(info.status == SearchNodeInfo::OPEN);
-    info.status = SearchNodeInfo::CLOSED;
+    assert(is_open());
+    set_status(SearchNodeInfo::CLOSED);
 }
 
 void SearchNode::mark_as_dead_end() {
-    info.status = SearchNodeInfo::DEAD_END;
+    set_status(SearchNodeInfo::DEAD_END);
 }
 
 void SearchNode::dump(const TaskProxy &, utils::LogProxy &log) const {
     if (log.is_at_least_debug()) {
         log << state.get_id() << ": ";
         task_properties::dump_fdr(state);
-        if (info.parent_state_id != StateID::no_state)
-            log << " has parent " << info.parent_state_id << endl;
+        StateID parent_state_id = StateID::no_state;
+        if (info) {
+            parent_state_id = info->parent_state_id;
+        } else if (compact_info) {
+            parent_state_id = compact_info->get_parent_state_id();
+        }
+        if (parent_state_id != StateID::no_state)
+            log << " has parent " << parent_state_id << endl;
         else
             log << " no parent" << endl;
     }
 }
 
 SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
-    : state_registry(state_registry), log(log) {
+    : node_info_type(SearchNodeInfoType::FULL),
+      state_registry(state_registry),
+      log(log) {
+}
+
+void SearchSpace::set_node_info_type(SearchNodeInfoType type) {
+    node_info_type = type;
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
-    return SearchNode(state, search_node_infos[state]);
+    switch (node_info_type) {
+    case SearchNodeInfoType::FULL:
+        return SearchNode(state, search_node_infos[state]);
+    case SearchNodeInfoType::PARENT_ONLY:
+        return SearchNode(state, compact_search_node_infos[state]);
+    case SearchNodeInfoType::PARENT_FREE:
+        return SearchNode(state, search_node_statuses[state]);
+    }
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+StateID SearchSpace::get_parent_state_id(const State &state) const {
+    switch (node_info_type) {
+    case SearchNodeInfoType::FULL:
+        return search_node_infos[state].parent_state_id;
+    case SearchNodeInfoType::PARENT_ONLY:
+        return compact_search_node_infos[state].get_parent_state_id();
+    case SearchNodeInfoType::PARENT_FREE:
+        break;
+    }
+    return StateID::no_state;
 }
 
 vector<OperatorID> SearchSpace::trace_path(
     const TaskProxy &task_proxy,
     const successor_generator::SuccessorGenerator &successor_generator,
-    const State &goal_state) const {
+    const State &goal_state, OperatorCost cost_type) const {
     vector<OperatorID> path;
-    vector<State> states = trace_states(goal_state);
+    vector<State> states =
+        (node_info_type == SearchNodeInfoType::PARENT_FREE)
+            ? trace_states_through_closed_states(
+                  task_proxy, successor_generator, goal_state, cost_type)
+            : trace_states(goal_state);
     OperatorsProxy operators = task_proxy.get_operators();
     // Use the registry of one of the registered states.
     StateRegistry *registry =
@@ -160,28 +244,93 @@ vector<State> SearchSpace::trace_states(const State &goal_state) const {
     assert(current_state.get_registry() == &state_registry);
     // Collect states from goal to initial by following parent_state_id.
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
+        StateID parent_state_id = get_parent_state_id(current_state);
         states.push_back(current_state);
-        if (info.parent_state_id == StateID::no_state) {
+        if (parent_state_id == StateID::no_state) {
             break;
         }
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        current_state = state_registry.lookup_state(parent_state_id);
     }
     // We collected in reverse; put in start->...->goal order.
     reverse(states.begin(), states.end());
     return states;
 }
 
+vector<State> SearchSpace::trace_states_through_closed_states(
+    const TaskProxy &task_proxy,
+    const successor_generator::SuccessorGenerator &successor_generator,
+    const State &goal_state, OperatorCost cost_type) const {
+    /*
+      Each closed state was reached from another closed state, so there is
+      a path from the initial state to the (closed) goal state that only
+      passes through closed states. We find a cheapest such path with
+      uniform-cost search. Only the reached states need temporary memory.
+    */
+    assert(goal_state.get_registry() == &state_registry);
+    const StateID goal_id = goal_state.get_id();
+    OperatorsProxy operators = task_proxy.get_operators();
+    bool is_unit_cost = task_properties::is_unit_cost(task_proxy);
+    // Map reached states to their distance and predecessor.
+    utils::HashMap<int, pair<int, int>> reached;
+    priority_queues::AdaptiveQueue<int> queue;
+    State initial_state = state_registry.get_initial_state();
+    reached.emplace(initial_state.get_id().value, make_pair(0, -1));
+    queue.push(0, initial_state.get_id().value);
+    vector<OperatorID> applicable_op_ids;
+    while (!queue.empty()) {
+        auto [distance, state_id] = queue.pop();
+        if (distance > reached.at(state_id).first) {
+            continue;
+        }
+        if (state_id == goal_id.value) {
+            break;
+        }
+        State state = state_registry.lookup_state(StateID(state_id));
+        applicable_op_ids.clear();
+        successor_generator.generate_applicable_ops(state, applicable_op_ids);
+        for (OperatorID op_id : applicable_op_ids) {
+            OperatorProxy op = operators[op_id];
+            State succ = state_registry.get_successor_state(state, op);
+            int succ_id = succ.get_id().value;
+            if (succ.get_id() != goal_id &&
+                search_node_statuses[succ] != SearchNodeInfo::CLOSED) {
+                continue;
+            }
+            int succ_distance =
+                distance +
+                get_adjusted_action_cost(op, cost_type, is_unit_cost);
+            auto it = reached.find(succ_id);
+            if (it == reached.end() || succ_distance < it->second.first) {
+                reached[succ_id] = make_pair(succ_distance, state_id);
+                queue.push(succ_distance, succ_id);
+            }
+        }
+    }
+    if (!reached.count(goal_id.value)) {
+        cerr << "Internal error: goal state is not reachable via closed "
+             << "states." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+
+    vector<State> states;
+    for (int state_id = goal_id.value; state_id != -1;
+         state_id = reached.at(state_id).second) {
+        states.push_back(state_registry.lookup_state(StateID(state_id)));
+    }
+    reverse(states.begin(), states.end());
+    return states;
+}
+
 void SearchSpace::dump(const TaskProxy &) const {
     for (StateID id : state_registry) {
         /* The body duplicates parts of SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         State state = state_registry.lookup_state(id);
-        const SearchNodeInfo &node_info = search_node_infos[state];
+        StateID parent_state_id = get_parent_state_id(state);
         log << id << ": ";
         task_properties::dump_fdr(state);
-        if (node_info.parent_state_id != StateID::no_state)
-            log << " has parent " << node_info.parent_state_id << endl;
+        if (parent_state_id != StateID::no_state)
+            log << " has parent " << parent_state_id << endl;
         else
             log << "has no parent" << endl;
     }
@@ -190,3 +339,13 @@ void SearchSpace::dump(const TaskProxy &) const {
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics(log);
 }
+
+static plugins::TypedEnumPlugin<SearchNodeInfoType> _enum_plugin({
+    {"full", "store status, g value and parent state (8 bytes per state)"},
+    {"parent_only",
+     "store status and parent state (4 bytes per state). Supports at most "
+     "2^30 - 1 states."},
+    {"parent_free",
+     "store only the status (1 byte per state) and reconstruct plans by "
+     "searching the closed states"},
+});
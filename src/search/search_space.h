@@ -5,6 +5,7 @@
 #include "per_state_information.h"
 #include "search_node_info.h"
 
+#include <cstdint>
 #include <vector>
 
 class OperatorID;
@@ -19,15 +20,41 @@ namespace utils {
 class LogProxy;
 }
 
+/*
+  Information stored for each search node:
+
+  FULL: status, g value and parent state (8 bytes)
+  PARENT_ONLY: status and parent state (4 bytes, see CompactSearchNodeInfo)
+  PARENT_FREE: status (1 byte). Plans are reconstructed by searching the
+    closed states, which takes time proportional to the number of closed
+    states that are cheaper to reach than the goal.
+
+  Without g values, search nodes report g = 0, parents are never updated
+  and closed nodes are never reopened. Only use these modes for algorithms
+  that don't need g values, e.g., greedy best-first search.
+*/
+enum class SearchNodeInfoType {
+    FULL,
+    PARENT_ONLY,
+    PARENT_FREE
+};
+
 class SearchNode {
     State state;
-    SearchNodeInfo &info;
+    // Exactly one of the following pointers is set.
+    SearchNodeInfo *info;
+    CompactSearchNodeInfo *compact_info;
+    uint8_t *status;
 
+    SearchNodeInfo::NodeStatus get_status() const;
+    void set_status(SearchNodeInfo::NodeStatus new_status);
     void update_parent(
         const SearchNode &parent_node, const OperatorProxy &parent_op,
         int adjusted_cost);
 public:
     SearchNode(const State &state, SearchNodeInfo &info);
+    SearchNode(const State &state, CompactSearchNodeInfo &info);
+    SearchNode(const State &state, uint8_t &status);
 
     const State &get_state() const;
 
@@ -58,28 +85,48 @@ public:
 };
 
 class SearchSpace {
+    SearchNodeInfoType node_info_type;
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    PerStateInformation<CompactSearchNodeInfo> compact_search_node_infos;
+    PerStateInformation<uint8_t> search_node_statuses;
 
     StateRegistry &state_registry;
     utils::LogProxy &log;
 
+    StateID get_parent_state_id(const State &state) const;
+
     // Return the sequence of states from the initial state to the given goal
     // state by following parent_state_id pointers. The returned vector
     // includes both the initial state (at index 0) and the goal state (at the
     // last index).
     std::vector<State> trace_states(const State &goal_state) const;
+
+    // Same as trace_states(), but for search spaces without parent pointers.
+    // Returns a cheapest path under the given cost type that only passes
+    // through closed states.
+    std::vector<State> trace_states_through_closed_states(
+        const TaskProxy &task_proxy,
+        const successor_generator::SuccessorGenerator &successor_generator,
+        const State &goal_state, OperatorCost cost_type) const;
 public:
     SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
 
+    // Must be called before the first node is created.
+    void set_node_info_type(SearchNodeInfoType type);
+    SearchNodeInfoType get_node_info_type() const {
+        return node_info_type;
+    }
+
     SearchNode get_node(const State &state);
 
     // Recompute operator path by following parent pointers (via trace_states)
     // and picking, in each state, an applicable operator that reaches the next
-    // state.
+    // state. Without parent pointers, we trace a cheapest path under the
+    // given cost type through the closed states.
     std::vector<OperatorID> trace_path(
         const TaskProxy &task_proxy,
         const successor_generator::SuccessorGenerator &successor_generator,
-        const State &goal_state) const;
+        const State &goal_state, OperatorCost cost_type) const;
 
     void dump(const TaskProxy &task_proxy) const;
     void print_statistics() const;
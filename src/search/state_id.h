@@ -16,7 +16,9 @@ class ExhaustiveSearch;
 
 class StateID {
     friend class breadth_first_search::BreadthFirstSearch;
+    friend class CompactSearchNodeInfo;
     friend class exhaustive_search::ExhaustiveSearch;
+    friend class SearchSpace;
     friend class StateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
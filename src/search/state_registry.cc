@@ -3,9 +3,12 @@
 #include "per_state_information.h"
 #include "task_proxy.h"
 
+#include "task_utils/compiled_task.h"
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
 
+#include <algorithm>
+
 using namespace std;
 
 StateRegistry::StateRegistry(const TaskProxy &task_proxy)
@@ -15,8 +18,193 @@ StateRegistry::StateRegistry(const TaskProxy &task_proxy)
       num_variables(task_proxy.get_variables().size()),
       state_data_pool(get_bins_per_state()),
       registered_states(
-          0, StateIDSemanticHash(state_data_pool, get_bins_per_state()),
-          StateIDSemanticEqual(state_data_pool, get_bins_per_state())) {
+          0, StateIDSemanticHash(*this, get_bins_per_state()),
+          StateIDSemanticEqual(*this, get_bins_per_state())),
+      max_delta_chain_length(0),
+      task_snapshot(nullptr) {
+    if (!task_properties::has_axioms(task_proxy) &&
+        !task_properties::has_conditional_effects(task_proxy)) {
+        compile_packed_effects();
+    }
+}
+
+void StateRegistry::compile_packed_effects() {
+    OperatorsProxy operators = task_proxy.get_operators();
+    packed_effects_begin.reserve(operators.size() + 1);
+    for (OperatorProxy op : operators) {
+        int op_begin = packed_effects.size();
+        packed_effects_begin.push_back(op_begin);
+        for (EffectProxy effect : op.get_effects()) {
+            assert(effect.get_conditions().empty());
+            FactPair fact = effect.get_fact().get_pair();
+            int bin = state_packer.get_bin_index(fact.var);
+            PackedStateBin read_mask = state_packer.get_read_mask(fact.var);
+            PackedStateBin value_mask =
+                static_cast<PackedStateBin>(fact.value)
+                << state_packer.get_shift(fact.var);
+            auto it = find_if(
+                packed_effects.begin() + op_begin, packed_effects.end(),
+                [bin](const PackedEffect &e) { return e.bin == bin; });
+            if (it == packed_effects.end()) {
+                packed_effects.push_back({bin, ~read_mask, value_mask});
+            } else {
+                it->clear_mask &= ~read_mask;
+                it->set_mask |= value_mask;
+            }
+        }
+    }
+    packed_effects_begin.push_back(packed_effects.size());
+    packed_effects.shrink_to_fit();
+}
+
+void StateRegistry::enable_delta_compression(int max_chain_length) {
+    assert(size() == 0);
+    assert(max_chain_length >= 0 &&
+           max_chain_length <= numeric_limits<uint8_t>::max());
+    max_delta_chain_length = max_chain_length;
+    if (max_delta_chain_length > 0) {
+        task_snapshot = &compiled_task::g_compiled_tasks[task_proxy];
+        state_cache.resize(state_cache_size);
+        for (vector<PackedStateBin> &scratch : packed_scratch) {
+            scratch.resize(get_bins_per_state());
+        }
+    }
+}
+
+const PackedStateBin *StateRegistry::pack_values(
+    const vector<int> &values, int scratch) const {
+    PackedStateBin *buffer = packed_scratch[scratch].data();
+    fill_n(buffer, get_bins_per_state(), 0);
+    for (size_t var = 0; var < values.size(); ++var) {
+        state_packer.set(buffer, var, values[var]);
+    }
+    return buffer;
+}
+
+const PackedStateBin *StateRegistry::reconstruct_packed_data(
+    int id, int scratch) const {
+    return pack_values(reconstruct_values(id), scratch);
+}
+
+uint32_t StateRegistry::compute_fingerprint(const vector<int> &values) const {
+    const PackedStateBin *data = pack_values(values, 0);
+    utils::HashState hash_state;
+    for (int i = 0; i < get_bins_per_state(); ++i) {
+        hash_state.feed(data[i]);
+    }
+    return hash_state.get_hash32();
+}
+
+/*
+  Walk up the delta entries until we reach a state that is cached or stored
+  in packed form, then apply the operators on the way back down. The
+  returned reference is only valid until the next call.
+*/
+const vector<int> &StateRegistry::reconstruct_values(int id) const {
+    assert(max_delta_chain_length > 0);
+    CachedState &cached = state_cache[id % state_cache_size];
+    if (cached.id == id) {
+        return cached.values;
+    }
+    vector<int> op_ids;
+    vector<int> values;
+    int current_id = id;
+    while (true) {
+        const CachedState &cached_ancestor =
+            state_cache[current_id % state_cache_size];
+        if (cached_ancestor.id == current_id) {
+            values = cached_ancestor.values;
+            break;
+        }
+        const DeltaEntry &entry = delta_entries[current_id];
+        if (entry.op_id == no_operator) {
+            const PackedStateBin *buffer = state_data_pool[entry.parent];
+            values.resize(num_variables);
+            for (int var = 0; var < num_variables; ++var) {
+                values[var] = state_packer.get(buffer, var);
+            }
+            break;
+        }
+        op_ids.push_back(entry.op_id);
+        current_id = entry.parent;
+    }
+    for (auto it = op_ids.rbegin(); it != op_ids.rend(); ++it) {
+        apply_operator(*it, values);
+    }
+    cached.id = id;
+    cached.values = move(values);
+    return cached.values;
+}
+
+void StateRegistry::apply_operator(int op_id, vector<int> &values) const {
+    vector<int> changed_vars;
+    span<const FactPair> effects = task_snapshot->get_effects(op_id);
+    if (task_snapshot->has_conditional_effects()) {
+        vector<int> old_values = values;
+        for (size_t i = 0; i < effects.size(); ++i) {
+            bool fires = true;
+            for (const FactPair &fact :
+                 task_snapshot->get_effect_conditions(op_id, i)) {
+                if (old_values[fact.var] != fact.value) {
+                    fires = false;
+                    break;
+                }
+            }
+            if (fires) {
+                values[effects[i].var] = effects[i].value;
+                changed_vars.push_back(effects[i].var);
+            }
+        }
+    } else {
+        for (const FactPair &fact : effects) {
+            values[fact.var] = fact.value;
+            changed_vars.push_back(fact.var);
+        }
+    }
+    if (task_properties::has_axioms(task_proxy)) {
+        axiom_evaluator.evaluate(values, changed_vars);
+    }
+}
+
+void StateRegistry::push_packed_state(const vector<int> &values) {
+    int num_bins = get_bins_per_state();
+    vector<PackedStateBin> buffer(num_bins, 0);
+    for (size_t var = 0; var < values.size(); ++var) {
+        state_packer.set(buffer.data(), var, values[var]);
+    }
+    delta_entries.push_back(
+        {static_cast<int>(state_data_pool.size()), no_operator});
+    delta_chain_lengths.push_back(0);
+    state_data_pool.push_back(buffer.data());
+}
+
+/*
+  Like insert_id_or_pop_state, but for the last delta entry. We put the
+  values of the new state into the cache to avoid reconstructing it when
+  comparing it to registered states with the same fingerprint.
+*/
+StateID StateRegistry::insert_delta_entry_or_pop_state(
+    const vector<int> &values) {
+    int id = delta_entries.size() - 1;
+    CachedState &cached = state_cache[id % state_cache_size];
+    cached.id = id;
+    cached.values = values;
+    state_fingerprints.push_back(compute_fingerprint(values));
+    auto result = registered_states.insert(id);
+    bool is_new_entry = result.second;
+    if (!is_new_entry) {
+        if (delta_entries[id].op_id == no_operator) {
+            state_data_pool.pop_back();
+        }
+        delta_entries.pop_back();
+        delta_chain_lengths.pop_back();
+        state_fingerprints.pop_back();
+        if (cached.id == id) {
+            cached.id = -1;
+        }
+    }
+    assert(registered_states.size() == delta_entries.size());
+    return StateID(*result.first);
 }
 
 StateID StateRegistry::insert_id_or_pop_state() {
@@ -37,18 +225,31 @@ StateID StateRegistry::insert_id_or_pop_state() {
 }
 
 State StateRegistry::lookup_state(StateID id) const {
+    if (max_delta_chain_length > 0) {
+        vector<int> values = reconstruct_values(id.value);
+        return task_proxy.create_state(*this, id, move(values));
+    }
     const PackedStateBin *buffer = state_data_pool[id.value];
     return task_proxy.create_state(*this, id, buffer);
 }
 
 State StateRegistry::lookup_state(
     StateID id, vector<int> &&state_values) const {
+    if (max_delta_chain_length > 0) {
+        return task_proxy.create_state(*this, id, move(state_values));
+    }
     const PackedStateBin *buffer = state_data_pool[id.value];
     return task_proxy.create_state(*this, id, buffer, move(state_values));
 }
 
 const State &StateRegistry::get_initial_state() {
-    if (!cached_initial_state) {
+    if (!cached_initial_state && max_delta_chain_length > 0) {
+        State initial_state = task_proxy.get_initial_state();
+        vector<int> values = initial_state.get_unpacked_values();
+        push_packed_state(values);
+        StateID id = insert_delta_entry_or_pop_state(values);
+        cached_initial_state = make_unique<State>(lookup_state(id));
+    } else if (!cached_initial_state) {
         int num_bins = get_bins_per_state();
         unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
         // Avoid garbage values in half-full bins.
@@ -72,6 +273,31 @@ const State &StateRegistry::get_initial_state() {
 State StateRegistry::get_successor_state(
     const State &predecessor, const OperatorProxy &op) {
     assert(!op.is_axiom());
+    if (max_delta_chain_length > 0) {
+        predecessor.unpack();
+        vector<int> new_values = predecessor.get_unpacked_values();
+        vector<int> changed_vars;
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                new_values[effect_pair.var] = effect_pair.value;
+                changed_vars.push_back(effect_pair.var);
+            }
+        }
+        if (task_properties::has_axioms(task_proxy)) {
+            axiom_evaluator.evaluate(new_values, changed_vars);
+        }
+        int parent_id = predecessor.get_id().value;
+        int chain_length = delta_chain_lengths[parent_id] + 1;
+        if (chain_length > max_delta_chain_length) {
+            push_packed_state(new_values);
+        } else {
+            delta_entries.push_back({parent_id, op.get_id()});
+            delta_chain_lengths.push_back(chain_length);
+        }
+        StateID id = insert_delta_entry_or_pop_state(new_values);
+        return lookup_state(id, move(new_values));
+    }
     /*
       TODO: ideally, we would not modify state_data_pool here and in
       insert_id_or_pop_state, but only at one place, to avoid errors like
@@ -85,13 +311,15 @@ State StateRegistry::get_successor_state(
     if (task_properties::has_axioms(task_proxy)) {
         predecessor.unpack();
         vector<int> new_values = predecessor.get_unpacked_values();
+        vector<int> changed_vars;
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
                 FactPair effect_pair = effect.get_fact().get_pair();
                 new_values[effect_pair.var] = effect_pair.value;
+                changed_vars.push_back(effect_pair.var);
             }
         }
-        axiom_evaluator.evaluate(new_values);
+        axiom_evaluator.evaluate(new_values, changed_vars);
         for (size_t i = 0; i < new_values.size(); ++i) {
             state_packer.set(buffer, i, new_values[i]);
         }
@@ -101,6 +329,17 @@ State StateRegistry::get_successor_state(
         */
         StateID id = insert_id_or_pop_state();
         return lookup_state(id, move(new_values));
+    } else if (!packed_effects_begin.empty()) {
+        int op_id = op.get_id();
+        int end = packed_effects_begin[op_id + 1];
+        for (int i = packed_effects_begin[op_id]; i < end; ++i) {
+            const PackedEffect &effect = packed_effects[i];
+            buffer[effect.bin] =
+                (buffer[effect.bin] & effect.clear_mask) | effect.set_mask;
+        }
+        // See above for why we use lookup_state.
+        StateID id = insert_id_or_pop_state();
+        return lookup_state(id);
     } else {
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
@@ -127,6 +366,10 @@ int StateRegistry::get_state_size_in_bytes() const {
 
 void StateRegistry::print_statistics(utils::LogProxy &log) const {
     log << "Number of registered states: " << size() << endl;
+    if (max_delta_chain_length > 0) {
+        log << "Number of states stored in packed form: "
+            << state_data_pool.size() << endl;
+    }
     log << "Closed list load factor: " << registered_states.size() << "/"
         << registered_states.capacity() << " = "
         << registered_states.load_factor() << endl;
@@ -59,6 +59,11 @@
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
 
+    With delta compression (see enable_delta_compression), the registry only
+    stores the packed data of some states. All other states are stored as
+    their parent state and the operator leading to them. States of such
+    registries only contain unpacked data, which is reconstructed on demand.
+
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
     Can be thought of as a very compactly implemented map from State to T.
@@ -105,6 +110,10 @@
     The heuristic object uses an attribute of type PerStateBitset to store for
   each state and each landmark whether it was reached in this state.
 */
+namespace compiled_task {
+class CompiledTask;
+}
+
 namespace int_packer {
 class IntPacker;
 }
@@ -117,18 +126,18 @@ using PackedStateBin = int_packer::IntPacker::Bin;
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>
-            &state_data_pool;
+        const StateRegistry &registry;
         int state_size;
-        StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>
-                &state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool), state_size(state_size) {
+        StateIDSemanticHash(const StateRegistry &registry, int state_size)
+            : registry(registry), state_size(state_size) {
         }
 
         uint64_t operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
+            if (registry.max_delta_chain_length > 0) {
+                // Spread the 32-bit fingerprint over all bits of the hash.
+                return registry.state_fingerprints[id] * 0x9e3779b97f4a7c15ULL;
+            }
+            const PackedStateBin *data = registry.get_packed_data(id, 0);
             utils::HashState hash_state;
             for (int i = 0; i < state_size; ++i) {
                 hash_state.feed(data[i]);
@@ -138,19 +147,20 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>
-            &state_data_pool;
+        const StateRegistry &registry;
         int state_size;
-        StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>
-                &state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool), state_size(state_size) {
+        StateIDSemanticEqual(const StateRegistry &registry, int state_size)
+            : registry(registry), state_size(state_size) {
         }
 
         bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
+            if (registry.max_delta_chain_length > 0 &&
+                registry.state_fingerprints[lhs] !=
+                    registry.state_fingerprints[rhs]) {
+                return false;
+            }
+            const PackedStateBin *lhs_data = registry.get_packed_data(lhs, 0);
+            const PackedStateBin *rhs_data = registry.get_packed_data(rhs, 1);
             return std::equal(lhs_data, lhs_data + state_size, rhs_data);
         }
     };
@@ -173,11 +183,83 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
 
     std::unique_ptr<State> cached_initial_state;
 
+    /*
+      For tasks without axioms and conditional effects, we precompute how
+      each operator changes the bins of a packed state. The effects of
+      operator o are stored at positions [packed_effects_begin[o],
+      packed_effects_begin[o + 1]) in packed_effects, with at most one
+      entry per bin. For other tasks, both vectors are empty.
+    */
+    struct PackedEffect {
+        int bin;
+        PackedStateBin clear_mask;
+        PackedStateBin set_mask;
+    };
+    std::vector<PackedEffect> packed_effects;
+    std::vector<int> packed_effects_begin;
+
+    /*
+      Data for delta compression. For each state, we store its parent and the
+      operator leading to it. If the operator is no_operator, the state is
+      stored in state_data_pool and "parent" is its index there. We store the
+      packed data of a state if its chain of delta-compressed ancestors would
+      otherwise become longer than max_delta_chain_length.
+
+      Since reconstructing states is expensive, we also store a 32-bit
+      fingerprint of each state. Hashing only uses the fingerprints, so
+      rehashing the hash set reconstructs no states, and two states are
+      only reconstructed for comparison if their fingerprints match.
+    */
+    struct DeltaEntry {
+        int parent;
+        int op_id;
+    };
+    static const int no_operator = -1;
+    int max_delta_chain_length;
+    // Used for applying operators when reconstructing states.
+    const compiled_task::CompiledTask *task_snapshot;
+    segmented_vector::SegmentedVector<DeltaEntry> delta_entries;
+    segmented_vector::SegmentedVector<uint8_t> delta_chain_lengths;
+    segmented_vector::SegmentedVector<uint32_t> state_fingerprints;
+
+    // Direct-mapped cache of reconstructed states.
+    struct CachedState {
+        int id = -1;
+        std::vector<int> values;
+    };
+    static const int state_cache_size = 1024;
+    mutable std::vector<CachedState> state_cache;
+    mutable std::vector<PackedStateBin> packed_scratch[2];
+
+    const PackedStateBin *get_packed_data(int id, int scratch) const {
+        if (max_delta_chain_length == 0) {
+            return state_data_pool[id];
+        }
+        return reconstruct_packed_data(id, scratch);
+    }
+    const PackedStateBin *pack_values(
+        const std::vector<int> &values, int scratch) const;
+    const PackedStateBin *reconstruct_packed_data(int id, int scratch) const;
+    uint32_t compute_fingerprint(const std::vector<int> &values) const;
+    const std::vector<int> &reconstruct_values(int id) const;
+    void apply_operator(int op_id, std::vector<int> &values) const;
+    void push_packed_state(const std::vector<int> &values);
+    StateID insert_delta_entry_or_pop_state(const std::vector<int> &values);
+
+    void compile_packed_effects();
+
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
 public:
     explicit StateRegistry(const TaskProxy &task_proxy);
 
+    /*
+      Store states as deltas to their parents. Lookups then have to apply up
+      to max_chain_length operators, so larger values save more memory but
+      take more time. Must be called before registering the first state.
+    */
+    void enable_delta_compression(int max_chain_length);
+
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
     }
@@ -33,6 +33,21 @@ State::State(
     this->values = make_shared<vector<int>>(move(values));
 }
 
+State::State(
+    const AbstractTask &task, const StateRegistry &registry, StateID id,
+    vector<int> &&values)
+    : task(&task),
+      registry(&registry),
+      id(id),
+      buffer(nullptr),
+      values(make_shared<vector<int>>(move(values))),
+      state_packer(&registry.get_state_packer()),
+      num_variables(registry.get_num_variables()) {
+    assert(id != StateID::no_state);
+    assert(num_variables == static_cast<int>(this->values->size()));
+    assert(num_variables == task.get_num_variables());
+}
+
 State::State(const AbstractTask &task, vector<int> &&values)
     : task(&task),
       registry(nullptr),
@@ -49,17 +64,19 @@ State State::get_unregistered_successor(const OperatorProxy &op) const {
     assert(task_properties::is_applicable(op, *this));
     assert(values);
     vector<int> new_values = get_unpacked_values();
+    vector<int> changed_vars;
 
     for (EffectProxy effect : op.get_effects()) {
         if (does_fire(effect, *this)) {
             FactPair effect_fact = effect.get_fact().get_pair();
             new_values[effect_fact.var] = effect_fact.value;
+            changed_vars.push_back(effect_fact.var);
         }
     }
 
     if (task->get_num_axioms() > 0) {
         AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[TaskProxy(*task)];
-        axiom_evaluator.evaluate(new_values);
+        axiom_evaluator.evaluate(new_values, changed_vars);
     }
     return State(*task, move(new_values));
 }
@@ -594,6 +594,10 @@ public:
     State(
         const AbstractTask &task, const StateRegistry &registry, StateID id,
         const PackedStateBin *buffer, std::vector<int> &&values);
+    // Construct a registered state with only unpacked data.
+    State(
+        const AbstractTask &task, const StateRegistry &registry, StateID id,
+        std::vector<int> &&values);
     // Construct a state with only unpacked data.
     State(const AbstractTask &task, std::vector<int> &&values);
 
@@ -623,9 +627,15 @@ public:
     const std::vector<int> &get_unpacked_values() const;
 
     /* Access the packed values. Accessing packed values on states that do
-       not have them (unregistered states) is an error. */
+       not have them (unregistered states and states from registries with
+       delta compression) is an error. */
     const PackedStateBin *get_buffer() const;
 
+    // Return true iff the state has unpacked data.
+    bool has_unpacked_values() const;
+    // Return true iff the state has packed data.
+    bool has_buffer() const;
+
     /*
       Create a successor state with the given operator. The operator is assumed
       to be applicable and the precondition is not checked. This will create an
@@ -702,6 +712,16 @@ public:
         return State(*task, registry, id, buffer, std::move(state_values));
     }
 
+    /*
+      This method is meant to be called only by state registries that do not
+      store the packed data of all states.
+    */
+    State create_state(
+        const StateRegistry &registry, StateID id,
+        std::vector<int> &&state_values) const {
+        return State(*task, registry, id, std::move(state_values));
+    }
+
     State get_initial_state() const {
         return create_state(task->get_initial_state_values());
     }
@@ -841,13 +861,21 @@ inline const PackedStateBin *State::get_buffer() const {
       not costly, but the 'cerr <<' stuff might prevent inlining.
     */
     if (!buffer) {
-        std::cerr << "Accessing the packed values of an unregistered state is "
-                  << "treated as an error." << std::endl;
+        std::cerr << "Accessing the packed values of a state without packed "
+                  << "data is treated as an error." << std::endl;
         utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
     }
     return buffer;
 }
 
+inline bool State::has_unpacked_values() const {
+    return values != nullptr;
+}
+
+inline bool State::has_buffer() const {
+    return buffer != nullptr;
+}
+
 inline const std::vector<int> &State::get_unpacked_values() const {
     if (!values) {
         std::cerr << "Accessing the unpacked values of a state without "
@@ -0,0 +1,50 @@
+#include "compiled_task.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace compiled_task {
+CompiledTask::CompiledTask(const TaskProxy &task_proxy) {
+    VariablesProxy variables = task_proxy.get_variables();
+    domain_sizes.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        domain_sizes.push_back(var.get_domain_size());
+    }
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    int num_operators = operators.size();
+    operator_costs.reserve(num_operators);
+    precondition_offsets.reserve(num_operators + 1);
+    effect_offsets.reserve(num_operators + 1);
+    for (OperatorProxy op : operators) {
+        operator_costs.push_back(op.get_cost());
+
+        precondition_offsets.push_back(preconditions.size());
+        for (FactProxy fact : op.get_preconditions()) {
+            preconditions.push_back(fact.get_pair());
+        }
+        sort(
+            preconditions.begin() + precondition_offsets.back(),
+            preconditions.end());
+
+        effect_offsets.push_back(effects.size());
+        for (EffectProxy effect : op.get_effects()) {
+            effects.push_back(effect.get_fact().get_pair());
+            effect_condition_offsets.push_back(effect_conditions.size());
+            for (FactProxy condition : effect.get_conditions()) {
+                effect_conditions.push_back(condition.get_pair());
+            }
+        }
+    }
+    precondition_offsets.push_back(preconditions.size());
+    effect_offsets.push_back(effects.size());
+    effect_condition_offsets.push_back(effect_conditions.size());
+
+    for (FactProxy goal : task_proxy.get_goals()) {
+        goals.push_back(goal.get_pair());
+    }
+}
+
+PerTaskInformation<CompiledTask> g_compiled_tasks;
+}
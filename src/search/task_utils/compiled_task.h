@@ -0,0 +1,85 @@
+#ifndef TASK_UTILS_COMPILED_TASK_H
+#define TASK_UTILS_COMPILED_TASK_H
+
+#include "../per_task_information.h"
+#include "../task_proxy.h"
+
+#include <span>
+#include <vector>
+
+namespace compiled_task {
+/*
+  Immutable snapshot of the operators and goals of a task, stored in
+  contiguous arrays with offsets. Going through TaskProxy costs a virtual
+  call (and possibly a chain of delegating calls for task transformations)
+  for every fact. Code that iterates over all operators many times, e.g.,
+  when building abstractions, can use this class instead.
+
+  Preconditions are sorted by variable. Effects are stored in the order
+  of the task.
+*/
+class CompiledTask {
+    std::vector<int> domain_sizes;
+    std::vector<int> operator_costs;
+    std::vector<int> precondition_offsets;
+    std::vector<FactPair> preconditions;
+    std::vector<int> effect_offsets;
+    std::vector<FactPair> effects;
+    // Indexed by global effect IDs, i.e., positions in effects.
+    std::vector<int> effect_condition_offsets;
+    std::vector<FactPair> effect_conditions;
+    std::vector<FactPair> goals;
+
+public:
+    explicit CompiledTask(const TaskProxy &task_proxy);
+
+    int get_num_variables() const {
+        return domain_sizes.size();
+    }
+
+    int get_domain_size(int var) const {
+        return domain_sizes[var];
+    }
+
+    int get_num_operators() const {
+        return operator_costs.size();
+    }
+
+    int get_operator_cost(int op_id) const {
+        return operator_costs[op_id];
+    }
+
+    std::span<const FactPair> get_preconditions(int op_id) const {
+        return std::span<const FactPair>(
+            preconditions.data() + precondition_offsets[op_id],
+            preconditions.data() + precondition_offsets[op_id + 1]);
+    }
+
+    std::span<const FactPair> get_effects(int op_id) const {
+        return std::span<const FactPair>(
+            effects.data() + effect_offsets[op_id],
+            effects.data() + effect_offsets[op_id + 1]);
+    }
+
+    std::span<const FactPair> get_effect_conditions(
+        int op_id, int effect_index) const {
+        int effect_id = effect_offsets[op_id] + effect_index;
+        return std::span<const FactPair>(
+            effect_conditions.data() + effect_condition_offsets[effect_id],
+            effect_conditions.data() +
+                effect_condition_offsets[effect_id + 1]);
+    }
+
+    bool has_conditional_effects() const {
+        return !effect_conditions.empty();
+    }
+
+    const std::vector<FactPair> &get_goals() const {
+        return goals;
+    }
+};
+
+extern PerTaskInformation<CompiledTask> g_compiled_tasks;
+}
+
+#endif
@@ -5,26 +5,59 @@
 
 #include "../abstract_task.h"
 
+#include "../plugins/plugin.h"
+
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create()) {
+SuccessorGenerator::SuccessorGenerator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type)
+    : task_proxy(task_proxy) {
+    if (type == SuccessorGeneratorType::COMPILED) {
+        compiled_generator = SuccessorGeneratorFactory(task_proxy).compile();
+    } else {
+        root = SuccessorGeneratorFactory(task_proxy).create();
+    }
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
 
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
-    state.unpack();
-    root->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+    if (!compiled_generator) {
+        state.unpack();
+        root->generate_applicable_ops(
+            state.get_unpacked_values(), applicable_ops);
+    } else if (state.has_unpacked_values()) {
+        compiled_generator->generate_applicable_ops(
+            state.get_unpacked_values(), applicable_ops);
+    } else {
+        compiled_generator->generate_applicable_ops(
+            state.get_buffer(), applicable_ops);
+    }
 }
 
 void SuccessorGenerator::generate_applicable_ops(
     const cartesian_abstractions::AbstractState &state,
     vector<OperatorID> &applicable_ops) const {
+    if (!root) {
+        root = SuccessorGeneratorFactory(task_proxy).create();
+    }
     root->generate_applicable_ops(state, applicable_ops);
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+
+PerTaskInformation<SuccessorGenerator> g_compiled_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return make_unique<SuccessorGenerator>(
+            task_proxy, SuccessorGeneratorType::COMPILED);
+    });
+
+static plugins::TypedEnumPlugin<SuccessorGeneratorType> _enum_plugin({
+    {"tree", "decision tree of polymorphic nodes"},
+    {"compiled",
+     "decision tree compiled into a flat array. It reads variable values "
+     "directly from packed states instead of unpacking them."},
+});
 }
@@ -15,13 +15,29 @@ class AbstractState;
 }
 
 namespace successor_generator {
+class CompiledGenerator;
 class GeneratorBase;
 
+enum class SuccessorGeneratorType {
+    TREE,
+    COMPILED
+};
+
+/*
+  By default, all states are handled by a tree of polymorphic nodes. With
+  SuccessorGeneratorType::COMPILED, concrete states are handled by a
+  compiled generator that can read values directly from packed states, and
+  we only construct the tree when it is needed for abstract states.
+*/
 class SuccessorGenerator {
-    std::unique_ptr<GeneratorBase> root;
+    TaskProxy task_proxy;
+    std::unique_ptr<CompiledGenerator> compiled_generator;
+    mutable std::unique_ptr<GeneratorBase> root;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy,
+        SuccessorGeneratorType type = SuccessorGeneratorType::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -29,6 +45,11 @@ public:
     */
     ~SuccessorGenerator();
 
+    /*
+      The tree generator unpacks the state. The compiled generator doesn't:
+      if the state only has packed data, it reads the values from the
+      packed buffer.
+    */
     void generate_applicable_ops(
         const State &state, std::vector<OperatorID> &applicable_ops) const;
     void generate_applicable_ops(
@@ -37,6 +58,7 @@ public:
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_compiled_successor_generators;
 }
 
 #endif
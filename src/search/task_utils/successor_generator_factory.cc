@@ -2,6 +2,8 @@
 
 #include "successor_generator_internals.h"
 
+#include "task_properties.h"
+
 #include "../task_proxy.h"
 
 #include "../utils/collections.h"
@@ -272,7 +274,7 @@ static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
     return precond;
 }
 
-GeneratorPtr SuccessorGeneratorFactory::create() {
+void SuccessorGeneratorFactory::initialize_operator_infos() {
     OperatorsProxy operators = task_proxy.get_operators();
     operator_infos.reserve(operators.size());
     for (OperatorProxy op : operators) {
@@ -282,10 +284,118 @@ GeneratorPtr SuccessorGeneratorFactory::create() {
     /* Use stable_sort rather than sort for reproducibility.
        This amounts to breaking ties by operator ID. */
     stable_sort(operator_infos.begin(), operator_infos.end());
+}
 
+GeneratorPtr SuccessorGeneratorFactory::create() {
+    initialize_operator_infos();
     OperatorRange full_range(0, operator_infos.size());
     GeneratorPtr root = construct_recursive(0, full_range);
     operator_infos.clear();
     return root;
 }
+
+int SuccessorGeneratorFactory::compile_fork(
+    const vector<int> &children, vector<int> &program) const {
+    if (children.size() == 1) {
+        return children[0];
+    }
+    // As above, empty forks are only generated for tasks without operators.
+    int pos = program.size();
+    program.push_back(CompiledGenerator::FORK);
+    program.push_back(children.size());
+    program.insert(program.end(), children.begin(), children.end());
+    return pos;
+}
+
+int SuccessorGeneratorFactory::compile_leaf(
+    OperatorRange range, vector<int> &program) const {
+    assert(!range.empty());
+    int pos = program.size();
+    program.push_back(CompiledGenerator::LEAF);
+    program.push_back(range.span());
+    for (int i = range.begin; i < range.end; ++i) {
+        program.push_back(operator_infos[i].get_op().get_index());
+    }
+    return pos;
+}
+
+int SuccessorGeneratorFactory::compile_switch(
+    int switch_var_id, const vector<pair<int, int>> &values_and_children,
+    vector<int> &program) const {
+    VariablesProxy variables = task_proxy.get_variables();
+    int var_domain = variables[switch_var_id].get_domain_size();
+    int num_children = values_and_children.size();
+
+    assert(num_children > 0);
+
+    int pos = program.size();
+    if (num_children == 1) {
+        program.push_back(CompiledGenerator::SWITCH_SINGLE);
+        program.push_back(switch_var_id);
+        program.push_back(values_and_children[0].first);
+        program.push_back(values_and_children[0].second);
+    } else if (2 * num_children < var_domain) {
+        /* Sparse switches need two entries per child while vector switches
+           need one entry per value. The grouper produces values in
+           increasing order, which allows binary search in sparse switches. */
+        assert(is_sorted(
+            values_and_children.begin(), values_and_children.end()));
+        program.push_back(CompiledGenerator::SWITCH_SPARSE);
+        program.push_back(switch_var_id);
+        program.push_back(num_children);
+        for (const auto &value_and_child : values_and_children) {
+            program.push_back(value_and_child.first);
+        }
+        for (const auto &value_and_child : values_and_children) {
+            program.push_back(value_and_child.second);
+        }
+    } else {
+        program.push_back(CompiledGenerator::SWITCH_VECTOR);
+        program.push_back(switch_var_id);
+        program.push_back(var_domain);
+        int children_begin = program.size();
+        program.resize(
+            program.size() + var_domain, CompiledGenerator::NO_CHILD);
+        for (const auto &[value, child] : values_and_children) {
+            program[children_begin + value] = child;
+        }
+    }
+    return pos;
+}
+
+int SuccessorGeneratorFactory::compile_recursive(
+    int depth, OperatorRange range, vector<int> &program) const {
+    vector<int> nodes;
+    OperatorGrouper grouper_by_var(
+        operator_infos, depth, GroupOperatorsBy::VAR, range);
+    while (!grouper_by_var.done()) {
+        auto [var, var_range] = grouper_by_var.next();
+        if (var == -1) {
+            nodes.push_back(compile_leaf(var_range, program));
+        } else {
+            vector<pair<int, int>> values_and_children;
+            OperatorGrouper grouper_by_value(
+                operator_infos, depth, GroupOperatorsBy::VALUE, var_range);
+            while (!grouper_by_value.done()) {
+                auto [value, value_range] = grouper_by_value.next();
+                values_and_children.emplace_back(
+                    value, compile_recursive(depth + 1, value_range, program));
+            }
+            nodes.push_back(compile_switch(var, values_and_children, program));
+        }
+    }
+    return compile_fork(nodes, program);
+}
+
+unique_ptr<CompiledGenerator> SuccessorGeneratorFactory::compile() {
+    initialize_operator_infos();
+    OperatorRange full_range(0, operator_infos.size());
+    vector<int> program;
+    int root = compile_recursive(0, full_range, program);
+    operator_infos.clear();
+    program.shrink_to_fit();
+    return make_unique<CompiledGenerator>(
+        move(program), root, task_proxy.get_variables().size(),
+        task_properties::g_state_packers[task_proxy]);
+}
 }
@@ -7,6 +7,7 @@
 class TaskProxy;
 
 namespace successor_generator {
+class CompiledGenerator;
 class GeneratorBase;
 
 using GeneratorPtr = std::unique_ptr<GeneratorBase>;
@@ -25,11 +26,30 @@ class SuccessorGeneratorFactory {
     GeneratorPtr construct_switch(
         int switch_var_id, ValuesAndGenerators values_and_generators) const;
     GeneratorPtr construct_recursive(int depth, OperatorRange range) const;
+
+    /*
+      The compile_* methods mirror the construct_* methods, but append the
+      nodes to the given program and return their positions.
+    */
+    int compile_fork(
+        const std::vector<int> &children, std::vector<int> &program) const;
+    int compile_leaf(OperatorRange range, std::vector<int> &program) const;
+    int compile_switch(
+        int switch_var_id,
+        const std::vector<std::pair<int, int>> &values_and_children,
+        std::vector<int> &program) const;
+    int compile_recursive(
+        int depth, OperatorRange range, std::vector<int> &program) const;
+
+    void initialize_operator_infos();
 public:
     explicit SuccessorGeneratorFactory(const TaskProxy &task_proxy);
     // Destructor cannot be implicit because OperatorInfo is forward-declared.
     ~SuccessorGeneratorFactory();
+    // Create a successor generator consisting of polymorphic tree nodes.
     GeneratorPtr create();
+    // Create a successor generator stored in a flat instruction array.
+    std::unique_ptr<CompiledGenerator> compile();
 };
 }
 
@@ -4,6 +4,7 @@
 
 #include "../cartesian_abstractions/abstract_state.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -23,7 +24,9 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. (CompiledGenerator
+    implements a variant of this idea. We currently use it for concrete
+    states, but not for abstract states.)
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -238,4 +241,96 @@ void GeneratorLeafSingle::generate_applicable_ops(
     vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+CompiledGenerator::CompiledGenerator(
+    vector<int> &&program, int root, int num_variables,
+    const int_packer::IntPacker &state_packer)
+    : program(move(program)),
+      root(root) {
+    packed_variables.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        packed_variables.push_back(
+            {state_packer.get_bin_index(var), state_packer.get_shift(var),
+             state_packer.get_read_mask(var)});
+    }
+}
+
+template<typename ValueReader>
+void CompiledGenerator::generate_recursive(
+    int pos, const ValueReader &get_value,
+    vector<OperatorID> &applicable_ops) const {
+    while (true) {
+        const int *node = &program[pos];
+        switch (node[0]) {
+        case FORK: {
+            int num_children = node[1];
+            if (num_children == 0) {
+                return;
+            }
+            const int *children = node + 2;
+            for (int i = 0; i < num_children - 1; ++i) {
+                generate_recursive(children[i], get_value, applicable_ops);
+            }
+            pos = children[num_children - 1];
+            break;
+        }
+        case SWITCH_VECTOR: {
+            int value = get_value(node[1]);
+            assert(value < node[2]);
+            pos = node[3 + value];
+            if (pos == NO_CHILD) {
+                return;
+            }
+            break;
+        }
+        case SWITCH_SPARSE: {
+            int value = get_value(node[1]);
+            int num_values = node[2];
+            const int *values = node + 3;
+            const int *it = lower_bound(values, values + num_values, value);
+            if (it == values + num_values || *it != value) {
+                return;
+            }
+            pos = values[num_values + (it - values)];
+            break;
+        }
+        case SWITCH_SINGLE: {
+            if (get_value(node[1]) != node[2]) {
+                return;
+            }
+            pos = node[3];
+            break;
+        }
+        case LEAF: {
+            int num_operators = node[1];
+            for (int i = 0; i < num_operators; ++i) {
+                applicable_ops.emplace_back(node[2 + i]);
+            }
+            return;
+        }
+        default:
+            assert(false);
+            return;
+        }
+    }
+}
+
+void CompiledGenerator::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    generate_recursive(
+        root, [&state](int var) { return state[var]; }, applicable_ops);
+}
+
+void CompiledGenerator::generate_applicable_ops(
+    const int_packer::IntPacker::Bin *buffer,
+    vector<OperatorID> &applicable_ops) const {
+    generate_recursive(
+        root,
+        [this, buffer](int var) {
+            const PackedVariable &info = packed_variables[var];
+            return static_cast<int>(
+                (buffer[info.bin_index] & info.read_mask) >> info.shift);
+        },
+        applicable_ops);
+}
 }
@@ -3,6 +3,8 @@
 
 #include "../operator_id.h"
 
+#include "../algorithms/int_packer.h"
+
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -124,6 +126,63 @@ public:
         const cartesian_abstractions::AbstractState &state,
         std::vector<OperatorID> &applicable_ops) const override;
 };
+
+/*
+  Flat representation of a successor generator. All nodes of the decision
+  tree are stored in a single vector of ints and children are referenced by
+  their position in this vector. Nodes have the following layouts:
+
+  - fork: [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, var, k, child_0, ..., child_{k-1}]
+    where child_i is the child for value i or NO_CHILD
+  - sparse switch: [SWITCH_SPARSE, var, k, value_1, ..., value_k,
+    child_1, ..., child_k] with value_1 < ... < value_k
+  - single switch: [SWITCH_SINGLE, var, value, child]
+  - leaf: [LEAF, n, op_1, ..., op_n]
+
+  The program is evaluated by a non-virtual interpreter loop that only
+  recurses for the non-last children of fork nodes. Variable values can
+  either be read from an unpacked state or directly from the buffer of a
+  packed state.
+*/
+class CompiledGenerator {
+public:
+    enum Instruction {
+        FORK,
+        SWITCH_VECTOR,
+        SWITCH_SPARSE,
+        SWITCH_SINGLE,
+        LEAF
+    };
+    static constexpr int NO_CHILD = -1;
+
+private:
+    struct PackedVariable {
+        int bin_index;
+        int shift;
+        int_packer::IntPacker::Bin read_mask;
+    };
+
+    std::vector<int> program;
+    int root;
+    std::vector<PackedVariable> packed_variables;
+
+    template<typename ValueReader>
+    void generate_recursive(
+        int pos, const ValueReader &get_value,
+        std::vector<OperatorID> &applicable_ops) const;
+public:
+    CompiledGenerator(
+        std::vector<int> &&program, int root, int num_variables,
+        const int_packer::IntPacker &state_packer);
+
+    void generate_applicable_ops(
+        const std::vector<int> &state,
+        std::vector<OperatorID> &applicable_ops) const;
+    void generate_applicable_ops(
+        const int_packer::IntPacker::Bin *buffer,
+        std::vector<OperatorID> &applicable_ops) const;
+};
 }
 
 #endif
@@ -0,0 +1,19 @@
+#include "modified_initial_state_task.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace extra_tasks {
+ModifiedInitialStateTask::ModifiedInitialStateTask(
+    const shared_ptr<AbstractTask> &parent, vector<int> &&initial_state_values)
+    : DelegatingTask(parent), initial_state_values(move(initial_state_values)) {
+    assert(
+        static_cast<int>(this->initial_state_values.size()) ==
+        parent->get_num_variables());
+}
+
+vector<int> ModifiedInitialStateTask::get_initial_state_values() const {
+    return initial_state_values;
+}
+}
@@ -4,9 +4,13 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/collections.h"
+#include "../utils/mapped_file.h"
 #include "../utils/task_lexer.h"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <set>
 #include <type_traits>
@@ -104,6 +108,8 @@ public:
         vector<int> &values, const AbstractTask *ancestor_task) const override;
     virtual bool does_convert_ancestor_state_values(
         const AbstractTask *ancestor_task) const override;
+
+    void write_binary(const string &filename) const;
 };
 
 class TaskParser {
@@ -888,6 +894,683 @@ bool RootTask::does_convert_ancestor_state_values(
     return false;
 }
 
+/*
+  Binary task format. The file starts with a header that contains a magic
+  string, the format version, the task dimensions and the byte offsets of
+  all sections. Each section is an array that starts at an 8-byte aligned
+  position. Facts are stored as two consecutive int32_t values. Operators
+  and axioms are stored in action tables where preconditions, effects and
+  effect conditions live in flat arrays indexed by offset arrays, and all
+  names live in one character array. Since the binary task is mapped into
+  memory, we only load the parts of the file that we access.
+
+  Data is stored in the native byte order, so binary task files can't be
+  shared between machines with different endianness.
+*/
+static const char BINARY_TASK_MAGIC[8] = {
+    'F', 'D', 'B', 'T', 'A', 'S', 'K', '\0'};
+static const int32_t BINARY_TASK_VERSION = 1;
+
+enum ActionTableSection {
+    COSTS,
+    PRECONDITIONS_BEGIN,
+    PRECONDITIONS,
+    EFFECTS_BEGIN,
+    EFFECTS,
+    EFFECT_CONDITIONS_BEGIN,
+    EFFECT_CONDITIONS,
+    NUM_ACTION_TABLE_SECTIONS
+};
+
+enum BinaryTaskSection {
+    DOMAIN_SIZES,
+    AXIOM_LAYERS,
+    DEFAULT_AXIOM_VALUES,
+    INITIAL_STATE,
+    GOALS,
+    // Indexed by fact IDs, see BinaryRootTask::get_fact_id().
+    MUTEXES_BEGIN,
+    MUTEXES,
+    // Variable names, fact names, operator names and axiom names.
+    NAMES_BEGIN,
+    NAMES,
+    OPERATOR_TABLE,
+    AXIOM_TABLE = OPERATOR_TABLE + NUM_ACTION_TABLE_SECTIONS,
+    NUM_SECTIONS = AXIOM_TABLE + NUM_ACTION_TABLE_SECTIONS
+};
+
+struct BinaryTaskHeader {
+    char magic[8];
+    int32_t version;
+    int32_t num_variables;
+    int32_t num_facts;
+    int32_t num_operators;
+    int32_t num_axioms;
+    int32_t num_goals;
+    int64_t section_offsets[NUM_SECTIONS];
+};
+
+class BinaryTaskWriter {
+    string filename;
+    ofstream file;
+    BinaryTaskHeader header;
+
+    void check_file() const {
+        if (!file) {
+            cerr << "Could not write binary task file " << filename << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+public:
+    explicit BinaryTaskWriter(const string &filename)
+        : filename(filename),
+          file(filename, ios::binary) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, BINARY_TASK_MAGIC, sizeof(header.magic));
+        header.version = BINARY_TASK_VERSION;
+        // Reserve space for the header, which we write at the end.
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        check_file();
+    }
+
+    BinaryTaskHeader &get_header() {
+        return header;
+    }
+
+    template<typename T>
+    void write_section(int section, const vector<T> &values) {
+        static const char padding[8] = {};
+        int64_t pos = file.tellp();
+        file.write(padding, (8 - pos % 8) % 8);
+        header.section_offsets[section] = file.tellp();
+        file.write(
+            reinterpret_cast<const char *>(values.data()),
+            values.size() * sizeof(T));
+        check_file();
+    }
+
+    void finish() {
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.close();
+        check_file();
+    }
+};
+
+static void add_fact(vector<int32_t> &facts, const FactPair &fact) {
+    facts.push_back(fact.var);
+    facts.push_back(fact.value);
+}
+
+static void write_action_table(
+    BinaryTaskWriter &writer, int first_section,
+    const vector<ExplicitOperator> &actions) {
+    vector<int32_t> costs;
+    vector<int32_t> preconditions_begin;
+    vector<int32_t> preconditions;
+    vector<int32_t> effects_begin;
+    vector<int32_t> effects;
+    vector<int32_t> conditions_begin;
+    vector<int32_t> conditions;
+    for (const ExplicitOperator &action : actions) {
+        costs.push_back(action.cost);
+        preconditions_begin.push_back(preconditions.size() / 2);
+        for (const FactPair &fact : action.preconditions) {
+            add_fact(preconditions, fact);
+        }
+        effects_begin.push_back(effects.size() / 2);
+        for (const ExplicitEffect &effect : action.effects) {
+            add_fact(effects, effect.fact);
+            conditions_begin.push_back(conditions.size() / 2);
+            for (const FactPair &fact : effect.conditions) {
+                add_fact(conditions, fact);
+            }
+        }
+    }
+    preconditions_begin.push_back(preconditions.size() / 2);
+    effects_begin.push_back(effects.size() / 2);
+    conditions_begin.push_back(conditions.size() / 2);
+
+    writer.write_section(first_section + COSTS, costs);
+    writer.write_section(
+        first_section + PRECONDITIONS_BEGIN, preconditions_begin);
+    writer.write_section(first_section + PRECONDITIONS, preconditions);
+    writer.write_section(first_section + EFFECTS_BEGIN, effects_begin);
+    writer.write_section(first_section + EFFECTS, effects);
+    writer.write_section(
+        first_section + EFFECT_CONDITIONS_BEGIN, conditions_begin);
+    writer.write_section(first_section + EFFECT_CONDITIONS, conditions);
+}
+
+void RootTask::write_binary(const string &filename) const {
+    BinaryTaskWriter writer(filename);
+    BinaryTaskHeader &header = writer.get_header();
+    header.num_variables = variables.size();
+    header.num_operators = operators.size();
+    header.num_axioms = axioms.size();
+    header.num_goals = goals.size();
+
+    vector<int32_t> domain_sizes;
+    vector<int32_t> axiom_layers;
+    vector<int32_t> default_axiom_values;
+    vector<int32_t> mutexes_begin;
+    vector<int32_t> mutex_facts;
+    vector<int64_t> names_begin;
+    string names;
+    for (size_t var = 0; var < variables.size(); ++var) {
+        const ExplicitVariable &variable = variables[var];
+        domain_sizes.push_back(variable.domain_size);
+        axiom_layers.push_back(variable.axiom_layer);
+        default_axiom_values.push_back(variable.axiom_default_value);
+        names_begin.push_back(names.size());
+        names += variable.name;
+        for (const set<FactPair> &mutex_set : mutexes[var]) {
+            mutexes_begin.push_back(mutex_facts.size() / 2);
+            // Sets are sorted, which allows binary search when reading.
+            for (const FactPair &fact : mutex_set) {
+                add_fact(mutex_facts, fact);
+            }
+        }
+    }
+    mutexes_begin.push_back(mutex_facts.size() / 2);
+    header.num_facts = mutexes_begin.size() - 1;
+    for (const ExplicitVariable &variable : variables) {
+        for (const string &fact_name : variable.fact_names) {
+            names_begin.push_back(names.size());
+            names += fact_name;
+        }
+    }
+    for (const vector<ExplicitOperator> *actions : {&operators, &axioms}) {
+        for (const ExplicitOperator &action : *actions) {
+            names_begin.push_back(names.size());
+            names += action.name;
+        }
+    }
+    names_begin.push_back(names.size());
+
+    vector<int32_t> goal_facts;
+    for (const FactPair &goal : goals) {
+        add_fact(goal_facts, goal);
+    }
+
+    writer.write_section(DOMAIN_SIZES, domain_sizes);
+    writer.write_section(AXIOM_LAYERS, axiom_layers);
+    writer.write_section(DEFAULT_AXIOM_VALUES, default_axiom_values);
+    writer.write_section(
+        INITIAL_STATE, vector<int32_t>(
+                           initial_state_values.begin(),
+                           initial_state_values.end()));
+    writer.write_section(GOALS, goal_facts);
+    writer.write_section(MUTEXES_BEGIN, mutexes_begin);
+    writer.write_section(MUTEXES, mutex_facts);
+    writer.write_section(NAMES_BEGIN, names_begin);
+    writer.write_section(NAMES, vector<char>(names.begin(), names.end()));
+    write_action_table(writer, OPERATOR_TABLE, operators);
+    write_action_table(writer, AXIOM_TABLE, axioms);
+    writer.finish();
+}
+
+class BinaryRootTask : public AbstractTask {
+    struct ActionTable {
+        int num_actions;
+        int first_name;
+        const int32_t *costs;
+        const int32_t *preconditions_begin;
+        const int32_t *preconditions;
+        const int32_t *effects_begin;
+        const int32_t *effects;
+        const int32_t *conditions_begin;
+        const int32_t *conditions;
+    };
+
+    utils::MappedFile file;
+    const BinaryTaskHeader *header;
+    const int32_t *domain_sizes;
+    const int32_t *axiom_layers;
+    const int32_t *default_axiom_values;
+    const int32_t *goals;
+    const int32_t *mutexes_begin;
+    const int32_t *mutexes;
+    const int64_t *names_begin;
+    const char *names;
+    ActionTable operators;
+    ActionTable axioms;
+    vector<int> first_fact_ids;
+    vector<int> initial_state_values;
+
+    template<typename T>
+    const T *get_section(int section) const {
+        return reinterpret_cast<const T *>(
+            file.get_data() + header->section_offsets[section]);
+    }
+
+    ActionTable get_action_table(
+        int first_section, int num_actions, int first_name) const;
+    const ActionTable &get_table(bool is_axiom) const {
+        return is_axiom ? axioms : operators;
+    }
+    int get_effect_id(int op_index, int eff_index, bool is_axiom) const;
+    int get_fact_id(const FactPair &fact) const;
+    string get_name(int index) const;
+    static FactPair get_fact(const int32_t *facts, int index) {
+        return FactPair(facts[2 * index], facts[2 * index + 1]);
+    }
+    void verify_file(const string &filename) const;
+public:
+    explicit BinaryRootTask(const string &filename);
+
+    virtual int get_num_variables() const override;
+    virtual string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual string get_operator_name(int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index,
+        bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual vector<int> get_initial_state_values() const override;
+    virtual void convert_ancestor_state_values(
+        vector<int> &values, const AbstractTask *ancestor_task) const override;
+    virtual bool does_convert_ancestor_state_values(
+        const AbstractTask *ancestor_task) const override;
+};
+
+BinaryRootTask::BinaryRootTask(const string &filename)
+    : file(filename),
+      header(reinterpret_cast<const BinaryTaskHeader *>(file.get_data())) {
+    verify_file(filename);
+    domain_sizes = get_section<int32_t>(DOMAIN_SIZES);
+    axiom_layers = get_section<int32_t>(AXIOM_LAYERS);
+    default_axiom_values = get_section<int32_t>(DEFAULT_AXIOM_VALUES);
+    goals = get_section<int32_t>(GOALS);
+    mutexes_begin = get_section<int32_t>(MUTEXES_BEGIN);
+    mutexes = get_section<int32_t>(MUTEXES);
+    names_begin = get_section<int64_t>(NAMES_BEGIN);
+    names = get_section<char>(NAMES);
+    int num_variables = header->num_variables;
+    int num_operator_names = num_variables + header->num_facts;
+    operators = get_action_table(
+        OPERATOR_TABLE, header->num_operators, num_operator_names);
+    axioms = get_action_table(
+        AXIOM_TABLE, header->num_axioms,
+        num_operator_names + header->num_operators);
+
+    first_fact_ids.reserve(num_variables);
+    int64_t num_facts = 0;
+    for (int var = 0; var < num_variables && num_facts <= header->num_facts;
+         ++var) {
+        first_fact_ids.push_back(num_facts);
+        num_facts += domain_sizes[var];
+    }
+    if (num_facts != header->num_facts) {
+        cerr << "Inconsistent number of facts in binary task file "
+             << filename << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    const int32_t *initial_state = get_section<int32_t>(INITIAL_STATE);
+    initial_state_values.assign(
+        initial_state, initial_state + num_variables);
+}
+
+void BinaryRootTask::verify_file(const string &filename) const {
+    auto exit_with_error = [&filename](const string &msg) {
+        cerr << "Error reading binary task file " << filename << ": " << msg
+             << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    };
+    if (file.get_size() < sizeof(BinaryTaskHeader)) {
+        exit_with_error("file too short");
+    }
+    if (memcmp(header->magic, BINARY_TASK_MAGIC, sizeof(header->magic))) {
+        exit_with_error("not a binary task file");
+    }
+    if (header->version != BINARY_TASK_VERSION) {
+        exit_with_error(
+            "expected version " + to_string(BINARY_TASK_VERSION) +
+            ", got " + to_string(header->version));
+    }
+    const int64_t file_size = file.get_size();
+    for (int section = 0; section < NUM_SECTIONS; ++section) {
+        int64_t offset = header->section_offsets[section];
+        /* Sections are stored in the order of their IDs, so the next
+           section (or the end of the file) limits the size of a section. */
+        int64_t min_offset = (section == 0)
+                                 ? sizeof(BinaryTaskHeader)
+                                 : header->section_offsets[section - 1];
+        if (offset < min_offset || offset > file_size || offset % 8) {
+            exit_with_error("invalid section offset");
+        }
+    }
+    auto get_section_size = [&](int section) {
+        int64_t end = (section + 1 == NUM_SECTIONS)
+                          ? file_size
+                          : header->section_offsets[section + 1];
+        return end - header->section_offsets[section];
+    };
+    /* Counts are 32-bit integers, so the required sizes can't overflow
+       64-bit integers. */
+    auto check_section_size = [&](int section, int64_t num_entries,
+                                  int64_t entry_size) {
+        if (num_entries < 0 ||
+            num_entries * entry_size > get_section_size(section)) {
+            exit_with_error(
+                "section " + to_string(section) + " is too short");
+        }
+    };
+    /* Check an offset array with num_entries + 1 nondecreasing entries
+       starting at 0 and return its last entry. */
+    auto check_begin_section = [&](int section, int64_t num_entries) {
+        check_section_size(section, num_entries + 1, sizeof(int32_t));
+        const int32_t *begin = get_section<int32_t>(section);
+        if (begin[0] != 0) {
+            exit_with_error(
+                "section " + to_string(section) + " is inconsistent");
+        }
+        for (int64_t i = 0; i < num_entries; ++i) {
+            if (begin[i + 1] < begin[i]) {
+                exit_with_error(
+                    "section " + to_string(section) + " is inconsistent");
+            }
+        }
+        return static_cast<int64_t>(begin[num_entries]);
+    };
+
+    int num_variables = header->num_variables;
+    int num_facts = header->num_facts;
+    for (int count : {num_variables, num_facts, header->num_operators,
+                      header->num_axioms, header->num_goals}) {
+        if (count < 0) {
+            exit_with_error("negative number of task elements");
+        }
+    }
+    for (int section : {DOMAIN_SIZES, AXIOM_LAYERS, DEFAULT_AXIOM_VALUES,
+                        INITIAL_STATE}) {
+        check_section_size(section, num_variables, sizeof(int32_t));
+    }
+    const int32_t *sizes = get_section<int32_t>(DOMAIN_SIZES);
+    for (int var = 0; var < num_variables; ++var) {
+        if (sizes[var] < 1 || sizes[var] > num_facts) {
+            exit_with_error("invalid domain size");
+        }
+    }
+    auto is_valid_fact = [&](int var, int value) {
+        return var >= 0 && var < num_variables && value >= 0 &&
+               value < sizes[var];
+    };
+    const int32_t *initial_state = get_section<int32_t>(INITIAL_STATE);
+    for (int var = 0; var < num_variables; ++var) {
+        if (!is_valid_fact(var, initial_state[var])) {
+            exit_with_error("invalid initial state value");
+        }
+    }
+    // Check that a section holds num_entries valid facts.
+    auto check_fact_section = [&](int section, int64_t num_entries) {
+        check_section_size(section, num_entries, 2 * sizeof(int32_t));
+        const int32_t *facts = get_section<int32_t>(section);
+        for (int64_t i = 0; i < num_entries; ++i) {
+            if (!is_valid_fact(facts[2 * i], facts[2 * i + 1])) {
+                exit_with_error(
+                    "invalid fact in section " + to_string(section));
+            }
+        }
+    };
+    check_fact_section(GOALS, header->num_goals);
+    check_fact_section(
+        MUTEXES, check_begin_section(MUTEXES_BEGIN, num_facts));
+
+    int64_t num_names = static_cast<int64_t>(num_variables) + num_facts +
+                        header->num_operators + header->num_axioms;
+    check_section_size(NAMES_BEGIN, num_names + 1, sizeof(int64_t));
+    const int64_t *name_offsets = get_section<int64_t>(NAMES_BEGIN);
+    if (name_offsets[0] != 0) {
+        exit_with_error("invalid name offsets");
+    }
+    for (int64_t i = 0; i < num_names; ++i) {
+        if (name_offsets[i + 1] < name_offsets[i]) {
+            exit_with_error("invalid name offsets");
+        }
+    }
+    check_section_size(NAMES, name_offsets[num_names], sizeof(char));
+
+    auto check_action_table = [&](int first_section, int num_actions) {
+        check_section_size(
+            first_section + COSTS, num_actions, sizeof(int32_t));
+        check_fact_section(
+            first_section + PRECONDITIONS,
+            check_begin_section(
+                first_section + PRECONDITIONS_BEGIN, num_actions));
+        int64_t num_effects =
+            check_begin_section(first_section + EFFECTS_BEGIN, num_actions);
+        check_fact_section(first_section + EFFECTS, num_effects);
+        check_fact_section(
+            first_section + EFFECT_CONDITIONS,
+            check_begin_section(
+                first_section + EFFECT_CONDITIONS_BEGIN, num_effects));
+    };
+    check_action_table(OPERATOR_TABLE, header->num_operators);
+    check_action_table(AXIOM_TABLE, header->num_axioms);
+}
+
+BinaryRootTask::ActionTable BinaryRootTask::get_action_table(
+    int first_section, int num_actions, int first_name) const {
+    ActionTable table;
+    table.num_actions = num_actions;
+    table.first_name = first_name;
+    table.costs = get_section<int32_t>(first_section + COSTS);
+    table.preconditions_begin =
+        get_section<int32_t>(first_section + PRECONDITIONS_BEGIN);
+    table.preconditions = get_section<int32_t>(first_section + PRECONDITIONS);
+    table.effects_begin = get_section<int32_t>(first_section + EFFECTS_BEGIN);
+    table.effects = get_section<int32_t>(first_section + EFFECTS);
+    table.conditions_begin =
+        get_section<int32_t>(first_section + EFFECT_CONDITIONS_BEGIN);
+    table.conditions =
+        get_section<int32_t>(first_section + EFFECT_CONDITIONS);
+    return table;
+}
+
+int BinaryRootTask::get_effect_id(
+    int op_index, int eff_index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    assert(op_index >= 0 && op_index < table.num_actions);
+    int effect_id = table.effects_begin[op_index] + eff_index;
+    assert(effect_id < table.effects_begin[op_index + 1]);
+    return effect_id;
+}
+
+int BinaryRootTask::get_fact_id(const FactPair &fact) const {
+    assert(utils::in_bounds(fact.var, first_fact_ids));
+    assert(fact.value >= 0 && fact.value < domain_sizes[fact.var]);
+    return first_fact_ids[fact.var] + fact.value;
+}
+
+string BinaryRootTask::get_name(int index) const {
+    int64_t begin = names_begin[index];
+    int64_t end = names_begin[index + 1];
+    return string(names + begin, end - begin);
+}
+
+int BinaryRootTask::get_num_variables() const {
+    return header->num_variables;
+}
+
+string BinaryRootTask::get_variable_name(int var) const {
+    assert(utils::in_bounds(var, first_fact_ids));
+    return get_name(var);
+}
+
+int BinaryRootTask::get_variable_domain_size(int var) const {
+    assert(utils::in_bounds(var, first_fact_ids));
+    return domain_sizes[var];
+}
+
+int BinaryRootTask::get_variable_axiom_layer(int var) const {
+    assert(utils::in_bounds(var, first_fact_ids));
+    return axiom_layers[var];
+}
+
+int BinaryRootTask::get_variable_default_axiom_value(int var) const {
+    assert(utils::in_bounds(var, first_fact_ids));
+    return default_axiom_values[var];
+}
+
+string BinaryRootTask::get_fact_name(const FactPair &fact) const {
+    return get_name(header->num_variables + get_fact_id(fact));
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    int fact_id = get_fact_id(fact1);
+    int begin = mutexes_begin[fact_id];
+    int end = mutexes_begin[fact_id + 1];
+    // Binary search in the sorted list of facts that are mutex with fact1.
+    while (begin < end) {
+        int mid = begin + (end - begin) / 2;
+        FactPair fact = get_fact(mutexes, mid);
+        if (fact == fact2) {
+            return true;
+        } else if (fact < fact2) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return false;
+}
+
+int BinaryRootTask::get_operator_cost(int index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    assert(index >= 0 && index < table.num_actions);
+    return table.costs[index];
+}
+
+string BinaryRootTask::get_operator_name(int index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    assert(index >= 0 && index < table.num_actions);
+    return get_name(table.first_name + index);
+}
+
+int BinaryRootTask::get_num_operators() const {
+    return operators.num_actions;
+}
+
+int BinaryRootTask::get_num_operator_preconditions(
+    int index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    assert(index >= 0 && index < table.num_actions);
+    return table.preconditions_begin[index + 1] -
+           table.preconditions_begin[index];
+}
+
+FactPair BinaryRootTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    assert(fact_index < get_num_operator_preconditions(op_index, is_axiom));
+    return get_fact(
+        table.preconditions, table.preconditions_begin[op_index] + fact_index);
+}
+
+int BinaryRootTask::get_num_operator_effects(
+    int op_index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    assert(op_index >= 0 && op_index < table.num_actions);
+    return table.effects_begin[op_index + 1] - table.effects_begin[op_index];
+}
+
+int BinaryRootTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    int effect_id = get_effect_id(op_index, eff_index, is_axiom);
+    return table.conditions_begin[effect_id + 1] -
+           table.conditions_begin[effect_id];
+}
+
+FactPair BinaryRootTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    int effect_id = get_effect_id(op_index, eff_index, is_axiom);
+    assert(
+        cond_index <
+        get_num_operator_effect_conditions(op_index, eff_index, is_axiom));
+    return get_fact(
+        table.conditions, table.conditions_begin[effect_id] + cond_index);
+}
+
+FactPair BinaryRootTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    const ActionTable &table = get_table(is_axiom);
+    return get_fact(
+        table.effects, get_effect_id(op_index, eff_index, is_axiom));
+}
+
+int BinaryRootTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int BinaryRootTask::get_num_axioms() const {
+    return axioms.num_actions;
+}
+
+int BinaryRootTask::get_num_goals() const {
+    return header->num_goals;
+}
+
+FactPair BinaryRootTask::get_goal_fact(int index) const {
+    assert(index >= 0 && index < header->num_goals);
+    return get_fact(goals, index);
+}
+
+vector<int> BinaryRootTask::get_initial_state_values() const {
+    return initial_state_values;
+}
+
+void BinaryRootTask::convert_ancestor_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+
+bool BinaryRootTask::does_convert_ancestor_state_values(
+    const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion query");
+    }
+    return false;
+}
+
 void read_root_task(istream &in) {
     assert(!g_root_task);
     utils::TaskLexer lexer(in);
@@ -896,6 +1579,23 @@ void read_root_task(istream &in) {
     g_root_task = parser.parse();
 }
 
+void read_root_task_from_binary_file(const string &filename) {
+    assert(!g_root_task);
+    // The initial state in the file already contains the derived values.
+    g_root_task = make_shared<BinaryRootTask>(filename);
+}
+
+void write_root_task_to_binary_file(const string &filename) {
+    const RootTask *root_task =
+        dynamic_cast<const RootTask *>(g_root_task.get());
+    if (!root_task) {
+        cerr << "Only tasks read from translator output can be written to "
+             << "binary task files." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    root_task->write_binary(filename);
+}
+
 class RootTaskFeature
     : public plugins::TypedFeature<AbstractTask, AbstractTask> {
 public:
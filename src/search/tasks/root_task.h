@@ -6,5 +6,12 @@
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
 extern void read_root_task(std::istream &in);
+/*
+  Binary task files can be loaded much faster than translator output
+  because they are mapped into memory and don't have to be parsed. They
+  can only be written for tasks that were read with read_root_task().
+*/
+extern void read_root_task_from_binary_file(const std::string &filename);
+extern void write_root_task_to_binary_file(const std::string &filename);
 }
 #endif
@@ -5,7 +5,8 @@
 using namespace std;
 
 namespace utils {
-CountdownTimer::CountdownTimer(double max_time) : max_time(max_time) {
+CountdownTimer::CountdownTimer(double max_time, Clock clock)
+    : timer(true, clock), max_time(max_time) {
 }
 
 CountdownTimer::~CountdownTimer() {
@@ -8,7 +8,8 @@ class CountdownTimer {
     Timer timer;
     double max_time;
 public:
-    explicit CountdownTimer(double max_time);
+    explicit CountdownTimer(
+        double max_time, Clock clock = Clock::PROCESS_CPU);
     ~CountdownTimer();
     bool is_expired() const;
     Duration get_elapsed_time() const;
@@ -18,6 +18,8 @@ namespace utils {
   global_log here. Also add the options to dump_options().
 */
 
+mutex Log::stream_mutex;
+
 static shared_ptr<Log> global_log = make_shared<Log>(Verbosity::NORMAL);
 
 LogProxy g_log(global_log);
@@ -131,14 +133,35 @@ static plugins::TypedEnumPlugin<Verbosity> _enum_plugin(
      {"verbose", "full output"},
      {"debug", "like verbose with additional debug output"}});
 
-void Log::add_prefix() const {
-    stream << "[t=";
-    streamsize previous_precision = cout.precision(TIMER_PRECISION);
-    ios_base::fmtflags previous_flags = stream.flags();
-    stream.setf(ios_base::fixed, ios_base::floatfield);
-    stream << g_timer;
-    stream.flags(previous_flags);
-    cout.precision(previous_precision);
-    stream << ", " << get_peak_memory_in_kb() << " KB] ";
+Log::LineBuffer &Log::get_line_buffer() {
+    static thread_local LineBuffer line;
+    return line;
+}
+
+void Log::add_prefix(ostream &line) const {
+    line << "[t=";
+    streamsize previous_precision = line.precision(TIMER_PRECISION);
+    ios_base::fmtflags previous_flags = line.flags();
+    line.setf(ios_base::fixed, ios_base::floatfield);
+    line << g_timer;
+    line.flags(previous_flags);
+    line.precision(previous_precision);
+    line << ", " << get_peak_memory_in_kb() << " KB] ";
+}
+
+void Log::write_line_buffer(LineBuffer &line, bool end_line) {
+    {
+        lock_guard<mutex> lock(stream_mutex);
+        stream << line.text.str();
+        if (end_line) {
+            stream << endl;
+        } else {
+            stream << flush;
+        }
+    }
+    line.text.str("");
+    if (end_line) {
+        line.line_has_started = false;
+    }
 }
 }
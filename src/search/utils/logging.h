@@ -7,7 +7,9 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -34,33 +36,52 @@ enum class Verbosity {
 */
 class Log {
     static const int TIMER_PRECISION = 6;
+    /*
+      All logs write to the same stream. To allow using logs from multiple
+      threads, each thread collects its current line in a thread-local
+      buffer and writes the complete line under this mutex at endl. Lines
+      from different threads are therefore never interleaved, unless a
+      thread flushes a partial line, which we then write immediately.
+    */
+    static std::mutex stream_mutex;
     std::ostream &stream;
     const Verbosity verbosity;
-    bool line_has_started;
-    void add_prefix() const;
+
+    struct LineBuffer {
+        std::ostringstream text;
+        // True if we added the prefix of the current line.
+        bool line_has_started = false;
+    };
+    static LineBuffer &get_line_buffer();
+    void add_prefix(std::ostream &line) const;
+    void write_line_buffer(LineBuffer &line, bool end_line);
 
 public:
     explicit Log(Verbosity verbosity)
-        : stream(std::cout), verbosity(verbosity), line_has_started(false) {
+        : stream(std::cout), verbosity(verbosity) {
     }
 
     template<typename T>
     Log &operator<<(const T &elem) {
-        if (!line_has_started) {
-            line_has_started = true;
-            add_prefix();
+        LineBuffer &line = get_line_buffer();
+        if (!line.line_has_started) {
+            add_prefix(line.text);
+            line.line_has_started = true;
         }
-        stream << elem;
+        line.text << elem;
         return *this;
     }
 
     using manip_function = std::ostream &(*)(std::ostream &);
     Log &operator<<(manip_function f) {
+        LineBuffer &line = get_line_buffer();
         if (f == static_cast<manip_function>(&std::endl)) {
-            line_has_started = false;
+            write_line_buffer(line, true);
+        } else if (f == static_cast<manip_function>(&std::flush)) {
+            write_line_buffer(line, false);
+        } else {
+            line.text << f;
         }
-
-        stream << f;
         return *this;
     }
 
@@ -0,0 +1,71 @@
+#include "mapped_file.h"
+
+#include "system.h"
+
+#include <fstream>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+NO_RETURN
+static void exit_with_file_error(const string &filename) {
+    cerr << "Could not read file " << filename << endl;
+    exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+MappedFile::MappedFile(const string &filename) : data(nullptr), size(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        exit_with_file_error(filename);
+    }
+    struct stat file_stats;
+    if (fstat(fd, &file_stats) == -1) {
+        close(fd);
+        exit_with_file_error(filename);
+    }
+    size = file_stats.st_size;
+    if (size > 0) {
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            exit_with_file_error(filename);
+        }
+        data = static_cast<const char *>(address);
+    }
+    // The mapping stays valid after closing the file descriptor.
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        munmap(const_cast<char *>(data), size);
+    }
+}
+#else
+MappedFile::MappedFile(const string &filename) : data(nullptr), size(0) {
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file) {
+        exit_with_file_error(filename);
+    }
+    size = file.tellg();
+    buffer.resize(size);
+    file.seekg(0);
+    if (!file.read(buffer.data(), size)) {
+        exit_with_file_error(filename);
+    }
+    data = buffer.data();
+}
+
+MappedFile::~MappedFile() {
+}
+#endif
+}
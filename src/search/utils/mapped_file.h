@@ -0,0 +1,39 @@
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only view of a file's contents. On Unix systems the file is mapped
+  into memory, so pages are only loaded when they are accessed and they
+  are shared with the page cache. On other systems we read the whole file
+  into memory.
+
+  Exits with SEARCH_INPUT_ERROR if the file cannot be opened.
+*/
+class MappedFile {
+    const char *data;
+    std::size_t size;
+    // Only used if memory mapping is unavailable.
+    std::vector<char> buffer;
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+};
+}
+
+#endif
@@ -2,13 +2,14 @@
 
 #include "../utils/logging.h"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 
 using namespace std;
 
 namespace utils {
-static char *extra_memory_padding = nullptr;
+static atomic<char *> extra_memory_padding(nullptr);
 
 // Save standard out-of-memory handler.
 static void (*standard_out_of_memory_handler)() = nullptr;
@@ -27,10 +28,11 @@ void reserve_extra_memory_padding(int memory_in_mb) {
 }
 
 void release_extra_memory_padding() {
-    assert(extra_memory_padding);
-    delete[] extra_memory_padding;
-    extra_memory_padding = nullptr;
-    set_new_handler(standard_out_of_memory_handler);
+    char *padding = extra_memory_padding.exchange(nullptr);
+    if (padding) {
+        delete[] padding;
+        set_new_handler(standard_out_of_memory_handler);
+    }
 }
 
 bool extra_memory_padding_is_reserved() {
@@ -11,6 +11,9 @@ namespace utils {
 
   The interface assumes a single user. It is not possible for two parts
   of the planner to reserve extra memory padding at the same time.
+  However, the padding may be released (e.g., by the out-of-memory
+  handler) and queried from several threads. Releasing a padding that has
+  already been released has no effect.
 */
 extern void reserve_extra_memory_padding(int memory_in_mb);
 extern void release_extra_memory_padding();
@@ -0,0 +1,78 @@
+#include "parallel.h"
+
+#include "../plugins/plugin.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+void parallel_for(
+    int num_items, int num_threads,
+    const function<void(int thread_id, int item)> &func) {
+    assert(num_threads >= 1);
+    num_threads = min(num_threads, num_items);
+    if (num_threads <= 1) {
+        for (int item = 0; item < num_items; ++item) {
+            func(0, item);
+        }
+        return;
+    }
+
+    atomic<int> next_item(0);
+    atomic<bool> failed(false);
+    exception_ptr first_exception;
+    mutex exception_mutex;
+    auto work = [&](int thread_id) {
+        while (!failed) {
+            int item = next_item++;
+            if (item >= num_items) {
+                break;
+            }
+            try {
+                func(thread_id, item);
+            } catch (...) {
+                lock_guard<mutex> lock(exception_mutex);
+                if (!first_exception) {
+                    first_exception = current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    vector<thread> workers;
+    workers.reserve(num_threads - 1);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        workers.emplace_back(work, thread_id);
+    }
+    // The calling thread participates as worker 0.
+    work(0);
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    if (first_exception) {
+        rethrow_exception(first_exception);
+    }
+}
+
+void add_parallel_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "threads",
+        "Number of threads used for the precomputation. With the default "
+        "value 1, all computations run in the main thread. Note that timers "
+        "and time limits measure the CPU time of the whole process, i.e., "
+        "the time summed over all threads.",
+        "1", plugins::Bounds("1", "infinity"));
+}
+
+tuple<int> get_parallel_arguments_from_options(const plugins::Options &opts) {
+    return make_tuple(opts.get<int>("threads"));
+}
+}
@@ -0,0 +1,38 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+#include <tuple>
+
+namespace plugins {
+class Feature;
+class Options;
+}
+
+namespace utils {
+/*
+  Call func(thread_id, item) for each item in [0, num_items) using at most
+  num_threads worker threads. Items are handed out dynamically, so callers
+  must not make any assumptions about which thread processes which item.
+  The thread_id lies in [0, num_threads) and can be used to index
+  per-thread resources such as LP solvers or random number generators.
+
+  For num_threads == 1 (and for fewer than two items), all items are
+  processed in order in the calling thread. To obtain deterministic results,
+  func should only write to data associated with its item and the caller
+  should merge the results in item order after this function returns.
+
+  If func throws an exception, the remaining items are skipped and the
+  first exception is rethrown in the calling thread.
+*/
+extern void parallel_for(
+    int num_items, int num_threads,
+    const std::function<void(int thread_id, int item)> &func);
+
+// Add "threads" option to parser.
+extern void add_parallel_options_to_feature(plugins::Feature &feature);
+extern std::tuple<int> get_parallel_arguments_from_options(
+    const plugins::Options &opts);
+}
+
+#endif
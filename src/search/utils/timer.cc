@@ -1,5 +1,7 @@
 #include "timer.h"
 
+#include "language.h"
+
 #include <ctime>
 #include <iomanip>
 #include <ostream>
@@ -55,7 +57,7 @@ void mach_absolute_difference(
 }
 #endif
 
-Timer::Timer(bool start) {
+Timer::Timer(bool start, Clock clock) : clock(clock) {
 #if OPERATING_SYSTEM == WINDOWS
     QueryPerformanceFrequency(&frequency);
     QueryPerformanceCounter(&start_ticks);
@@ -67,6 +69,7 @@ Timer::Timer(bool start) {
 
 double Timer::current_clock() const {
 #if OPERATING_SYSTEM == WINDOWS
+    unused_variable(clock);
     LARGE_INTEGER now_ticks;
     QueryPerformanceCounter(&now_ticks);
     double ticks =
@@ -75,11 +78,18 @@ double Timer::current_clock() const {
 #else
     timespec tp;
 #if OPERATING_SYSTEM == OSX
+    unused_variable(clock);
     static uint64_t start = mach_absolute_time();
     uint64_t end = mach_absolute_time();
     mach_absolute_difference(end, start, &tp);
 #else
-    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &tp);
+    clockid_t clock_id = CLOCK_PROCESS_CPUTIME_ID;
+    if (clock == Clock::WALL) {
+        clock_id = CLOCK_MONOTONIC;
+    } else if (clock == Clock::THREAD_CPU) {
+        clock_id = CLOCK_THREAD_CPUTIME_ID;
+    }
+    clock_gettime(clock_id, &tp);
 #endif
     return tp.tv_sec + tp.tv_nsec / 1e9;
 #endif
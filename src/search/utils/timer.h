@@ -18,7 +18,21 @@ public:
 
 std::ostream &operator<<(std::ostream &os, const Duration &time);
 
+/*
+  On Linux, timers measure the CPU time of the whole process by default,
+  i.e., the summed CPU time of all threads. Code that runs several threads
+  can measure wall-clock time instead, and a thread can measure its own CPU
+  time (such a timer must only be used by the thread that created it). On
+  other operating systems, all timers measure wall-clock time.
+*/
+enum class Clock {
+    PROCESS_CPU,
+    WALL,
+    THREAD_CPU
+};
+
 class Timer {
+    Clock clock;
     double last_start_clock;
     double collected_time;
     bool stopped;
@@ -29,7 +43,7 @@ class Timer {
 
     double current_clock() const;
 public:
-    explicit Timer(bool start = true);
+    explicit Timer(bool start = true, Clock clock = Clock::PROCESS_CPU);
     ~Timer() = default;
     Duration operator()() const;
     Duration stop();